@@ -2,4 +2,11 @@ TEMPLATE = subdirs
 
 SUBDIRS += \
 #        desktop-demo \
+    desktop-demo/tools/call-quality-analyzer \
+    iconAtlas \
     quick-demo
+
+iconAtlas.subdir = desktop-demo/tools/icon-atlas
+
+# The icons of desktop-demo are rendered at build time by tools/icon-atlas.
+desktop-demo.depends = iconAtlas
@@ -16,19 +16,33 @@ DEFINES += WIN32_LEAN_AND_MEAN
 SOURCES += \
         main.cpp \
         src/app/App.cpp \
+        src/app/cli/Cli.cpp \
+        src/app/cli/CliReader.cpp \
         src/app/paths/Paths.cpp \
+        src/app/providers/AsyncImageResponse.cpp \
         src/app/providers/AvatarProvider.cpp \
         src/app/providers/ExternalImageProvider.cpp \
+        src/app/providers/IconAtlas.cpp \
+        src/app/providers/IconRenderer.cpp \
+        src/app/providers/ImageFileCache.cpp \
         src/app/providers/ImageProvider.cpp \
         src/app/providers/ThumbnailProvider.cpp \
+        src/app/tracer/Tracer.cpp \
         src/app/translator/DefaultTranslator.cpp \
         src/components/assistant/AssistantModel.cpp \
         src/components/authentication/AuthenticationNotifier.cpp \
         src/components/call/CallModel.cpp \
+        src/components/call/CallQualityFile.cpp \
+        src/components/call/CallQualityRecorder.cpp \
+        src/components/call/CallStatsModel.cpp \
         src/components/calls/CallsListModel.cpp \
         src/components/calls/CallsListProxyModel.cpp \
+        src/components/calls/VuMeterSampler.cpp \
         src/components/camera/Camera.cpp \
         src/components/camera/CameraPreview.cpp \
+        src/components/camera/SoftwareCamera.cpp \
+        src/components/camera/VideoFrameClock.cpp \
+        src/components/camera/YuvConverter.cpp \
         src/components/codecs/AbstractCodecsModel.cpp \
         src/components/codecs/AudioCodecsModel.cpp \
         src/components/codecs/VideoCodecsModel.cpp \
@@ -41,12 +55,17 @@ SOURCES += \
         src/components/contacts/ContactsImporterListProxyModel.cpp \
         src/components/contacts/ContactsImporterModel.cpp \
         src/components/contacts/ContactsImporterPluginsManager.cpp \
+        src/components/contacts/ContactsImporterWorker.cpp \
         src/components/contacts/ContactsListModel.cpp \
         src/components/contacts/ContactsListProxyModel.cpp \
         src/components/core/CoreHandlers.cpp \
+        src/components/core/CoreHandlersProfiler.cpp \
+        src/components/core/CoreIterationScheduler.cpp \
         src/components/core/CoreManager.cpp \
+        src/components/core/VideoRenderLock.cpp \
         src/components/file/FileDownloader.cpp \
         src/components/file/FileExtractor.cpp \
+        src/components/history/HistoryStatsModel.cpp \
         src/components/ldap/LdapListModel.cpp \
         src/components/ldap/LdapModel.cpp \
         src/components/ldap/LdapProxyModel.cpp \
@@ -86,6 +105,19 @@ INCLUDEPATH +=  $$PWD/src \
 
 RESOURCES += resources.qrc
 
+# Icons rendered at build time by tools/icon-atlas. LinPhone-Qt-Demo.pro builds the
+# tool first, a standalone build of this project builds it on demand.
+ICON_ATLAS_TOOL = $$OUT_PWD/$$DESTDIR/icon-atlas
+win32: ICON_ATLAS_TOOL = $${ICON_ATLAS_TOOL}.exe
+ICON_ATLAS_TOOL_OUT_PWD = $$OUT_PWD/tools/icon-atlas
+iconAtlasTool.target = $$ICON_ATLAS_TOOL
+iconAtlasTool.commands = $$shell_quote($$shell_path($$QMAKE_QMAKE)) -o $$shell_quote($$shell_path($$ICON_ATLAS_TOOL_OUT_PWD/Makefile)) $$shell_quote($$shell_path($$PWD/tools/icon-atlas/icon-atlas.pro)) && cd $$shell_quote($$shell_path($$ICON_ATLAS_TOOL_OUT_PWD)) && $(MAKE)
+iconAtlas.target = $$OUT_PWD/$$DESTDIR/icons.atlas
+iconAtlas.depends = $$ICON_ATLAS_TOOL $$files($$PWD/assets/images/*.svg) $$PWD/src/components/other/colors/Colors.hpp $$PWD/src/gitversion.h
+iconAtlas.commands = $$shell_quote($$shell_path($$ICON_ATLAS_TOOL)) --sources $$shell_quote($$PWD/assets/images) --output $$shell_quote($$iconAtlas.target)
+QMAKE_EXTRA_TARGETS += iconAtlasTool iconAtlas
+PRE_TARGETDEPS += $$iconAtlas.target
+
 # Additional import path used to resolve QML modules in Qt Creator's code model
 QML_IMPORT_PATH =
 
@@ -102,19 +134,34 @@ HEADERS += \
 	include/LinphoneApp/PluginDataAPI.hpp \
 	include/LinphoneApp/PluginNetworkHelper.hpp \
 	src/app/App.hpp \
+	src/app/cli/Cli.hpp \
+	src/app/cli/CliReader.hpp \
 	src/app/paths/Paths.hpp \
+	src/app/providers/AsyncImageResponse.hpp \
 	src/app/providers/AvatarProvider.hpp \
 	src/app/providers/ExternalImageProvider.hpp \
+	src/app/providers/IconAtlas.hpp \
+	src/app/providers/IconRenderer.hpp \
+	src/app/providers/ImageFileCache.hpp \
 	src/app/providers/ImageProvider.hpp \
 	src/app/providers/ThumbnailProvider.hpp \
+	src/app/tracer/Tracer.hpp \
 	src/app/translator/DefaultTranslator.hpp \
 	src/components/assistant/AssistantModel.hpp \
 	src/components/authentication/AuthenticationNotifier.hpp \
 	src/components/call/CallModel.hpp \
+	src/components/call/CallQualityFile.hpp \
+	src/components/call/CallQualityRecord.hpp \
+	src/components/call/CallQualityRecorder.hpp \
+	src/components/call/CallStatsModel.hpp \
 	src/components/calls/CallsListModel.hpp \
 	src/components/calls/CallsListProxyModel.hpp \
+	src/components/calls/VuMeterSampler.hpp \
 	src/components/camera/Camera.hpp \
 	src/components/camera/CameraPreview.hpp \
+	src/components/camera/SoftwareCamera.hpp \
+	src/components/camera/VideoFrameClock.hpp \
+	src/components/camera/YuvConverter.hpp \
 	src/components/codecs/AbstractCodecsModel.hpp \
 	src/components/codecs/AudioCodecsModel.hpp \
 	src/components/codecs/VideoCodecsModel.hpp \
@@ -127,12 +174,18 @@ HEADERS += \
 	src/components/contacts/ContactsImporterListProxyModel.hpp \
 	src/components/contacts/ContactsImporterModel.hpp \
 	src/components/contacts/ContactsImporterPluginsManager.hpp \
+	src/components/contacts/ContactsImporterWorker.hpp \
 	src/components/contacts/ContactsListModel.hpp \
 	src/components/contacts/ContactsListProxyModel.hpp \
 	src/components/core/CoreHandlers.hpp \
+	src/components/core/CoreHandlersProfiler.hpp \
+	src/components/core/CoreIterationScheduler.hpp \
 	src/components/core/CoreManager.hpp \
+	src/components/core/KeyedEvents.hpp \
+	src/components/core/VideoRenderLock.hpp \
 	src/components/file/FileDownloader.hpp \
 	src/components/file/FileExtractor.hpp \
+	src/components/history/HistoryStatsModel.hpp \
 	src/components/ldap/LdapListModel.hpp \
 	src/components/ldap/LdapModel.hpp \
 	src/components/ldap/LdapProxyModel.hpp \
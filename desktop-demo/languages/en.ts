@@ -44,6 +44,18 @@
         <source>commandLineOptionVerbose</source>
         <translation>log to stdout some debug information while running</translation>
     </message>
+    <message>
+        <source>commandLineOptionTraceStartup</source>
+        <translation>write a Chrome trace of the startup to a file</translation>
+    </message>
+    <message>
+        <source>commandLineOptionTraceStartupArg</source>
+        <translation>file</translation>
+    </message>
+    <message>
+        <source>commandLineOptionHeadless</source>
+        <translation>run without interface, read cli commands on the standard input</translation>
+    </message>
     <message>
         <source>commandLineOptionConfig</source>
         <translation>specify the %1 configuration file to be used</translation>
@@ -363,6 +375,18 @@
         <source>callStatsSentFramerate</source>
         <translation>Sent framerate</translation>
     </message>
+    <message>
+        <source>callStatsRenderedFramerate</source>
+        <translation>Rendered framerate</translation>
+    </message>
+    <message>
+        <source>callStatsSkippedFramerate</source>
+        <translation>Skipped framerate</translation>
+    </message>
+    <message>
+        <source>callStatsRenderTime</source>
+        <translation>Render time</translation>
+    </message>
 </context>
 <context>
     <name>CallSipAddress</name>
@@ -493,6 +517,10 @@ Server URL not configured.</translation>
         <source>joinConferenceAsFunctionDescription</source>
         <translation>Join the conference hosted by the sip-address as with the guest-sip-address. If you are not connected to a proxy-config, see join-conference.</translation>
     </message>
+    <message>
+        <source>handlersStatsFunctionDescription</source>
+        <translation>Print the duration histograms of the core handlers. enable=1|0 starts or stops the profiling, reset=1 clears the histograms after printing.</translation>
+    </message>
 </context>
 <context>
     <name>CodecsViewer</name>
@@ -1207,6 +1235,10 @@ Click here: &lt;a href=&quot;%1&quot;&gt;%1&lt;/a&gt;
         <source>contactsTitle</source>
         <translation>Address Book Connector</translation>
     </message>
+    <message>
+        <source>contactsImporterDeltaSync</source>
+        <translation>Only apply the changes since the previous import. Removed contacts are deleted unless you modified them.</translation>
+    </message>
 </context>
 <context>
     <name>SettingsAudio</name>
@@ -1957,6 +1989,10 @@ Click here: &lt;a href=&quot;%1&quot;&gt;%1&lt;/a&gt;
         <source>showVideoCodecsLabel</source>
         <translation>Show video codecs</translation>
     </message>
+    <message>
+        <source>showVideoFrameStatsLabel</source>
+        <translation>Show the frame statistics on the videos</translation>
+    </message>
     <message>
         <source>videoSettingsInCallWarning</source>
         <translation>Video call in progress: some settings are not available.</translation>
@@ -2098,6 +2134,29 @@ Click here: &lt;a href=&quot;%1&quot;&gt;%1&lt;/a&gt;
         <translation>Unable to add this account.</translation>
     </message>
 </context>
+<context>
+    <name>VideoFrameStatsOverlay</name>
+    <message>
+        <source>frameStatsDecoded</source>
+        <translation>decoded: %1 FPS</translation>
+    </message>
+    <message>
+        <source>frameStatsReceived</source>
+        <translation>received: %1</translation>
+    </message>
+    <message>
+        <source>frameStatsRender</source>
+        <translation>render: %1 us (max %2 us)</translation>
+    </message>
+    <message>
+        <source>frameStatsRendered</source>
+        <translation>rendered: %1</translation>
+    </message>
+    <message>
+        <source>frameStatsSkipped</source>
+        <translation>skipped: %1</translation>
+    </message>
+</context>
 <context>
     <name>ZrtpTokenAuthentication</name>
     <message>
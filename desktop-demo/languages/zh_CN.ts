@@ -44,6 +44,18 @@
         <source>commandLineOptionVerbose</source>
         <translation>在运行时向 stdout 输出调试日志</translation>
     </message>
+    <message>
+        <source>commandLineOptionTraceStartup</source>
+        <translation>将启动过程的 Chrome trace 写入文件</translation>
+    </message>
+    <message>
+        <source>commandLineOptionTraceStartupArg</source>
+        <translation>文件</translation>
+    </message>
+    <message>
+        <source>commandLineOptionHeadless</source>
+        <translation>无界面运行，从标准输入读取命令</translation>
+    </message>
     <message>
         <source>commandLineOptionConfig</source>
         <translation>指定要使用的配置文件：%1</translation>
@@ -363,6 +375,18 @@
         <source>callStatsSentFramerate</source>
         <translation>发送的帧率</translation>
     </message>
+    <message>
+        <source>callStatsRenderedFramerate</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <source>callStatsSkippedFramerate</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <source>callStatsRenderTime</source>
+        <translation type="unfinished"></translation>
+    </message>
 </context>
 <context>
     <name>CallSipAddress</name>
@@ -493,6 +517,10 @@
         <source>byeFunctionDescription</source>
         <translation type="unfinished"></translation>
     </message>
+    <message>
+        <source>handlersStatsFunctionDescription</source>
+        <translation type="unfinished"></translation>
+    </message>
 </context>
 <context>
     <name>CodecsViewer</name>
@@ -1207,6 +1235,10 @@
         <source>contactsTitle</source>
         <translation type="unfinished">联系人</translation>
     </message>
+    <message>
+        <source>contactsImporterDeltaSync</source>
+        <translation type="unfinished"></translation>
+    </message>
 </context>
 <context>
     <name>SettingsAudio</name>
@@ -1934,6 +1966,10 @@
         <source>showVideoCodecsLabel</source>
         <translation>显示视频编解码器</translation>
     </message>
+    <message>
+        <source>showVideoFrameStatsLabel</source>
+        <translation type="unfinished"></translation>
+    </message>
     <message>
         <source>videoSettingsInCallWarning</source>
         <translation>视频呼叫正在进行中：某些设置不可用。</translation>
@@ -2075,6 +2111,29 @@
         <translation>无法添加此账户。</translation>
     </message>
 </context>
+<context>
+    <name>VideoFrameStatsOverlay</name>
+    <message>
+        <source>frameStatsDecoded</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <source>frameStatsReceived</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <source>frameStatsRender</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <source>frameStatsRendered</source>
+        <translation type="unfinished"></translation>
+    </message>
+    <message>
+        <source>frameStatsSkipped</source>
+        <translation type="unfinished"></translation>
+    </message>
+</context>
 <context>
     <name>ZrtpTokenAuthentication</name>
     <message>
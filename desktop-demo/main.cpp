@@ -21,6 +21,11 @@ int main (int argc, char *argv[]) {
   // Useful to share camera on Fullscreen (other context)
   QApplication::setAttribute(Qt::AA_ShareOpenGLContexts);
 
+  // Headless: do not require a display.
+  for (int i = 1; i < argc; ++i)
+    if (QByteArray(argv[i]) == "--headless" && qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+      qputenv("QT_QPA_PLATFORM", "offscreen");
+
   // Do not use APPLICATION_NAME here.
   // The EXECUTABLE_NAME will be used in qt standard paths. It's our goal.
   QCoreApplication::setApplicationName(EXECUTABLE_NAME);
@@ -34,12 +34,17 @@
 #include <QTimer>
 
 #include "config.h"
+#include "cli/Cli.hpp"
+#include "cli/CliReader.hpp"
 #include "components/Components.hpp"
 #include "paths/Paths.hpp"
+#include "providers/AsyncImageResponse.hpp"
 #include "providers/AvatarProvider.hpp"
 #include "providers/ImageProvider.hpp"
 #include "providers/ExternalImageProvider.hpp"
+#include "providers/ImageFileCache.hpp"
 #include "providers/ThumbnailProvider.hpp"
+#include "tracer/Tracer.hpp"
 #include "translator/DefaultTranslator.hpp"
 #include "utils/LinphoneUtils.hpp"
 #include "utils/Utils.hpp"
@@ -213,6 +218,14 @@ App::App (int &argc, char *argv[]) :
   createParser();
   mParser->process(*this);
 
+  // Trace the startup until the first frame of the main window.
+  mStartupTraceFilePath = mParser->value("trace-startup");
+  if (!mStartupTraceFilePath.isEmpty())
+    Tracer::start();
+  TRACE_SPAN("App::App");
+
+  mHeadless = mParser->isSet("headless");
+
   // Initialize logger.
   shared_ptr<linphone::Config> config = getConfigIfExists(getConfigPathIfExists(*mParser));
 
@@ -231,6 +244,10 @@ App::App (int &argc, char *argv[]) :
 
 App::~App () {
   qInfo() << QStringLiteral("Destroying app...");
+  if (mCliReader)
+    mCliReader->stop();
+  // The image loaders use the providers of the engine.
+  AsyncImageResponse::stopAll();
   delete mEngine;
   delete mParser;
 }
@@ -283,17 +300,20 @@ static QQuickWindow *createSubWindow (QQmlApplicationEngine *engine, const char
 // -----------------------------------------------------------------------------
 
 void App::initContentApp () {
+  TRACE_SPAN("App::initContentApp");
+
   std::string configPath;
   shared_ptr<linphone::Config> config;
   bool mustBeIconified = false;
   bool needRestart = true;
 
   // Destroy qml components and linphone core if necessary.
-  if (mEngine) {
+  if (mEngine || mCliReader) {
     needRestart = false;
     setFetchConfig(mParser);
     setOpened(false);
     qInfo() << QStringLiteral("Restarting app...");
+    AsyncImageResponse::stopAll();
     delete mEngine;
 
     mNotifier = nullptr;
@@ -313,8 +333,11 @@ void App::initContentApp () {
     qDebug() << mParser->value("config") << configPath.c_str();
     config = getConfigIfExists(configPath);
     // Update and download codecs.
-    VideoCodecsModel::updateCodecs();
-    VideoCodecsModel::downloadUpdatableCodecs(this);
+    {
+      TRACE_SPAN("VideoCodecsModel::updateCodecs");
+      VideoCodecsModel::updateCodecs();
+      VideoCodecsModel::downloadUpdatableCodecs(this);
+    }
 
     #ifndef Q_OS_MACOS
       mustBeIconified = mParser->isSet("iconified");
@@ -323,7 +346,15 @@ void App::initContentApp () {
   }
 
   // Init core.
-  CoreManager::init(this, Utils::coreStringToAppString(configPath));
+  {
+    TRACE_SPAN("CoreManager::init");
+    CoreManager::init(this, Utils::coreStringToAppString(configPath));
+  }
+
+  if (mHeadless) {
+    initHeadlessContentApp();
+    return;
+  }
 
 
   // Init engine content.
@@ -345,24 +376,43 @@ void App::initContentApp () {
   mEngine->addImportPath(":/ui/views");
 
   // Provide avatars/thumbnails providers.
-  mEngine->addImageProvider(AvatarProvider::ProviderId, new AvatarProvider());
-  mEngine->addImageProvider(ImageProvider::ProviderId, new ImageProvider());
-  mEngine->addImageProvider(ExternalImageProvider::ProviderId, new ExternalImageProvider());
-  mEngine->addImageProvider(ThumbnailProvider::ProviderId, new ThumbnailProvider());
+  {
+    // The decoded images of the files share one budget.
+    shared_ptr<ImageFileCache> imageFileCache = make_shared<ImageFileCache>();
+    imageFileCache->useConfig(config);
+    mEngine->addImageProvider(AvatarProvider::ProviderId, new AvatarProvider(imageFileCache));
+    mEngine->addImageProvider(ExternalImageProvider::ProviderId, new ExternalImageProvider(imageFileCache));
+    mEngine->addImageProvider(ThumbnailProvider::ProviderId, new ThumbnailProvider(imageFileCache));
+  }
+  {
+    ImageProvider *imageProvider = new ImageProvider();
+    imageProvider->useConfig(config);
+    mEngine->addImageProvider(ImageProvider::ProviderId, imageProvider);
+  }
 
   mEngine->rootContext()->setContextProperty("applicationUrl", APPLICATION_URL);
 
-  registerTypes();
-  registerSharedTypes();
-  registerToolTypes();
-  registerSharedToolTypes();
+  mSoftwareVideoRendering = SoftwareCamera::isEnabled(config);
+  if (mSoftwareVideoRendering)
+    qInfo() << QStringLiteral("Use the software video rendering.");
+
+  {
+    TRACE_SPAN("App::registerTypes");
+    registerTypes();
+    registerSharedTypes();
+    registerToolTypes();
+    registerSharedToolTypes();
+  }
 
   // Enable notifications.
   mNotifier = new Notifier(mEngine);
 
   // Load main view.
   qInfo() << QStringLiteral("Loading main view...");
-  mEngine->load(QUrl(QmlViewMainWindow));
+  {
+    TRACE_SPAN("QQmlApplicationEngine::load");
+    mEngine->load(QUrl(QmlViewMainWindow));
+  }
   if (mEngine->rootObjects().isEmpty())
     qFatal("Unable to open main window.");
 
@@ -376,6 +426,38 @@ void App::initContentApp () {
   );
 }
 
+void App::initHeadlessContentApp () {
+  qInfo() << QStringLiteral("Running headless. Reading cli commands on stdin...");
+
+  CoreManager *coreManager = CoreManager::getInstance();
+  QObject::connect(coreManager, &CoreManager::coreManagerInitialized, coreManager, [this, coreManager] {
+    // No view will request the models: create them all now.
+    coreManager->getContactsListModel();
+    coreManager->getSipAddressesModel();
+    coreManager->getHistoryStatsModel();
+    coreManager->getContactsImporterListModel();
+    coreManager->getLdapListModel();
+
+    // Deferred cli commands are executed now.
+    setOpened(true);
+    saveStartupTrace(nullptr);
+  });
+
+  // Keep reading after a restart.
+  if (mCliReader)
+    return;
+
+  mCliReader = new CliReader(this);
+  QObject::connect(mCliReader, &CliReader::commandRead, this, [](const QString &command) {
+    Cli::executeCommand(command);
+  });
+  QObject::connect(mCliReader, &QThread::finished, this, [] {
+    qInfo() << QStringLiteral("End of cli commands. Quit.");
+    QCoreApplication::quit();
+  });
+  mCliReader->start();
+}
+
 // -----------------------------------------------------------------------------
 
 QString App::getCommandArgument () {
@@ -395,6 +477,8 @@ QQuickWindow *App::getCallsWindow () const {
 }
 
 QQuickWindow *App::getMainWindow () const {
+  if (!mEngine)
+    return nullptr;
   return qobject_cast<QQuickWindow *>(
     const_cast<QQmlApplicationEngine *>(mEngine)->rootObjects().at(0)
   );
@@ -421,7 +505,8 @@ void App::smartShowWindow (QQuickWindow *window) {
 
 // -----------------------------------------------------------------------------
 bool App::hasFocus () const {
-  return getMainWindow()->isActive() || (mCallsWindow && mCallsWindow->isActive());
+  QQuickWindow *mainWindow = getMainWindow();
+  return (mainWindow && mainWindow->isActive()) || (mCallsWindow && mCallsWindow->isActive());
 }
 // -----------------------------------------------------------------------------
 
@@ -441,7 +526,9 @@ void App::createParser () {
     #ifndef Q_OS_MACOS
       { "iconified", tr("commandLineOptionIconified") },
     #endif // ifndef Q_OS_MACOS
-    { { "V", "verbose" }, tr("commandLineOptionVerbose") }
+    { { "V", "verbose" }, tr("commandLineOptionVerbose") },
+    { "trace-startup", tr("commandLineOptionTraceStartup"), tr("commandLineOptionTraceStartupArg") },
+    { "headless", tr("commandLineOptionHeadless") }
   });
 }
 
@@ -517,8 +604,13 @@ void App::registerTypes () {
   registerType<AssistantModel>("AssistantModel");
   registerType<AuthenticationNotifier>("AuthenticationNotifier");
   registerType<CallsListProxyModel>("CallsListProxyModel");
-  registerType<Camera>("Camera");
-  registerType<CameraPreview>("CameraPreview");
+  if (mSoftwareVideoRendering) {
+    registerType<SoftwareCamera>("Camera");
+    registerType<SoftwareCameraPreview>("CameraPreview");
+  } else {
+    registerType<Camera>("Camera");
+    registerType<CameraPreview>("CameraPreview");
+  }
   registerType<ConferenceHelperModel>("ConferenceHelperModel");
   registerType<ConferenceModel>("ConferenceModel");
   registerType<ContactsListProxyModel>("ContactsListProxyModel");
@@ -540,6 +632,7 @@ void App::registerTypes () {
   registerSingletonType<VideoCodecsModel>("VideoCodecsModel");
 
   registerUncreatableType<CallModel>("CallModel");
+  registerUncreatableType<CallStatsModel>("CallStatsModel");
   registerUncreatableType<ConferenceHelperModel::ConferenceAddModel>("ConferenceAddModel");
   registerUncreatableType<ContactModel>("ContactModel");
   registerUncreatableType<ContactsImporterModel>("ContactsImporterModel");
@@ -560,6 +653,7 @@ void App::registerSharedTypes () {
   registerSharedSingletonType<ContactsListModel, &CoreManager::getContactsListModel>("ContactsListModel");
   registerSharedSingletonType<ContactsImporterListModel, &CoreManager::getContactsImporterListModel>("ContactsImporterListModel");
   registerSharedSingletonType<LdapListModel, &CoreManager::getLdapListModel>("LdapListModel");
+  registerSharedSingletonType<HistoryStatsModel, &CoreManager::getHistoryStatsModel>("HistoryStatsModel");
 }
 
 void App::registerToolTypes () {
@@ -631,11 +725,16 @@ QString App::getLocale () const {
 // -----------------------------------------------------------------------------
 
 void App::openAppAfterInit (bool mustBeIconified) {
+  TRACE_SPAN("App::openAppAfterInit");
+
   qInfo() << QStringLiteral("Open " APPLICATION_NAME " app.");
   auto coreManager = CoreManager::getInstance();
   // Create other windows.
-  mCallsWindow = createSubWindow(mEngine, QmlViewCallsWindow);
-  mSettingsWindow = createSubWindow(mEngine, QmlViewSettingsWindow);
+  {
+    TRACE_SPAN("App::createSubWindows");
+    mCallsWindow = createSubWindow(mEngine, QmlViewCallsWindow);
+    mSettingsWindow = createSubWindow(mEngine, QmlViewSettingsWindow);
+  }
   QObject::connect(mSettingsWindow, &QWindow::visibilityChanged, this, [coreManager](QWindow::Visibility visibility) {
     if (visibility == QWindow::Hidden) {
       qInfo() << QStringLiteral("Update nat policy.");
@@ -680,4 +779,32 @@ void App::openAppAfterInit (bool mustBeIconified) {
 #endif
       setOpened(true);
   }
+
+  saveStartupTrace(mainWindow);
+}
+
+static void saveTrace (const QString &filePath) {
+  if (!Tracer::save(filePath))
+    qWarning() << QStringLiteral("Startup trace lost: `%1`.").arg(filePath);
+}
+
+void App::saveStartupTrace (QQuickWindow *mainWindow) {
+  if (!Tracer::isEnabled() || mStartupTraceFilePath.isEmpty())
+    return;
+
+  const QString filePath = mStartupTraceFilePath;
+  if (!mainWindow || !mainWindow->isVisible()) {
+    Tracer::stop();
+    saveTrace(filePath);
+    return;
+  }
+
+  // `frameSwapped` is emitted by the render thread, the slot is queued.
+  shared_ptr<QMetaObject::Connection> connection = make_shared<QMetaObject::Connection>();
+  *connection = QObject::connect(mainWindow, &QQuickWindow::frameSwapped, this, [connection, filePath] {
+    QObject::disconnect(*connection);
+    Tracer::addInstant("First frame");
+    Tracer::stop();
+    saveTrace(filePath);
+  });
 }
@@ -35,6 +35,7 @@ namespace linphone {
   class Config;
 }
 
+class CliReader;
 class Colors;
 class DefaultTranslator;
 class Notifier;
@@ -78,6 +79,11 @@ public:
     return mIsOpened;
   }
 
+  // Without QML engine nor windows. Cli commands are read on stdin.
+  bool isHeadless () const {
+    return mHeadless;
+  }
+
   static App *getInstance () {
     return static_cast<App *>(QApplication::instance());
   }
@@ -119,7 +125,10 @@ private:
     return mAvailableLocales;
   }
 
+  void initHeadlessContentApp ();
+
   void openAppAfterInit (bool mustBeIconified = false);
+  void saveStartupTrace (QQuickWindow *mainWindow);
 
   void setOpened (bool status) {
     if (mIsOpened != status) {
@@ -131,6 +140,7 @@ private:
   QString mLocale;
 
   QCommandLineParser *mParser = nullptr;
+  QString mStartupTraceFilePath;
 
   QQmlApplicationEngine *mEngine = nullptr;
 
@@ -144,6 +154,10 @@ private:
   Colors *mColors = nullptr;
 
   bool mIsOpened = false;
+
+  bool mHeadless = false;
+  bool mSoftwareVideoRendering = false;
+  CliReader *mCliReader = nullptr;
 };
 
 #endif // APP_H_
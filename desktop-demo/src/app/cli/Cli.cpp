@@ -117,6 +117,20 @@ static void cliJoinConferenceAs (QHash<QString, QString> &args) {
 	coreManager->getCallsListModel()->launchAudioCall(toSipAddress, args);
 }
 
+static void cliHandlersStats (QHash<QString, QString> &args) {
+	CoreManager *coreManager = CoreManager::getInstance();
+	CoreHandlersProfiler *profiler = coreManager->getHandlers()->getProfiler();
+	if (args.contains("enable"))
+		profiler->setEnabled(args["enable"] != "0", coreManager->getHandlersProfilingLogInterval());
+
+	const QString stats = profiler->toString();
+	cout << Utils::appStringToCoreString(stats) << endl;
+	qInfo().noquote() << QStringLiteral("Core handlers:\n") + stats;
+
+	if (args["reset"] == "1")
+		profiler->reset();
+}
+
 static void cliInitiateConference (QHash<QString, QString> &args) {
 	shared_ptr<linphone::Core> core = CoreManager::getInstance()->getCore();
 
@@ -419,6 +433,9 @@ QMap<QString, Cli::Command> Cli::mCommands = {
 		{ "sip-address", {} }, { "conference-id", {} }, { "guest-sip-address", {} }
 	}),
 	createCommand("bye", QT_TR_NOOP("byeFunctionDescription"), cliBye, QHash<QString, Argument>(), true),
+	createCommand("handlers-stats", QT_TR_NOOP("handlersStatsFunctionDescription"), cliHandlersStats, {
+		{ "enable", { String, true } }, { "reset", { String, true } }
+	}),
 };
 
 // -----------------------------------------------------------------------------
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2010-2020 Belledonne Communications SARL.
+ *
+ * This file is part of linphone-desktop
+ * (see https://www.linphone.org).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <iostream>
+
+#include <QtGlobal>
+
+#ifdef Q_OS_WIN
+  #include <windows.h>
+#else
+  #include <cerrno>
+  #include <poll.h>
+  #include <unistd.h>
+#endif // ifdef Q_OS_WIN
+
+#include "CliReader.hpp"
+
+// =============================================================================
+
+using namespace std;
+
+namespace {
+  constexpr int StopInterval = 100; // In milliseconds.
+}
+
+void CliReader::stop () {
+  requestInterruption();
+
+#ifdef Q_OS_WIN
+  // The console read can only be cancelled once it is started: retry until the thread ends.
+  while (!wait(StopInterval)) {
+    QMutexLocker locker(&mMutex);
+    if (mThreadHandle)
+      CancelSynchronousIo(mThreadHandle);
+  }
+#else
+  wait();
+#endif // ifdef Q_OS_WIN
+}
+
+void CliReader::handleLine (const string &line) {
+  const QString command = QString::fromStdString(line).trimmed();
+  if (!command.isEmpty() && !command.startsWith('#'))
+    emit commandRead(command);
+}
+
+#ifdef Q_OS_WIN
+
+void CliReader::run () {
+  HANDLE thread = nullptr;
+  DuplicateHandle(GetCurrentProcess(), GetCurrentThread(), GetCurrentProcess(), &thread, 0, FALSE, DUPLICATE_SAME_ACCESS);
+  {
+    QMutexLocker locker(&mMutex);
+    mThreadHandle = thread;
+  }
+
+  string line;
+  while (!isInterruptionRequested() && getline(cin, line))
+    handleLine(line);
+
+  QMutexLocker locker(&mMutex);
+  mThreadHandle = nullptr;
+  if (thread)
+    CloseHandle(thread);
+}
+
+#else
+
+// Wait for the input with a timeout to see the stop requests.
+void CliReader::run () {
+  string pending;
+  char buffer[4096];
+  pollfd input = { STDIN_FILENO, POLLIN, 0 };
+
+  while (!isInterruptionRequested()) {
+    const int ready = poll(&input, 1, StopInterval);
+    if (ready == 0 || (ready < 0 && errno == EINTR))
+      continue;
+    if (ready < 0)
+      break;
+
+    const ssize_t size = read(STDIN_FILENO, buffer, sizeof buffer);
+    if (size < 0 && errno == EINTR)
+      continue;
+    if (size <= 0)
+      break; // End of the input.
+
+    pending.append(buffer, size_t(size));
+    for (size_t end; (end = pending.find('\n')) != string::npos; pending.erase(0, end + 1))
+      handleLine(pending.substr(0, end));
+  }
+
+  // Last line without end of line.
+  if (!isInterruptionRequested() && !pending.empty())
+    handleLine(pending);
+}
+
+#endif // ifdef Q_OS_WIN
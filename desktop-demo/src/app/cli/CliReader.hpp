@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2010-2020 Belledonne Communications SARL.
+ *
+ * This file is part of linphone-desktop
+ * (see https://www.linphone.org).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CLI_READER_H_
+#define CLI_READER_H_
+
+#include <string>
+
+#include <QMutex>
+#include <QThread>
+
+// =============================================================================
+// Read cli commands on the standard input, one per line. Used in headless
+// mode. The thread finishes at the end of the input or when it is stopped.
+// =============================================================================
+
+class CliReader : public QThread {
+  Q_OBJECT;
+
+public:
+  CliReader (QObject *parent = Q_NULLPTR) : QThread(parent) {}
+
+  // Stop reading without waiting for the next line. Return when the thread is finished.
+  void stop ();
+
+signals:
+  void commandRead (const QString &command);
+
+protected:
+  void run () override;
+
+private:
+  void handleLine (const std::string &line);
+
+#ifdef Q_OS_WIN
+  QMutex mMutex;
+  void *mThreadHandle = nullptr; // Of the reading thread, to cancel its blocking read.
+#endif // ifdef Q_OS_WIN
+};
+
+#endif // CLI_READER_H_
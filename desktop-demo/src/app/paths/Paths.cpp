@@ -37,8 +37,11 @@ using namespace std;
 namespace {
   constexpr char PathAssistantConfig[] = "/" EXECUTABLE_NAME "/assistant/";
   constexpr char PathAvatars[] = "/avatars/";
+  constexpr char PathCallQuality[] = "/call-quality/";
   constexpr char PathCaptures[] = "/" EXECUTABLE_NAME "/captures/";
   constexpr char PathCodecs[] =  "/codecs/";
+  constexpr char PathContactsImport[] = "/contacts-import/";
+  constexpr char PathIconsCache[] = "/icons/";
   constexpr char PathTools[] =  "/tools/";
   constexpr char PathLogs[] = "/logs/";
 #ifdef APPLE
@@ -219,6 +222,10 @@ string Paths::getCallHistoryFilePath () {
   return getWritableFilePath(getAppCallHistoryFilePath());
 }
 
+string Paths::getCallQualityDirPath () {
+  return getWritableDirPath(QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + PathCallQuality);
+}
+
 string Paths::getCapturesDirPath () {
   return getWritableDirPath(QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation) + PathCaptures);
 }
@@ -257,10 +264,18 @@ string Paths::getFriendsListFilePath () {
   return getWritableFilePath(getAppFriendsFilePath());
 }
 
+string Paths::getContactsImportDirPath () {
+  return getWritableDirPath(QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + PathContactsImport);
+}
+
 string Paths::getDownloadDirPath () {
   return getWritableDirPath(QStandardPaths::writableLocation(QStandardPaths::DownloadLocation));
 }
 
+string Paths::getIconsCacheDirPath () {
+  return getWritableDirPath(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + PathIconsCache);
+}
+
 string Paths::getLogsDirPath () {
   return getWritableDirPath(QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + PathLogs);
 }
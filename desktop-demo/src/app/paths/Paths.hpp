@@ -32,13 +32,16 @@ namespace Paths {
   std::string getAssistantConfigDirPath ();
   std::string getAvatarsDirPath ();
   std::string getCallHistoryFilePath ();
+  std::string getCallQualityDirPath ();
   std::string getCapturesDirPath ();
   std::string getCodecsDirPath ();
   std::string getConfigDirPath (bool writable = true);
   std::string getConfigFilePath (const QString &configPath = QString(), bool writable = true);
+  std::string getContactsImportDirPath ();
   std::string getDownloadDirPath ();
   std::string getFactoryConfigFilePath ();
   std::string getFriendsListFilePath ();
+  std::string getIconsCacheDirPath ();
   std::string getLogsDirPath ();
   std::string getMessageHistoryFilePath ();
   std::string getPackageDataDirPath ();
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2010-2020 Belledonne Communications SARL.
+ *
+ * This file is part of linphone-desktop
+ * (see https://www.linphone.org).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QThread>
+#include <QThreadPool>
+
+#include "app/tracer/Tracer.hpp"
+
+#include "ImageFileCache.hpp"
+
+#include "AsyncImageResponse.hpp"
+
+// =============================================================================
+
+using namespace std;
+
+namespace {
+  // The priority of the pool is the priority class followed by the sequence
+  // number of the request. The sequence wraps after 2^24 requests: a few
+  // requests are then served in the wrong order.
+  constexpr int SequenceBits = 24;
+  constexpr int SequenceMask = (1 << SequenceBits) - 1;
+}
+
+static QThreadPool *createThreadPool () {
+  QThreadPool *threadPool = new QThreadPool();
+  // One thread is left to the GUI and render threads.
+  threadPool->setMaxThreadCount(qMax(2, QThread::idealThreadCount() - 1));
+  return threadPool;
+}
+
+// Never destroyed: `stopAll` is called before the providers are.
+static QThreadPool *getThreadPool () {
+  static QThreadPool *threadPool = createThreadPool();
+  return threadPool;
+}
+
+static int getNextPriority (AsyncImageResponse::Priority priority) {
+  static atomic<int> sequence(0);
+  return (int(priority) << SequenceBits) | (sequence++ & SequenceMask);
+}
+
+// -----------------------------------------------------------------------------
+
+AsyncImageResponse::AsyncImageResponse (const QString &id, const Loader &loader, Priority priority) :
+  mId(id), mState(make_shared<State>()) {
+  static atomic<qint64> requestCount(0);
+  Tracer::addCounter("Async image requests", ++requestCount);
+
+  shared_ptr<State> state = mState;
+  AsyncImageTask *task = new AsyncImageTask([loader, state]() {
+    if (state->cancelled)
+      return;
+    TRACE_SPAN("AsyncImageResponse::load");
+    QQuickTextureFactory *factory = loader();
+    QMutexLocker locker(&state->mutex);
+    state->factory = factory;
+  });
+  QObject::connect(task, &AsyncImageTask::done, this, [this]() {
+    emit finished();
+  }, Qt::QueuedConnection);
+  getThreadPool()->start(task, getNextPriority(priority));
+}
+
+QQuickTextureFactory *AsyncImageResponse::textureFactory () const {
+  QMutexLocker locker(&mState->mutex);
+  QQuickTextureFactory *factory = mState->factory;
+  mState->factory = nullptr;
+  return factory;
+}
+
+QString AsyncImageResponse::errorString () const {
+  QMutexLocker locker(&mState->mutex);
+  return mState->factory || mState->cancelled
+    ? QString()
+    : QStringLiteral("Unable to load image: `%1`.").arg(mId);
+}
+
+// The engine still waits for `finished`: the task emits it without loading.
+void AsyncImageResponse::cancel () {
+  static atomic<qint64> cancelCount(0);
+  Tracer::addCounter("Async image cancels", ++cancelCount);
+
+  mState->cancelled = true;
+}
+
+// -----------------------------------------------------------------------------
+
+AsyncImageResponse *AsyncImageResponse::createForFile (
+  const shared_ptr<ImageFileCache> &cache,
+  const QString &path,
+  const QSize &requestedSize
+) {
+  return new AsyncImageResponse(path, [cache, path, requestedSize]() -> QQuickTextureFactory * {
+    const QImage image = cache->getImage(path, requestedSize);
+    return image.isNull() ? nullptr : QQuickTextureFactory::textureFactoryForImage(image);
+  }, FilePriority);
+}
+
+void AsyncImageResponse::stopAll () {
+  QThreadPool *threadPool = getThreadPool();
+  threadPool->clear();
+  threadPool->waitForDone();
+}
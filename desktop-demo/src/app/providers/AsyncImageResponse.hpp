@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2010-2020 Belledonne Communications SARL.
+ *
+ * This file is part of linphone-desktop
+ * (see https://www.linphone.org).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ASYNC_IMAGE_RESPONSE_H_
+#define ASYNC_IMAGE_RESPONSE_H_
+
+#include <atomic>
+#include <functional>
+#include <memory>
+
+#include <QMutex>
+#include <QQuickImageProvider>
+#include <QRunnable>
+
+// =============================================================================
+// Loads the images of the providers in a thread pool shared by all providers.
+// The QML engine reader thread only dispatches the requests, so the images
+// of different items are decoded concurrently.
+//
+// The requests are served newest first: while a view is flinged, the last
+// created delegates are the visible ones, and the delegates destroyed since
+// their request cancel it. A cancelled request is skipped without loading.
+// =============================================================================
+
+class ImageFileCache;
+
+class AsyncImageResponse : public QQuickImageResponse {
+public:
+  enum Priority {
+    FilePriority, // Avatars, thumbnails...
+    IconPriority // Small and displayed everywhere.
+  };
+
+  // Called in a pool thread. Returns null on failure.
+  typedef std::function<QQuickTextureFactory *()> Loader;
+
+  AsyncImageResponse (const QString &id, const Loader &loader, Priority priority);
+
+  QQuickTextureFactory *textureFactory () const override;
+  QString errorString () const override;
+
+  void cancel () override;
+
+  static AsyncImageResponse *createForFile (
+    const std::shared_ptr<ImageFileCache> &cache,
+    const QString &path,
+    const QSize &requestedSize
+  );
+
+  // Drops the queued requests and waits for the running ones. The loaders
+  // must not outlive the providers they use.
+  static void stopAll ();
+
+private:
+  struct State {
+    State () : cancelled(false), factory(nullptr) {}
+    ~State () {
+      delete factory;
+    }
+
+    std::atomic<bool> cancelled;
+    QMutex mutex;
+    QQuickTextureFactory *factory; // Owned until taken by the engine.
+  };
+
+  QString mId;
+  std::shared_ptr<State> mState;
+};
+
+// -----------------------------------------------------------------------------
+
+// Runs in the pool. `done` is queued to the response: it's dropped if the
+// response is destroyed in the meantime.
+class AsyncImageTask : public QObject, public QRunnable {
+  Q_OBJECT;
+
+public:
+  AsyncImageTask (const std::function<void()> &work) : mWork(work) {}
+
+  void run () override {
+    mWork();
+    emit done();
+  }
+
+signals:
+  void done ();
+
+private:
+  std::function<void()> mWork;
+};
+
+#endif // ASYNC_IMAGE_RESPONSE_H_
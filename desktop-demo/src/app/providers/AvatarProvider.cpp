@@ -21,21 +21,18 @@
 #include "app/paths/Paths.hpp"
 #include "utils/Utils.hpp"
 
+#include "AsyncImageResponse.hpp"
+
 #include "AvatarProvider.hpp"
 
 // =============================================================================
 
 const QString AvatarProvider::ProviderId = "avatar";
 
-AvatarProvider::AvatarProvider () : QQuickImageProvider(
-  QQmlImageProviderBase::Image,
-  QQmlImageProviderBase::ForceAsynchronousImageLoading
-) {
+AvatarProvider::AvatarProvider (const std::shared_ptr<ImageFileCache> &cache) : mCache(cache) {
   mAvatarsPath = Utils::coreStringToAppString(Paths::getAvatarsDirPath());
 }
 
-QImage AvatarProvider::requestImage (const QString &id, QSize *size, const QSize &) {
-  QImage image(mAvatarsPath + id);
-  *size = image.size();
-  return image;
+QQuickImageResponse *AvatarProvider::requestImageResponse (const QString &id, const QSize &requestedSize) {
+  return AsyncImageResponse::createForFile(mCache, mAvatarsPath + id, requestedSize);
 }
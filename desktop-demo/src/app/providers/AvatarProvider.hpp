@@ -21,19 +21,24 @@
 #ifndef AVATAR_PROVIDER_H_
 #define AVATAR_PROVIDER_H_
 
+#include <memory>
+
 #include <QQuickImageProvider>
 
 // =============================================================================
 
-class AvatarProvider : public QQuickImageProvider {
+class ImageFileCache;
+
+class AvatarProvider : public QQuickAsyncImageProvider {
 public:
-  AvatarProvider ();
+  AvatarProvider (const std::shared_ptr<ImageFileCache> &cache);
 
-  QImage requestImage (const QString &id, QSize *size, const QSize &requestedSize) override;
+  QQuickImageResponse *requestImageResponse (const QString &id, const QSize &requestedSize) override;
 
   static const QString ProviderId;
 
 private:
+  std::shared_ptr<ImageFileCache> mCache;
   QString mAvatarsPath;
 };
 
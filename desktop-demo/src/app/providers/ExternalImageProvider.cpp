@@ -21,22 +21,17 @@
 #include "app/paths/Paths.hpp"
 #include "utils/Utils.hpp"
 
-#include "ExternalImageProvider.hpp"
+#include "AsyncImageResponse.hpp"
 
-#include <QImageReader>
+#include "ExternalImageProvider.hpp"
 
 // =============================================================================
 
 const QString ExternalImageProvider::ProviderId = "external";
 
-ExternalImageProvider::ExternalImageProvider () : QQuickImageProvider(
-  QQmlImageProviderBase::Image,
-  QQmlImageProviderBase::ForceAsynchronousImageLoading
-) {
+ExternalImageProvider::ExternalImageProvider (const std::shared_ptr<ImageFileCache> &cache) : mCache(cache) {
 }
 
-QImage ExternalImageProvider::requestImage (const QString &id, QSize *size, const QSize &) {
-  QImage image(Utils::getImage(id));
-  *size = image.size();
-  return image;
+QQuickImageResponse *ExternalImageProvider::requestImageResponse (const QString &id, const QSize &requestedSize) {
+  return AsyncImageResponse::createForFile(mCache, id, requestedSize);
 }
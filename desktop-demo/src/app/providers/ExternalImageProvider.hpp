@@ -21,17 +21,24 @@
 #ifndef EXTERNAL_IMAGE_PROVIDER_H_
 #define EXTERNAL_IMAGE_PROVIDER_H_
 
+#include <memory>
+
 #include <QQuickImageProvider>
 
 // =============================================================================
 
-class ExternalImageProvider : public QQuickImageProvider {
+class ImageFileCache;
+
+class ExternalImageProvider : public QQuickAsyncImageProvider {
 public:
-  ExternalImageProvider ();
+  ExternalImageProvider (const std::shared_ptr<ImageFileCache> &cache);
 
-  QImage requestImage (const QString &id, QSize *size, const QSize &requestedSize) override;
+  QQuickImageResponse *requestImageResponse (const QString &id, const QSize &requestedSize) override;
 
   static const QString ProviderId;
+
+private:
+  std::shared_ptr<ImageFileCache> mCache;
 };
 
 #endif // EXTERNAL_IMAGE_PROVIDER_H_
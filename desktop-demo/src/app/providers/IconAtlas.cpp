@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) 2010-2020 Belledonne Communications SARL.
+ *
+ * This file is part of linphone-desktop
+ * (see https://www.linphone.org).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QDataStream>
+#include <QFile>
+#include <QQuickTextureFactory>
+#include <QQuickWindow>
+#include <QSGRendererInterface>
+#include <QSGTexture>
+#include <QSaveFile>
+#include <QtDebug>
+
+#include "app/tracer/Tracer.hpp"
+
+#include "IconAtlas.hpp"
+
+// =============================================================================
+
+using namespace std;
+
+namespace {
+  constexpr quint32 FileMagic = 0x4c494341; // "LICA".
+  constexpr quint32 FileVersion = 1;
+}
+
+// -----------------------------------------------------------------------------
+// An icon of a page texture. The texture is shared: only the sub-rect of the
+// icon is drawn, like the textures of the scene graph atlas.
+// -----------------------------------------------------------------------------
+
+class IconAtlas::PageTexture : public QSGTexture {
+public:
+  PageTexture (const shared_ptr<QSGTexture> &page, const QImage &pageImage, const QRect &rect, QQuickWindow *window) :
+    mPage(page), mPageImage(pageImage), mRect(rect), mWindow(window) {}
+
+  ~PageTexture () {
+    delete mStandalone;
+  }
+
+  int textureId () const override {
+    return mPage->textureId();
+  }
+
+  QSize textureSize () const override {
+    return mRect.size();
+  }
+
+  bool hasAlphaChannel () const override {
+    return true;
+  }
+
+  bool hasMipmaps () const override {
+    return false;
+  }
+
+  bool isAtlasTexture () const override {
+    return true;
+  }
+
+  QRectF normalizedTextureSubRect () const override {
+    const QSizeF pageSize = mPage->textureSize();
+    const QRectF pageRect = mPage->normalizedTextureSubRect();
+    return QRectF(
+      pageRect.x() + pageRect.width() * mRect.x() / pageSize.width(),
+      pageRect.y() + pageRect.height() * mRect.y() / pageSize.height(),
+      pageRect.width() * mRect.width() / pageSize.width(),
+      pageRect.height() * mRect.height() / pageSize.height()
+    );
+  }
+
+  // Needed for the mipmaps and the repeated images.
+  QSGTexture *removedFromAtlas () const override {
+    if (!mStandalone)
+      mStandalone = mWindow->createTextureFromImage(mPageImage.copy(mRect), QQuickWindow::TextureHasAlphaChannel);
+    return mStandalone;
+  }
+
+  void bind () override {
+    mPage->setFiltering(filtering());
+    mPage->bind();
+  }
+
+private:
+  shared_ptr<QSGTexture> mPage;
+  QImage mPageImage;
+  QRect mRect;
+  QQuickWindow *mWindow;
+  mutable QSGTexture *mStandalone = nullptr;
+};
+
+// -----------------------------------------------------------------------------
+
+class IconAtlas::TextureFactory : public QQuickTextureFactory {
+public:
+  TextureFactory (const shared_ptr<IconAtlas> &atlas, const Entry &entry) : mAtlas(atlas), mEntry(entry) {}
+
+  QSGTexture *createTexture (QQuickWindow *window) const override {
+    return mAtlas->createTexture(window, mEntry);
+  }
+
+  QSize textureSize () const override {
+    return mEntry.rect.size();
+  }
+
+  int textureByteCount () const override {
+    return mEntry.rect.width() * mEntry.rect.height() * 4;
+  }
+
+  QImage image () const override {
+    return mAtlas->getPage(mEntry.page).copy(mEntry.rect);
+  }
+
+private:
+  shared_ptr<IconAtlas> mAtlas;
+  Entry mEntry;
+};
+
+// -----------------------------------------------------------------------------
+
+bool IconAtlas::save (
+  const QString &filePath,
+  const QString &themeHash,
+  const QVector<QImage> &pages,
+  const QHash<QString, Entry> &entries
+) {
+  QSaveFile file(filePath);
+  if (!file.open(QIODevice::WriteOnly)) {
+    qWarning() << QStringLiteral("Unable to open icon atlas: `%1`.").arg(filePath);
+    return false;
+  }
+
+  QDataStream stream(&file);
+  stream.setVersion(QDataStream::Qt_5_9);
+  stream << FileMagic << FileVersion << themeHash;
+
+  stream << quint32(pages.count());
+  for (const QImage &page : pages) {
+    QByteArray encodedPage;
+    QDataStream pageStream(&encodedPage, QIODevice::WriteOnly);
+    pageStream.setVersion(QDataStream::Qt_5_9);
+    pageStream << page; // PNG.
+    stream << encodedPage;
+  }
+
+  stream << quint32(entries.count());
+  for (auto it = entries.cbegin(); it != entries.cend(); ++it)
+    stream << it.key() << qint32(it->page) << it->rect;
+
+  if (stream.status() != QDataStream::Ok || !file.commit()) {
+    qWarning() << QStringLiteral("Unable to write icon atlas: `%1`.").arg(filePath);
+    return false;
+  }
+  return true;
+}
+
+bool IconAtlas::load (const QString &filePath, const QString &themeHash) {
+  QFile file(filePath);
+  if (!file.open(QIODevice::ReadOnly))
+    return false;
+
+  QDataStream stream(&file);
+  stream.setVersion(QDataStream::Qt_5_9);
+
+  quint32 magic, version;
+  QString fileThemeHash;
+  stream >> magic >> version >> fileThemeHash;
+  if (magic != FileMagic || version != FileVersion) {
+    qWarning() << QStringLiteral("Invalid icon atlas: `%1`.").arg(filePath);
+    return false;
+  }
+  if (fileThemeHash != themeHash) {
+    qInfo() << QStringLiteral("Icon atlas `%1` was built for another theme.").arg(filePath);
+    return false;
+  }
+
+  quint32 pageCount;
+  stream >> pageCount;
+  QVector<QByteArray> encodedPages;
+  for (quint32 i = 0; i < pageCount && stream.status() == QDataStream::Ok; ++i) {
+    QByteArray encodedPage;
+    stream >> encodedPage;
+    encodedPages << encodedPage;
+  }
+
+  quint32 entryCount;
+  stream >> entryCount;
+  QHash<QString, Entry> entries;
+  for (quint32 i = 0; i < entryCount && stream.status() == QDataStream::Ok; ++i) {
+    QString key;
+    qint32 page;
+    Entry entry;
+    stream >> key >> page >> entry.rect;
+    if (page < 0 || quint32(page) >= pageCount)
+      break;
+    entry.page = page;
+    entries[key] = entry;
+  }
+
+  if (stream.status() != QDataStream::Ok || quint32(entries.count()) != entryCount) {
+    qWarning() << QStringLiteral("Invalid icon atlas: `%1`.").arg(filePath);
+    return false;
+  }
+
+  mEncodedPages = encodedPages;
+  mPages.fill(QImage(), encodedPages.count());
+  mEntries = entries;
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+
+bool IconAtlas::find (const QString &key, Entry &entry) const {
+  auto it = mEntries.constFind(key);
+  if (it == mEntries.cend())
+    return false;
+  entry = *it;
+  return true;
+}
+
+QImage IconAtlas::getPage (int page) {
+  QMutexLocker locker(&mMutex);
+  QImage &image = mPages[page];
+  if (image.isNull()) {
+    TRACE_SPAN("IconAtlas::decodePage");
+    QDataStream stream(mEncodedPages[page]);
+    stream.setVersion(QDataStream::Qt_5_9);
+    stream >> image;
+    image = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+  }
+  return image;
+}
+
+QQuickTextureFactory *IconAtlas::createTextureFactory (const Entry &entry) {
+  return new TextureFactory(shared_from_this(), entry);
+}
+
+QSGTexture *IconAtlas::createTexture (QQuickWindow *window, const Entry &entry) {
+  const QImage page = getPage(entry.page);
+
+  // The other backends (software, Direct3D...) draw their own textures only.
+  QSGRendererInterface *rendererInterface = window->rendererInterface();
+  if (!rendererInterface || rendererInterface->graphicsApi() != QSGRendererInterface::OpenGL)
+    return window->createTextureFromImage(page.copy(entry.rect), QQuickWindow::TextureHasAlphaChannel);
+
+  shared_ptr<QSGTexture> pageTexture;
+  {
+    QMutexLocker locker(&mMutex);
+    weak_ptr<QSGTexture> &weakPageTexture = mPageTextures[qMakePair(window, entry.page)];
+    pageTexture = weakPageTexture.lock();
+    if (!pageTexture) {
+      // Deleted with the last icon of the page, on the render thread.
+      pageTexture.reset(window->createTextureFromImage(page, QQuickWindow::TextureHasAlphaChannel));
+      weakPageTexture = pageTexture;
+      Tracer::addCounter("Icon atlas page uploads", qint64(++mPageUploadCount));
+    }
+  }
+
+  return new PageTexture(pageTexture, page, entry.rect, window);
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2010-2020 Belledonne Communications SARL.
+ *
+ * This file is part of linphone-desktop
+ * (see https://www.linphone.org).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ICON_ATLAS_H_
+#define ICON_ATLAS_H_
+
+#include <atomic>
+#include <memory>
+
+#include <QHash>
+#include <QImage>
+#include <QMutex>
+#include <QVector>
+
+// =============================================================================
+// Icons rendered ahead of time by `tools/icon-atlas` and packed in pages.
+// The entries are indexed by `IconRenderer::getImageKey`, the pages are
+// decoded on first use. On OpenGL, the icons of a page share one texture by
+// window: the page is uploaded once and the items are drawn in one batch.
+// =============================================================================
+
+class QQuickTextureFactory;
+class QQuickWindow;
+class QSGTexture;
+
+class IconAtlas : public std::enable_shared_from_this<IconAtlas> {
+public:
+  struct Entry {
+    int page = -1;
+    QRect rect;
+  };
+
+  // Build time.
+  static bool save (
+    const QString &filePath,
+    const QString &themeHash,
+    const QVector<QImage> &pages,
+    const QHash<QString, Entry> &entries
+  );
+
+  // Fails if the file is invalid or if it was built for another theme.
+  bool load (const QString &filePath, const QString &themeHash);
+
+  // Thread-safe after `load`.
+  bool find (const QString &key, Entry &entry) const;
+  QImage getPage (int page);
+  QQuickTextureFactory *createTextureFactory (const Entry &entry);
+
+  int getEntryCount () const {
+    return mEntries.count();
+  }
+
+  quint64 getPageUploadCount () const {
+    return mPageUploadCount;
+  }
+
+private:
+  class PageTexture;
+  class TextureFactory;
+
+  // Render thread of `window`.
+  QSGTexture *createTexture (QQuickWindow *window, const Entry &entry);
+
+  QHash<QString, Entry> mEntries;
+  QVector<QByteArray> mEncodedPages;
+
+  QMutex mMutex;
+  QVector<QImage> mPages;
+  QHash<QPair<QQuickWindow *, int>, std::weak_ptr<QSGTexture>> mPageTextures;
+
+  std::atomic<quint64> mPageUploadCount { 0 };
+};
+
+#endif // ICON_ATLAS_H_
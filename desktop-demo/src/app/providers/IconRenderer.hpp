@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2010-2020 Belledonne Communications SARL.
+ *
+ * This file is part of linphone-desktop
+ * (see https://www.linphone.org).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ICON_RENDERER_H_
+#define ICON_RENDERER_H_
+
+#include <QImage>
+#include <QString>
+
+// =============================================================================
+// Renders the svg icons with the colors of the theme: the `color-<name>-fill`,
+// `color-<name>-stroke` and `color-<name>-style-*` classes of the elements are
+// replaced by the `Colors` values. Used by `ImageProvider` at runtime and by
+// the icon atlas tool at build time.
+// =============================================================================
+
+namespace IconRenderer {
+  // Identifies a rendered variant of an icon. `ratio` is only used without
+  // requested size: the image has the default size of the svg.
+  QString getImageKey (const QString &id, const QSize &requestedSize, qreal ratio);
+
+  // Changes with the application version and the colors.
+  QString computeThemeHash ();
+
+  QImage render (const QString &path, const QSize &requestedSize, qreal ratio);
+}
+
+#endif // ICON_RENDERER_H_
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2010-2020 Belledonne Communications SARL.
+ *
+ * This file is part of linphone-desktop
+ * (see https://www.linphone.org).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QImageReader>
+
+#include "app/tracer/Tracer.hpp"
+#include "components/settings/SettingsModel.hpp"
+
+#include "ImageFileCache.hpp"
+
+// =============================================================================
+
+using namespace std;
+
+namespace {
+  constexpr char CacheSizeName[] = "images_cache_size"; // In KiB.
+  constexpr int DefaultCacheSize = 32768;
+}
+
+// The requested size is covered (like `PreserveAspectCrop`): the smallest
+// scale that fills both requested dimensions. A missing dimension is free.
+// Never upscaled.
+static QSize computeScaledSize (const QSize &size, const QSize &requestedSize) {
+  if (size.isEmpty())
+    return QSize();
+
+  qreal scale = 0;
+  if (requestedSize.width() > 0)
+    scale = qreal(requestedSize.width()) / size.width();
+  if (requestedSize.height() > 0)
+    scale = qMax(scale, qreal(requestedSize.height()) / size.height());
+  if (scale <= 0 || scale >= 1)
+    return QSize();
+
+  return QSize(
+    qMax(1, qRound(size.width() * scale)),
+    qMax(1, qRound(size.height() * scale))
+  );
+}
+
+static inline QString getKey (const QString &path, const QSize &requestedSize) {
+  return QStringLiteral("%1@%2x%3").arg(path).arg(requestedSize.width()).arg(requestedSize.height());
+}
+
+// -----------------------------------------------------------------------------
+
+ImageFileCache::ImageFileCache () : mRequestCount(0), mHitCount(0), mInvalidationCount(0), mDecodeCount(0),
+  mDecodeTime(0) {
+  mCache.setMaxCost(DefaultCacheSize * 1024);
+}
+
+ImageFileCache::~ImageFileCache () {
+  const quint64 decodeCount = mDecodeCount;
+  qInfo() << QStringLiteral("Images: %1 requests, %2 cache hits, %3 invalidations, %4 decodes (%5 us per decode).")
+    .arg(mRequestCount.load()).arg(mHitCount.load()).arg(mInvalidationCount.load())
+    .arg(decodeCount).arg(decodeCount ? mDecodeTime.load() / qint64(decodeCount) / 1000 : 0);
+}
+
+// Without config, the default size is used.
+void ImageFileCache::useConfig (const shared_ptr<linphone::Config> &config) {
+  if (!config)
+    return;
+  QMutexLocker locker(&mMutex);
+  mCache.setMaxCost(qMax(0, config->getInt(SettingsModel::UiSection, CacheSizeName, DefaultCacheSize)) * 1024);
+}
+
+// -----------------------------------------------------------------------------
+
+QImage ImageFileCache::getImage (const QString &path, const QSize &requestedSize) {
+  Tracer::addCounter("Image requests", qint64(++mRequestCount));
+
+  const QFileInfo info(path);
+  if (!info.exists())
+    return QImage();
+
+  const QDateTime lastModified = info.lastModified();
+  const qint64 fileSize = info.size();
+  const QString key = getKey(path, requestedSize);
+  {
+    QMutexLocker locker(&mMutex);
+    const Entry *entry = mCache.object(key);
+    if (entry) {
+      if (entry->lastModified == lastModified && entry->fileSize == fileSize) {
+        ++mHitCount;
+        return entry->image;
+      }
+      ++mInvalidationCount;
+      mCache.remove(key);
+    }
+  }
+
+  // Decoded without lock: the requests of different files are concurrent.
+  QElapsedTimer timer;
+  timer.start();
+  const QImage image = decode(path, requestedSize);
+  if (image.isNull())
+    return image;
+  mDecodeTime += timer.nsecsElapsed();
+  Tracer::addCounter("Image decodes", qint64(++mDecodeCount));
+
+  Entry *entry = new Entry();
+  entry->image = image;
+  entry->lastModified = lastModified;
+  entry->fileSize = fileSize;
+  {
+    QMutexLocker locker(&mMutex);
+    mCache.insert(key, entry, image.byteCount());
+  }
+
+  return image;
+}
+
+// The readers of the formats that support it (jpeg...) decode directly at the
+// scaled size, the others decode and scale. The format is detected once from
+// the content: the files of the messages don't always have the right suffix.
+QImage ImageFileCache::decode (const QString &path, const QSize &requestedSize) {
+  TRACE_SPAN("ImageFileCache::decode");
+
+  QImageReader reader(path);
+  reader.setDecideFormatFromContent(true);
+  reader.setScaledSize(computeScaledSize(reader.size(), requestedSize));
+
+  QImage image;
+  if (!reader.read(&image))
+    qWarning() << QStringLiteral("Unable to read image `%1`: %2.").arg(path).arg(reader.errorString());
+  return image;
+}
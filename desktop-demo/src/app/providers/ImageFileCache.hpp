@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2010-2020 Belledonne Communications SARL.
+ *
+ * This file is part of linphone-desktop
+ * (see https://www.linphone.org).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef IMAGE_FILE_CACHE_H_
+#define IMAGE_FILE_CACHE_H_
+
+#include <atomic>
+#include <memory>
+
+#include <QCache>
+#include <QDateTime>
+#include <QImage>
+#include <QMutex>
+
+// =============================================================================
+// Decodes the image files at the size requested by the items and keeps them
+// in a LRU cache bounded in bytes. Shared by the avatar, thumbnail and
+// external providers. An entry is reloaded when its file is modified.
+// =============================================================================
+
+namespace linphone {
+  class Config;
+}
+
+class ImageFileCache {
+public:
+  ImageFileCache ();
+  ~ImageFileCache ();
+
+  void useConfig (const std::shared_ptr<linphone::Config> &config);
+
+  // A null image if the file can't be read. Thread safe.
+  QImage getImage (const QString &path, const QSize &requestedSize);
+
+private:
+  struct Entry {
+    QImage image;
+    QDateTime lastModified;
+    qint64 fileSize;
+  };
+
+  static QImage decode (const QString &path, const QSize &requestedSize);
+
+  QMutex mMutex;
+  QCache<QString, Entry> mCache; // Cost in bytes.
+
+  std::atomic<quint64> mRequestCount;
+  std::atomic<quint64> mHitCount;
+  std::atomic<quint64> mInvalidationCount;
+  std::atomic<quint64> mDecodeCount;
+  std::atomic<qint64> mDecodeTime; // In nanoseconds.
+};
+
+#endif // IMAGE_FILE_CACHE_H_
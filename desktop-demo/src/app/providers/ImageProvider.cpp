@@ -18,14 +18,23 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDir>
 #include <QElapsedTimer>
 #include <QFileInfo>
-#include <QPainter>
+#include <QSaveFile>
 #include <QScreen>
-#include <QSvgRenderer>
 
 #include "app/App.hpp"
-
+#include "app/paths/Paths.hpp"
+#include "app/tracer/Tracer.hpp"
+#include "components/settings/SettingsModel.hpp"
+#include "utils/Utils.hpp"
+
+#include "AsyncImageResponse.hpp"
+#include "IconAtlas.hpp"
+#include "IconRenderer.hpp"
 #include "ImageProvider.hpp"
 
 // =============================================================================
@@ -33,273 +42,195 @@
 using namespace std;
 
 namespace {
-  // Max image size in bytes. (100Kb)
-  constexpr qint64 MaxImageSize = 102400;
-}
+  // Next to the executable, see `tools/icon-atlas`.
+  constexpr char AtlasFileName[] = "icons.atlas";
+  constexpr char AtlasEnabledName[] = "icons_atlas_enabled";
 
-static void removeAttribute (QXmlStreamAttributes &readerAttributes, const QString &name) {
-  auto it = find_if(readerAttributes.cbegin(), readerAttributes.cend(), [&name](const QXmlStreamAttribute &attribute) {
-    return name == attribute.name() && !attribute.prefix().length();
-  });
-  if (it != readerAttributes.cend())
-    readerAttributes.remove(int(distance(readerAttributes.cbegin(), it)));
+  constexpr char MemoryCacheSizeName[] = "icons_memory_cache_size"; // In KiB.
+  constexpr int DefaultMemoryCacheSize = 16384;
+  constexpr char DiskCacheEnabledName[] = "icons_disk_cache_enabled";
 }
 
-static QByteArray buildByteArrayAttribute (const QByteArray &name, const QByteArray &value) {
-  QByteArray attribute = name;
-  attribute.append("=\"");
-  attribute.append(value);
-  attribute.append("\" ");
-  return attribute;
+// Without requested size, the image has the default size of the svg on the primary screen.
+static inline qreal getRatio (const QSize &requestedSize) {
+  return requestedSize.isEmpty() ? QGuiApplication::primaryScreen()->devicePixelRatio() : 0;
 }
 
-static QByteArray parseFillAndStroke (QXmlStreamAttributes &readerAttributes, const Colors &colors) {
-  static QRegExp regex("^color-([^-]+)-(fill|stroke)$");
-
-  QByteArray attributes;
-
-  for (const auto &classValue : readerAttributes.value("class").toLatin1().split(' ')) {
-    regex.indexIn(classValue.trimmed());
-    if (Q_LIKELY(regex.pos() == -1))
-      continue;
-
-    const QStringList list = regex.capturedTexts();
-
-    const QVariant colorValue = colors.property(list[1].toStdString().c_str());
-    if (Q_UNLIKELY(!colorValue.isValid())) {
-      qWarning() << QStringLiteral("Color name `%1` does not exist.").arg(list[1]);
-      continue;
-    }
+// -----------------------------------------------------------------------------
 
-    removeAttribute(readerAttributes, list[2]);
-    attributes.append(buildByteArrayAttribute(list[2].toLatin1(), colorValue.value<QColor>().name().toLatin1()));
-  }
+const QString ImageProvider::ProviderId = "internal";
 
-  return attributes;
+ImageProvider::ImageProvider () : mRequestCount(0), mAtlasHitCount(0), mMemoryHitCount(0), mDiskHitCount(0), mRenderCount(0), mRenderTime(0),
+  mImageUploadCount(0) {
+  mThemeHash = IconRenderer::computeThemeHash();
+  mCache.setMaxCost(DefaultMemoryCacheSize * 1024);
 }
 
-static QByteArray parseStyle (QXmlStreamAttributes &readerAttributes, const Colors &colors) {
-  static QRegExp regex("^color-([^-]+)-style-(fill|stroke)$");
-
-  QByteArray attribute;
-
-  QSet<QString> overrode;
-  for (const auto &classValue : readerAttributes.value("class").toLatin1().split(' ')) {
-    regex.indexIn(classValue.trimmed());
-    if (Q_LIKELY(regex.pos() == -1))
-      continue;
-
-    const QStringList list = regex.capturedTexts();
-
-    overrode.insert(list[2]);
-
-    const QVariant colorValue = colors.property(list[1].toStdString().c_str());
-    if (Q_UNLIKELY(!colorValue.isValid())) {
-      qWarning() << QStringLiteral("Color name `%1` does not exist.").arg(list[1]);
-      continue;
-    }
+ImageProvider::~ImageProvider () {
+  const quint64 renderCount = mRenderCount;
+  qInfo() << QStringLiteral("Icons: %1 requests, %2 atlas hits, %3 memory hits, %4 disk hits, %5 renders (%6 us per render).")
+    .arg(mRequestCount.load()).arg(mAtlasHitCount.load()).arg(mMemoryHitCount.load()).arg(mDiskHitCount.load())
+    .arg(renderCount).arg(renderCount ? mRenderTime.load() / qint64(renderCount) / 1000 : 0);
+  qInfo() << QStringLiteral("Icon textures: %1 atlas pages and %2 images uploaded.")
+    .arg(mAtlas ? mAtlas->getPageUploadCount() : 0).arg(mImageUploadCount.load());
+}
 
-    attribute.append(list[2].toLatin1());
-    attribute.append(":");
-    attribute.append(colorValue.value<QColor>().name().toLatin1());
-    attribute.append(";");
+// Without config, the default values are used.
+void ImageProvider::useConfig (const shared_ptr<linphone::Config> &config) {
+  if (!config || config->getInt(SettingsModel::UiSection, AtlasEnabledName, 1)) {
+    TRACE_SPAN("IconAtlas::load");
+    const QString atlasPath = QDir(QCoreApplication::applicationDirPath()).filePath(AtlasFileName);
+    mAtlas = make_shared<IconAtlas>();
+    if (mAtlas->load(atlasPath, mThemeHash))
+      qInfo() << QStringLiteral("Use the icon atlas `%1` (%2 icons).").arg(atlasPath).arg(mAtlas->getEntryCount());
+    else
+      mAtlas = nullptr;
   }
 
-  const QByteArrayList styleValues = readerAttributes.value("style").toLatin1().split(';');
-  for (const auto &styleValue : styleValues) {
-    const QByteArrayList list = styleValue.split(':');
-    if (Q_UNLIKELY(list.length() > 0 && !overrode.contains(list[0]))) {
-      attribute.append(styleValue);
-      attribute.append(";");
-    }
+  if (config)
+    mCache.setMaxCost(qMax(0, config->getInt(SettingsModel::UiSection, MemoryCacheSizeName, DefaultMemoryCacheSize)) * 1024);
+
+  if (config && !config->getInt(SettingsModel::UiSection, DiskCacheEnabledName, 1)) {
+    mDiskCachePath.clear();
+    return;
   }
 
-  removeAttribute(readerAttributes, "style");
+  const QString rootPath = Utils::coreStringToAppString(Paths::getIconsCacheDirPath());
+  removeOutdatedDiskCaches(rootPath);
+  QDir root(rootPath);
+  if (root.mkpath(mThemeHash))
+    mDiskCachePath = root.filePath(mThemeHash);
+  else
+    qWarning() << QStringLiteral("Unable to create icons cache in: `%1`.").arg(rootPath);
+}
 
-  if (attribute.length() > 0) {
-    attribute.prepend("style=\"");
-    attribute.append("\" ");
-  }
+// -----------------------------------------------------------------------------
 
-  return attribute;
+QQuickImageResponse *ImageProvider::requestImageResponse (const QString &id, const QSize &requestedSize) {
+  return new AsyncImageResponse(id, [this, id, requestedSize]() -> QQuickTextureFactory * {
+    QSize size;
+    return requestTexture(id, &size, requestedSize);
+  }, AsyncImageResponse::IconPriority);
 }
 
-static QByteArray parseAttributes (const QXmlStreamReader &reader, const Colors &colors) {
-  QXmlStreamAttributes readerAttributes = reader.attributes();
+// The icons of an atlas page share one texture. The others are uploaded one by one.
+QQuickTextureFactory *ImageProvider::requestTexture (const QString &id, QSize *size, const QSize &requestedSize) {
+  TRACE_SPAN("ImageProvider::requestTexture");
+  Tracer::addCounter("Icon requests", qint64(++mRequestCount));
 
-  QByteArray attributes = parseFillAndStroke(readerAttributes, colors);
-  attributes.append(parseStyle(readerAttributes, colors));
+  const qreal ratio = getRatio(requestedSize);
+  const QString key = IconRenderer::getImageKey(id, requestedSize, ratio);
 
-  for (const auto &attribute : readerAttributes) {
-    const QByteArray prefix = attribute.prefix().toLatin1();
-    if (Q_UNLIKELY(prefix.length() > 0)) {
-      attributes.append(prefix);
-      attributes.append(":");
-    }
+  IconAtlas::Entry entry;
+  if (mAtlas && mAtlas->find(key, entry)) {
+    ++mAtlasHitCount;
+    *size = entry.rect.size();
+    return mAtlas->createTextureFactory(entry);
+  }
 
-    attributes.append(
-      buildByteArrayAttribute(attribute.name().toLatin1(), attribute.value().toLatin1())
-    );
+  const QImage image = getImage(id, key, requestedSize, ratio);
+  if (image.isNull()) {
+    *size = QSize();
+    return nullptr;
   }
 
-  return attributes;
+  Tracer::addCounter("Icon image uploads", qint64(++mImageUploadCount));
+  *size = image.size();
+  return QQuickTextureFactory::textureFactoryForImage(image);
 }
 
-static QByteArray parseDeclarations (const QXmlStreamReader &reader) {
-  QByteArray declarations;
-  for (const auto &declaration : reader.namespaceDeclarations()) {
-    const QByteArray prefix = declaration.prefix().toLatin1();
-    if (Q_UNLIKELY(prefix.length() > 0)) {
-      declarations.append("xmlns:");
-      declarations.append(prefix);
-    } else
-      declarations.append("xmlns");
-
-    declarations.append("=\"");
-    declarations.append(declaration.namespaceUri().toLatin1());
-    declarations.append("\" ");
-  }
+QImage ImageProvider::requestImage (const QString &id, QSize *size, const QSize &requestedSize) {
+  TRACE_SPAN("ImageProvider::requestImage");
+  Tracer::addCounter("Icon requests", qint64(++mRequestCount));
 
-  return declarations;
-}
+  const qreal ratio = getRatio(requestedSize);
+  const QString key = IconRenderer::getImageKey(id, requestedSize, ratio);
 
-static QByteArray parseStartDocument (const QXmlStreamReader &reader) {
-  QByteArray startDocument = "<?xml version=\"";
-  startDocument.append(reader.documentVersion().toLatin1());
-  startDocument.append("\" encoding=\"");
-  startDocument.append(reader.documentEncoding().toLatin1());
-  startDocument.append("\"?>");
-  return startDocument;
-}
+  IconAtlas::Entry entry;
+  QImage image;
+  if (mAtlas && mAtlas->find(key, entry)) {
+    ++mAtlasHitCount;
+    image = mAtlas->getPage(entry.page).copy(entry.rect);
+  } else
+    image = getImage(id, key, requestedSize, ratio);
 
-static QByteArray parseStartElement (const QXmlStreamReader &reader, const Colors &colors) {
-  QByteArray startElement = "<";
-  startElement.append(reader.name().toLatin1());
-  startElement.append(" ");
-  startElement.append(parseAttributes(reader, colors));
-  startElement.append(" ");
-  startElement.append(parseDeclarations(reader));
-  startElement.append(">");
-  return startElement;
+  *size = image.isNull() ? QSize() : image.size();
+  return image;
 }
 
-static QByteArray parseEndElement (const QXmlStreamReader &reader) {
-  QByteArray endElement = "</";
-  endElement.append(reader.name().toLatin1());
-  endElement.append(">");
-  return endElement;
+QPixmap ImageProvider::requestPixmap (const QString &id, QSize *size, const QSize &requestedSize) {
+  return QPixmap::fromImage(requestImage(id, size, requestedSize));
 }
 
 // -----------------------------------------------------------------------------
 
-static QByteArray computeContent (QFile &file) {
-  const Colors colors;
-
-  QByteArray content;
-  QXmlStreamReader reader(&file);
-  while (!reader.atEnd())
-    switch (reader.readNext()) {
-      case QXmlStreamReader::Comment:
-      case QXmlStreamReader::DTD:
-      case QXmlStreamReader::EndDocument:
-      case QXmlStreamReader::Invalid:
-      case QXmlStreamReader::NoToken:
-      case QXmlStreamReader::ProcessingInstruction:
-        break;
-
-      case QXmlStreamReader::StartDocument:
-        content.append(parseStartDocument(reader));
-        break;
-
-      case QXmlStreamReader::StartElement:
-        content.append(parseStartElement(reader, colors));
-        break;
-
-      case QXmlStreamReader::EndElement:
-        content.append(parseEndElement(reader));
-        break;
-
-      case QXmlStreamReader::Characters:
-        content.append(reader.text().toLatin1());
-        break;
-
-      case QXmlStreamReader::EntityReference:
-        content.append(reader.name().toLatin1());
-        break;
+QImage ImageProvider::getImage (const QString &id, const QString &key, const QSize &requestedSize, qreal ratio) {
+  // 1. Memory cache.
+  {
+    QMutexLocker locker(&mCacheMutex);
+    const QImage *image = mCache.object(key);
+    if (image) {
+      ++mMemoryHitCount;
+      return *image;
     }
-
-  return reader.hasError() ? QByteArray() : content;
-}
-
-// -----------------------------------------------------------------------------
-
-const QString ImageProvider::ProviderId = "internal";
-
-ImageProvider::ImageProvider () : QQuickImageProvider(
-  QQmlImageProviderBase::Image,
-  QQmlImageProviderBase::ForceAsynchronousImageLoading
-) {}
-
-// -----------------------------------------------------------------------------
-
-QImage ImageProvider::requestImage (const QString &id, QSize *size, const QSize &requestedSize) {
-  const QString path = QStringLiteral(":%1").arg(id);
-//  qDebug() << QStringLiteral("Image `%1` requested with size: (%2, %3).")
-//    .arg(path).arg(requestedSize.width()).arg(requestedSize.height());
-
-  QElapsedTimer timer;
-  timer.start();
-
-  // 1. Read and update XML content.
-  *size = QSize();
-  QFile file(path);
-  if (Q_UNLIKELY(QFileInfo(file).size() > MaxImageSize)) {
-    qWarning() << QStringLiteral("Unable to open large file: `%1`.").arg(path);
-    return QImage();
   }
 
-  if (Q_UNLIKELY(!file.open(QIODevice::ReadOnly))) {
-    qWarning() << QStringLiteral("Unable to open file: `%1`.").arg(path);
-    return QImage();
+  // 2. Disk cache.
+  QImage image = loadFromDisk(key);
+  if (!image.isNull())
+    ++mDiskHitCount;
+  else {
+    // 3. Render.
+    TRACE_SPAN("ImageProvider::render");
+    QElapsedTimer timer;
+    timer.start();
+    image = IconRenderer::render(QStringLiteral(":%1").arg(id), requestedSize, ratio);
+    if (image.isNull())
+      return image;
+    ++mRenderCount;
+    mRenderTime += timer.nsecsElapsed();
+    saveToDisk(key, image);
   }
 
-  const QByteArray content = computeContent(file);
-  if (Q_UNLIKELY(!content.length())) {
-    qWarning() << QStringLiteral("Unable to parse file: `%1`.").arg(path);
-    return QImage();
+  {
+    QMutexLocker locker(&mCacheMutex);
+    mCache.insert(key, new QImage(image), image.byteCount());
   }
 
-  // 2. Build svg renderer.
-  QSvgRenderer renderer(content);
-  if (Q_UNLIKELY(!renderer.isValid())) {
-    qWarning() << QStringLiteral("Invalid svg file: `%1`.").arg(path);
-    return QImage();
-  }
+  return image;
+}
 
-  QSize askedSize = !requestedSize.isEmpty()
-    ? requestedSize
-    : renderer.defaultSize() * QGuiApplication::primaryScreen()->devicePixelRatio();
+// -----------------------------------------------------------------------------
 
-  // 3. Create image.
-  QImage image(askedSize, QImage::Format_ARGB32_Premultiplied);
-  if (Q_UNLIKELY(image.isNull())) {
-    qWarning() << QStringLiteral("Unable to create image from path: `%1`.")
-      .arg(path);
-    return QImage(); // Memory cannot be allocated.
-  }
-  image.fill(Qt::transparent);// Fill with transparent to set alpha channel
+static inline QString getDiskCacheFileName (const QString &key) {
+  return QString::fromLatin1(QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Sha1).toHex()) + ".png";
+}
 
-  *size = image.size();
+QImage ImageProvider::loadFromDisk (const QString &key) const {
+  if (mDiskCachePath.isEmpty())
+    return QImage();
 
-  // 4. Paint!
-  QPainter painter(&image);
-  renderer.render(&painter);
+  const QString path = QDir(mDiskCachePath).filePath(getDiskCacheFileName(key));
+  QImage image;
+  if (!QFileInfo::exists(path) || !image.load(path, "png"))
+    return QImage();
+  return image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+}
 
-//  qDebug() << QStringLiteral("Image `%1` loaded in %2 milliseconds.").arg(path).arg(timer.elapsed());
+// Written in a temporary file and renamed: a concurrent request never reads a partial file.
+void ImageProvider::saveToDisk (const QString &key, const QImage &image) const {
+  if (mDiskCachePath.isEmpty())
+    return;
 
-  return image;
+  QSaveFile file(QDir(mDiskCachePath).filePath(getDiskCacheFileName(key)));
+  if (!file.open(QIODevice::WriteOnly) || !image.save(&file, "png") || !file.commit())
+    qWarning() << QStringLiteral("Unable to save icon in cache: `%1`.").arg(file.fileName());
 }
 
-QPixmap ImageProvider::requestPixmap (const QString &id, QSize *size, const QSize &requestedSize) {
-  return QPixmap::fromImage(requestImage(id, size, requestedSize));
+// A folder by theme: the folders of the previous themes and versions are useless.
+void ImageProvider::removeOutdatedDiskCaches (const QString &rootPath) const {
+  QDir root(rootPath);
+  for (const QString &name : root.entryList(QDir::Dirs | QDir::NoDotAndDotDot))
+    if (name != mThemeHash && !QDir(root.filePath(name)).removeRecursively())
+      qWarning() << QStringLiteral("Unable to remove outdated icons cache: `%1`.").arg(name);
 }
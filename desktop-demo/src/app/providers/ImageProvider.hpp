@@ -21,20 +21,68 @@
 #ifndef IMAGE_PROVIDER_H_
 #define IMAGE_PROVIDER_H_
 
+#include <atomic>
+#include <memory>
+
+#include <QCache>
+#include <QMutex>
 #include <QQuickImageProvider>
 #include <QDebug>
 #include "components/other/colors/Colors.hpp"
 
 // =============================================================================
+// Provides the svg icons of the resources with the colors of the theme.
+// The icons of the atlas built with the application are served as is. The
+// other variants (id, size, device pixel ratio, theme) are rendered once:
+// the images are kept in a LRU cache, and optionally saved on disk in a
+// folder by theme, so the next launches don't parse the svg files.
+// =============================================================================
+
+namespace linphone {
+  class Config;
+}
 
-class ImageProvider : public QQuickImageProvider {
+class IconAtlas;
+
+class ImageProvider : public QQuickAsyncImageProvider {
 public:
   ImageProvider ();
+  ~ImageProvider ();
+
+  // Must be called before the first request. Enables the disk cache by default.
+  void useConfig (const std::shared_ptr<linphone::Config> &config);
+
+  // Loads `requestTexture` in the thread pool of the images.
+  QQuickImageResponse *requestImageResponse (const QString &id, const QSize &requestedSize) override;
 
+  QQuickTextureFactory *requestTexture (const QString &id, QSize *size, const QSize &requestedSize) override;
   QImage requestImage (const QString &id, QSize *size, const QSize &requestedSize) override;
   QPixmap requestPixmap (const QString &id, QSize *size, const QSize &requestedSize) override;
 
   static const QString ProviderId;
+
+private:
+  // From the caches, or rendered.
+  QImage getImage (const QString &id, const QString &key, const QSize &requestedSize, qreal ratio);
+
+  QImage loadFromDisk (const QString &key) const;
+  void saveToDisk (const QString &key, const QImage &image) const;
+  void removeOutdatedDiskCaches (const QString &rootPath) const;
+
+  QString mThemeHash;
+  QString mDiskCachePath; // Empty if the disk cache is disabled.
+  std::shared_ptr<IconAtlas> mAtlas; // Null if there is no atlas for this theme.
+
+  QMutex mCacheMutex;
+  QCache<QString, QImage> mCache; // Cost in bytes.
+
+  std::atomic<quint64> mRequestCount;
+  std::atomic<quint64> mAtlasHitCount;
+  std::atomic<quint64> mMemoryHitCount;
+  std::atomic<quint64> mDiskHitCount;
+  std::atomic<quint64> mRenderCount;
+  std::atomic<qint64> mRenderTime; // In nanoseconds.
+  std::atomic<quint64> mImageUploadCount;
 };
 
 #endif // IMAGE_PROVIDER_H_
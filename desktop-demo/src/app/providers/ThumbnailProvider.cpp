@@ -21,21 +21,18 @@
 #include "app/paths/Paths.hpp"
 #include "utils/Utils.hpp"
 
+#include "AsyncImageResponse.hpp"
+
 #include "ThumbnailProvider.hpp"
 
 // =============================================================================
 
 const QString ThumbnailProvider::ProviderId = "thumbnail";
 
-ThumbnailProvider::ThumbnailProvider () : QQuickImageProvider(
-  QQmlImageProviderBase::Image,
-  QQmlImageProviderBase::ForceAsynchronousImageLoading
-) {
+ThumbnailProvider::ThumbnailProvider (const std::shared_ptr<ImageFileCache> &cache) : mCache(cache) {
   mThumbnailsPath = Utils::coreStringToAppString(Paths::getThumbnailsDirPath());
 }
 
-QImage ThumbnailProvider::requestImage (const QString &id, QSize *size, const QSize &) {
-  QImage image(mThumbnailsPath + id);
-  *size = image.size();
-  return image;
+QQuickImageResponse *ThumbnailProvider::requestImageResponse (const QString &id, const QSize &requestedSize) {
+  return AsyncImageResponse::createForFile(mCache, mThumbnailsPath + id, requestedSize);
 }
@@ -21,19 +21,24 @@
 #ifndef THUMBNAIL_PROVIDER_H_
 #define THUMBNAIL_PROVIDER_H_
 
+#include <memory>
+
 #include <QQuickImageProvider>
 
 // =============================================================================
 
-class ThumbnailProvider : public QQuickImageProvider {
+class ImageFileCache;
+
+class ThumbnailProvider : public QQuickAsyncImageProvider {
 public:
-  ThumbnailProvider ();
+  ThumbnailProvider (const std::shared_ptr<ImageFileCache> &cache);
 
-  QImage requestImage (const QString &id, QSize *size, const QSize &requestedSize) override;
+  QQuickImageResponse *requestImageResponse (const QString &id, const QSize &requestedSize) override;
 
   static const QString ProviderId;
 
 private:
+  std::shared_ptr<ImageFileCache> mCache;
   QString mThumbnailsPath;
 };
 
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2010-2020 Belledonne Communications SARL.
+ *
+ * This file is part of linphone-desktop
+ * (see https://www.linphone.org).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <vector>
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QThread>
+
+#include "Tracer.hpp"
+
+// =============================================================================
+
+using namespace std;
+
+namespace {
+  struct Event {
+    const char *name;
+    char phase;
+    qint64 time;
+    qint64 duration; // Spans only.
+    qint64 value;    // Counters only.
+    quint64 threadId;
+  };
+
+  QMutex gMutex;
+  QElapsedTimer gTimer;
+  vector<Event> gEvents;
+
+  void addEvent (const char *name, char phase, qint64 time, qint64 duration, qint64 value) {
+    const Event event{
+      name, phase, time, duration, value,
+      quint64(reinterpret_cast<quintptr>(QThread::currentThreadId()))
+    };
+
+    QMutexLocker locker(&gMutex);
+    gEvents.push_back(event);
+  }
+}
+
+atomic<bool> Tracer::mEnabled { false };
+
+// -----------------------------------------------------------------------------
+
+void Tracer::start () {
+  QMutexLocker locker(&gMutex);
+  gEvents.clear();
+  gEvents.reserve(1024);
+  gTimer.start();
+  mEnabled = true;
+}
+
+void Tracer::stop () {
+  mEnabled = false;
+}
+
+qint64 Tracer::now () {
+  return gTimer.nsecsElapsed();
+}
+
+// -----------------------------------------------------------------------------
+
+void Tracer::addSpan (const char *name, qint64 start, qint64 duration) {
+  addEvent(name, 'X', start, duration, 0);
+}
+
+void Tracer::addCounter (const char *name, qint64 value) {
+  if (isEnabled())
+    addEvent(name, 'C', now(), 0, value);
+}
+
+void Tracer::addInstant (const char *name) {
+  if (isEnabled())
+    addEvent(name, 'i', now(), 0, 0);
+}
+
+// -----------------------------------------------------------------------------
+
+QByteArray Tracer::toJson () {
+  const qint64 pid = QCoreApplication::applicationPid();
+
+  QJsonArray events;
+  {
+    QMutexLocker locker(&gMutex);
+    for (const auto &event : gEvents) {
+      QJsonObject object;
+      object["name"] = QString::fromUtf8(event.name);
+      object["ph"] = QString(QChar(event.phase));
+      object["ts"] = double(event.time) / 1000.0; // In microseconds.
+      object["pid"] = double(pid);
+      object["tid"] = double(event.threadId);
+
+      switch (event.phase) {
+        case 'X':
+          object["dur"] = double(event.duration) / 1000.0;
+          break;
+        case 'C':
+          object["args"] = QJsonObject{ { "value", double(event.value) } };
+          break;
+        case 'i':
+          object["s"] = QStringLiteral("p");
+          break;
+      }
+
+      events.append(object);
+    }
+  }
+
+  return QJsonDocument(QJsonObject{
+    { "traceEvents", events },
+    { "displayTimeUnit", QStringLiteral("ms") }
+  }).toJson(QJsonDocument::Compact);
+}
+
+bool Tracer::save (const QString &filePath) {
+  QFile file(filePath);
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+    qWarning() << QStringLiteral("Unable to write trace: `%1`.").arg(filePath);
+    return false;
+  }
+
+  const QByteArray json = toJson();
+  if (file.write(json) != json.size() || !file.flush()) {
+    qWarning() << QStringLiteral("Unable to write trace: `%1` (%2).").arg(filePath).arg(file.errorString());
+    return false;
+  }
+  qInfo() << QStringLiteral("Trace written: `%1`.").arg(filePath);
+  return true;
+}
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2010-2020 Belledonne Communications SARL.
+ *
+ * This file is part of linphone-desktop
+ * (see https://www.linphone.org).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRACER_H_
+#define TRACER_H_
+
+#include <atomic>
+
+#include <QByteArray>
+#include <QString>
+
+// =============================================================================
+// Records named spans, counters and instant events, and exports them in the
+// Chrome trace event format (chrome://tracing, Perfetto).
+// Disabled by default. A disabled span costs an atomic load.
+// =============================================================================
+
+// Names must be string literals: only the pointers are stored.
+// Several spans can be declared in the same scope.
+#define TRACE_SPAN(NAME) const Tracer::Span TRACE_SPAN_VARIABLE(__LINE__)(NAME)
+#define TRACE_SPAN_VARIABLE(LINE) TRACE_SPAN_CONCAT(tracerSpan, LINE)
+#define TRACE_SPAN_CONCAT(A, B) A ## B
+
+class Tracer {
+public:
+  class Span {
+  public:
+    Span (const char *name) : mName(isEnabled() ? name : nullptr) {
+      if (mName)
+        mStart = now();
+    }
+
+    ~Span () {
+      if (mName)
+        addSpan(mName, mStart, now() - mStart);
+    }
+
+  private:
+    Span (const Span &) = delete;
+    Span &operator= (const Span &) = delete;
+
+    const char *mName;
+    qint64 mStart = 0;
+  };
+
+  // Clear the recorded events and start recording.
+  static void start ();
+  static void stop ();
+
+  static bool isEnabled () {
+    return mEnabled.load(std::memory_order_relaxed);
+  }
+
+  static void addCounter (const char *name, qint64 value);
+  static void addInstant (const char *name);
+
+  static QByteArray toJson ();
+  static bool save (const QString &filePath);
+
+private:
+  Tracer () = delete;
+
+  // Nanoseconds since `start`.
+  static qint64 now ();
+
+  static void addSpan (const char *name, qint64 start, qint64 duration);
+
+  static std::atomic<bool> mEnabled;
+};
+
+#endif // TRACER_H_
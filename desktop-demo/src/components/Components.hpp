@@ -24,10 +24,12 @@
 #include "assistant/AssistantModel.hpp"
 #include "authentication/AuthenticationNotifier.hpp"
 #include "call/CallModel.hpp"
+#include "call/CallStatsModel.hpp"
 #include "calls/CallsListModel.hpp"
 #include "calls/CallsListProxyModel.hpp"
 #include "camera/Camera.hpp"
 #include "camera/CameraPreview.hpp"
+#include "camera/SoftwareCamera.hpp"
 #include "chat/ChatProxyModel.hpp"
 #include "codecs/AudioCodecsModel.hpp"
 #include "codecs/VideoCodecsModel.hpp"
@@ -46,6 +48,7 @@
 #include "file/FileDownloader.hpp"
 #include "file/FileExtractor.hpp"
 #include "history/HistoryProxyModel.hpp"
+#include "history/HistoryStatsModel.hpp"
 #include "ldap/LdapModel.hpp"
 #include "ldap/LdapListModel.hpp"
 #include "ldap/LdapProxyModel.hpp"
@@ -25,14 +25,15 @@
 #include <QTimer>
 
 #include "app/App.hpp"
+#include "components/call/CallQualityRecorder.hpp"
 #include "components/calls/CallsListModel.hpp"
+#include "components/camera/VideoFrameClock.hpp"
 #include "components/core/CoreHandlers.hpp"
 #include "components/core/CoreManager.hpp"
 #include "components/notifier/Notifier.hpp"
 #include "components/settings/AccountSettingsModel.hpp"
 #include "components/settings/SettingsModel.hpp"
 #include "utils/LinphoneUtils.hpp"
-#include "utils/MediastreamerUtils.hpp"
 #include "utils/Utils.hpp"
 
 #include "linphone/api/c-search-result.h"
@@ -50,6 +51,12 @@ CallModel::CallModel (shared_ptr<linphone::Call> call){
     mCall = call;
     mCall->setData("call-model", *this);
 
+    mAudioStats = new CallStatsModel(linphone::StreamType::Audio, this);
+    mVideoStats = new CallStatsModel(linphone::StreamType::Video, this);
+    mQualityRecorder = new CallQualityRecorder(
+                Utils::coreStringToAppString(mCall->getRemoteAddress()->asStringUriOnly()), mAudioStats, mVideoStats, this
+                );
+
     updateIsInConference();
 
     CoreManager *coreManager = CoreManager::getInstance();
@@ -69,13 +76,14 @@ CallModel::CallModel (shared_ptr<linphone::Call> call){
         }
     }
 
-    CoreHandlers *coreHandlers = coreManager->getHandlers().get();
+    // Only the events of this call.
+    CallEvents *callEvents = coreManager->getHandlers()->getCallEvents(mCall, this);
     QObject::connect(
-                coreHandlers, &CoreHandlers::callStateChanged,
+                callEvents, &CallEvents::callStateChanged,
                 this, &CallModel::handleCallStateChanged
                 );
     QObject::connect(
-                coreHandlers, &CoreHandlers::callEncryptionChanged,
+                callEvents, &CallEvents::callEncryptionChanged,
                 this, &CallModel::handleCallEncryptionChanged
                 );
 
@@ -143,14 +151,14 @@ void CallModel::updateStats (const shared_ptr<const linphone::CallStats> &callSt
         break;
 
     case linphone::StreamType::Audio:
-        updateStats(callStats, mAudioStats);
+        mAudioStats->update(callStats, mCall->getCurrentParams());
         break;
-    case linphone::StreamType::Video:
-        updateStats(callStats, mVideoStats);
+    case linphone::StreamType::Video: {
+        const VideoFrameClock::Stats frameStats = CoreManager::getInstance()->getVideoFrameClock()->getCallStats(mCall.get());
+        mVideoStats->update(callStats, mCall->getCurrentParams(), &frameStats);
         break;
     }
-
-    emit statsUpdated();
+    }
 }
 
 // -----------------------------------------------------------------------------
@@ -244,7 +252,8 @@ void CallModel::takeSnapshot () {
 
     const QString filePath(CoreManager::getInstance()->getSettingsModel()->getSavedScreenshotsFolder().append(newName));
     mCall->takeVideoSnapshot(Utils::appStringToCoreString(filePath));
-    App::getInstance()->getNotifier()->notifySnapshotWasTaken(filePath);
+    if (Notifier *notifier = App::getInstance()->getNotifier())
+        notifier->notifySnapshotWasTaken(filePath);
 }
 
 void CallModel::startRecording () {
@@ -268,9 +277,10 @@ void CallModel::stopRecording () {
     mRecording = false;
     mCall->stopRecording();
 
-    App::getInstance()->getNotifier()->notifyRecordingCompleted(
-                Utils::coreStringToAppString(mCall->getParams()->getRecordFile())
-                );
+    if (Notifier *notifier = App::getInstance()->getNotifier())
+        notifier->notifyRecordingCompleted(
+                    Utils::coreStringToAppString(mCall->getParams()->getRecordFile())
+                    );
 
     emit recordingChanged(false);
 }
@@ -294,6 +304,7 @@ void CallModel::handleCallStateChanged (const shared_ptr<linphone::Call> &call,
         setCallErrorFromReason(call->getReason());
         stopAutoAnswerTimer();
         stopRecording();
+        mQualityRecorder->stop();
         mPausedByRemote = false;
         break;
 
@@ -302,6 +313,7 @@ void CallModel::handleCallStateChanged (const shared_ptr<linphone::Call> &call,
             startRecording();
             mWasConnected = true;
         }
+        mQualityRecorder->start();
         mPausedByRemote = false;
         break;
     }
@@ -487,16 +499,18 @@ float CallModel::getQuality () const {
 
 // -----------------------------------------------------------------------------
 
-float CallModel::getSpeakerVu () const {
-    if (mCall->getState() == linphone::Call::State::StreamsRunning)
-        return MediastreamerUtils::computeVu(mCall->getPlayVolume());
-    return 0.0;
-}
+void CallModel::setVu (float speakerVu, float speakerVuPeak, float microVu, float microVuPeak) {
+    if (
+            speakerVu == mSpeakerVu && speakerVuPeak == mSpeakerVuPeak &&
+            microVu == mMicroVu && microVuPeak == mMicroVuPeak
+            )
+        return;
 
-float CallModel::getMicroVu () const {
-    if (mCall->getState() == linphone::Call::State::StreamsRunning)
-        return MediastreamerUtils::computeVu(mCall->getRecordVolume());
-    return 0.0;
+    mSpeakerVu = speakerVu;
+    mSpeakerVuPeak = speakerVuPeak;
+    mMicroVu = microVu;
+    mMicroVuPeak = microVuPeak;
+    emit vuChanged();
 }
 
 // -----------------------------------------------------------------------------
@@ -698,119 +712,16 @@ QString CallModel::getSecuredString () const {
 
 // -----------------------------------------------------------------------------
 
-QVariantList CallModel::getAudioStats () const {
+CallStatsModel *CallModel::getAudioStats () const {
     return mAudioStats;
 }
 
-QVariantList CallModel::getVideoStats () const {
+CallStatsModel *CallModel::getVideoStats () const {
     return mVideoStats;
 }
 
 // -----------------------------------------------------------------------------
 
-static inline QVariantMap createStat (const QString &key, const QString &value) {
-    QVariantMap m;
-    m["key"] = key;
-    m["value"] = value;
-    return m;
-}
-
-void CallModel::updateStats (const shared_ptr<const linphone::CallStats> &callStats, QVariantList &statsList) {
-    shared_ptr<const linphone::CallParams> params = mCall->getCurrentParams();
-    shared_ptr<const linphone::PayloadType> payloadType;
-
-    switch (callStats->getType()) {
-    case linphone::StreamType::Audio:
-        payloadType = params->getUsedAudioPayloadType();
-        break;
-    case linphone::StreamType::Video:
-        payloadType = params->getUsedVideoPayloadType();
-        break;
-    default:
-        return;
-    }
-
-    QString family;
-    switch (callStats->getIpFamilyOfRemote()) {
-    case linphone::AddressFamily::Inet:
-        family = QStringLiteral("IPv4");
-        break;
-    case linphone::AddressFamily::Inet6:
-        family = QStringLiteral("IPv6");
-        break;
-    default:
-        family = QStringLiteral("Unknown");
-        break;
-    }
-
-    statsList.clear();
-
-    statsList << createStat(tr("callStatsCodec"), payloadType
-                            ? QStringLiteral("%1 / %2kHz").arg(Utils::coreStringToAppString(payloadType->getMimeType())).arg(payloadType->getClockRate() / 1000)
-                            : QString(""));
-    statsList << createStat(tr("callStatsUploadBandwidth"), QStringLiteral("%1 kbits/s").arg(int(callStats->getUploadBandwidth())));
-    statsList << createStat(tr("callStatsDownloadBandwidth"), QStringLiteral("%1 kbits/s").arg(int(callStats->getDownloadBandwidth())));
-    statsList << createStat(tr("callStatsIceState"), iceStateToString(callStats->getIceState()));
-    statsList << createStat(tr("callStatsIpFamily"), family);
-    statsList << createStat(tr("callStatsSenderLossRate"), QStringLiteral("%1 %").arg(static_cast<double>(callStats->getSenderLossRate())));
-    statsList << createStat(tr("callStatsReceiverLossRate"), QStringLiteral("%1 %").arg(static_cast<double>(callStats->getReceiverLossRate())));
-
-    switch (callStats->getType()) {
-    case linphone::StreamType::Audio:
-        statsList << createStat(tr("callStatsJitterBuffer"), QStringLiteral("%1 ms").arg(callStats->getJitterBufferSizeMs()));
-        break;
-    case linphone::StreamType::Video: {
-        statsList << createStat(tr("callStatsEstimatedDownloadBandwidth"), QStringLiteral("%1 kbits/s").arg(int(callStats->getEstimatedDownloadBandwidth())));
-        const QString sentVideoDefinitionName = Utils::coreStringToAppString(params->getSentVideoDefinition()->getName());
-        const QString sentVideoDefinition = QStringLiteral("%1x%2")
-                .arg(params->getSentVideoDefinition()->getWidth())
-                .arg(params->getSentVideoDefinition()->getHeight());
-
-        statsList << createStat(tr("callStatsSentVideoDefinition"), sentVideoDefinition == sentVideoDefinitionName
-                                ? sentVideoDefinition
-                                : QStringLiteral("%1 (%2)").arg(sentVideoDefinition).arg(sentVideoDefinitionName));
-
-        const QString receivedVideoDefinitionName = Utils::coreStringToAppString(params->getReceivedVideoDefinition()->getName());
-        const QString receivedVideoDefinition = QString("%1x%2")
-                .arg(params->getReceivedVideoDefinition()->getWidth())
-                .arg(params->getReceivedVideoDefinition()->getHeight());
-
-        statsList << createStat(tr("callStatsReceivedVideoDefinition"), receivedVideoDefinition == receivedVideoDefinitionName
-                                ? receivedVideoDefinition
-                                : QString("%1 (%2)").arg(receivedVideoDefinition).arg(receivedVideoDefinitionName));
-
-        statsList << createStat(tr("callStatsReceivedFramerate"), QStringLiteral("%1 FPS").arg(static_cast<double>(params->getReceivedFramerate())));
-        statsList << createStat(tr("callStatsSentFramerate"), QStringLiteral("%1 FPS").arg(static_cast<double>(params->getSentFramerate())));
-    } break;
-
-    default:
-        break;
-    }
-}
-
-// -----------------------------------------------------------------------------
-
-QString CallModel::iceStateToString (linphone::IceState state) const {
-    switch (state) {
-    case linphone::IceState::NotActivated:
-        return tr("iceStateNotActivated");
-    case linphone::IceState::Failed:
-        return tr("iceStateFailed");
-    case linphone::IceState::InProgress:
-        return tr("iceStateInProgress");
-    case linphone::IceState::ReflexiveConnection:
-        return tr("iceStateReflexiveConnection");
-    case linphone::IceState::HostConnection:
-        return tr("iceStateHostConnection");
-    case linphone::IceState::RelayConnection:
-        return tr("iceStateRelayConnection");
-    }
-
-    return tr("iceStateInvalid");
-}
-
-// -----------------------------------------------------------------------------
-
 QString CallModel::generateSavedFilename () const {
     const shared_ptr<linphone::CallLog> callLog(mCall->getCallLog());
     return generateSavedFilename(
@@ -25,9 +25,12 @@
 #include <QVariant>
 #include <linphone++/linphone.hh>
 #include "../search/SearchHandler.hpp"
+#include "CallStatsModel.hpp"
 
 // =============================================================================
 
+class CallQualityRecorder;
+
 class CallModel : public QObject {
   Q_OBJECT;
 
@@ -45,8 +48,10 @@ class CallModel : public QObject {
 
   Q_PROPERTY(int duration READ getDuration CONSTANT); // Constants but called with a timer in qml.
   Q_PROPERTY(float quality READ getQuality CONSTANT);
-  Q_PROPERTY(float speakerVu READ getSpeakerVu CONSTANT);
-  Q_PROPERTY(float microVu READ getMicroVu CONSTANT);
+  Q_PROPERTY(float speakerVu READ getSpeakerVu NOTIFY vuChanged);
+  Q_PROPERTY(float speakerVuPeak READ getSpeakerVuPeak NOTIFY vuChanged);
+  Q_PROPERTY(float microVu READ getMicroVu NOTIFY vuChanged);
+  Q_PROPERTY(float microVuPeak READ getMicroVuPeak NOTIFY vuChanged);
 
   Q_PROPERTY(bool speakerMuted READ getSpeakerMuted WRITE setSpeakerMuted NOTIFY speakerMutedChanged);
   Q_PROPERTY(bool microMuted READ getMicroMuted WRITE setMicroMuted NOTIFY microMutedChanged);
@@ -57,8 +62,8 @@ class CallModel : public QObject {
 
   Q_PROPERTY(bool recording READ getRecording NOTIFY recordingChanged);
 
-  Q_PROPERTY(QVariantList audioStats READ getAudioStats NOTIFY statsUpdated);
-  Q_PROPERTY(QVariantList videoStats READ getVideoStats NOTIFY statsUpdated);
+  Q_PROPERTY(CallStatsModel *audioStats READ getAudioStats CONSTANT);
+  Q_PROPERTY(CallStatsModel *videoStats READ getVideoStats CONSTANT);
 
   Q_PROPERTY(CallEncryption encryption READ getEncryption NOTIFY securityUpdated);
   Q_PROPERTY(bool isSecured READ isSecured NOTIFY securityUpdated);
@@ -111,6 +116,9 @@ public:
 
   void notifyCameraFirstFrameReceived (unsigned int width, unsigned int height);
 
+  // Called by the VuMeterSampler.
+  void setVu (float speakerVu, float speakerVuPeak, float microVu, float microVuPeak);
+
   Q_INVOKABLE void accept ();
   Q_INVOKABLE void acceptWithVideo ();
   Q_INVOKABLE void terminate ();
@@ -152,8 +160,8 @@ signals:
   void speakerMutedChanged (bool status);
   void microMutedChanged (bool status);
   void recordingChanged (bool status);
-  void statsUpdated ();
   void statusChanged (CallStatus status);
+  void vuChanged ();
   void videoRequested ();
   void securityUpdated ();
   void speakerVolumeGainChanged (float volume);
@@ -186,8 +194,21 @@ private:
 
   int getDuration () const;
   float getQuality () const;
-  float getMicroVu () const;
-  float getSpeakerVu () const;
+  float getMicroVu () const {
+    return mMicroVu;
+  }
+
+  float getMicroVuPeak () const {
+    return mMicroVuPeak;
+  }
+
+  float getSpeakerVu () const {
+    return mSpeakerVu;
+  }
+
+  float getSpeakerVuPeak () const {
+    return mSpeakerVuPeak;
+  }
 
   bool getSpeakerMuted () const;
   void setSpeakerMuted (bool status);
@@ -213,11 +234,8 @@ private:
 
   QString getSecuredString () const;
 
-  QVariantList getAudioStats () const;
-  QVariantList getVideoStats () const;
-  void updateStats (const std::shared_ptr<const linphone::CallStats> &callStats, QVariantList &statsList);
-
-  QString iceStateToString (linphone::IceState state) const;
+  CallStatsModel *getAudioStats () const;
+  CallStatsModel *getVideoStats () const;
 
   float getSpeakerVolumeGain () const;
   void setSpeakerVolumeGain (float volume);
@@ -241,8 +259,14 @@ private:
 
   QString mCallError;
 
-  QVariantList mAudioStats;
-  QVariantList mVideoStats;
+  float mSpeakerVu = 0.f;
+  float mSpeakerVuPeak = 0.f;
+  float mMicroVu = 0.f;
+  float mMicroVuPeak = 0.f;
+
+  CallStatsModel *mAudioStats = nullptr;
+  CallStatsModel *mVideoStats = nullptr;
+  CallQualityRecorder *mQualityRecorder = nullptr;
   std::shared_ptr<SearchHandler> mSearch;
 };
 
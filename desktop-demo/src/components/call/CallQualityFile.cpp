@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2010-2020 Belledonne Communications SARL.
+ *
+ * This file is part of linphone-desktop
+ * (see https://www.linphone.org).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstring>
+
+#include <QDir>
+#include <QSet>
+#include <QtDebug>
+
+#include "CallQualityFile.hpp"
+
+// =============================================================================
+
+namespace {
+  QSet<QString> &getWritingFiles () {
+    static QSet<QString> writingFiles; // Absolute paths.
+    return writingFiles;
+  }
+}
+
+CallQualityFile::~CallQualityFile () {
+  close();
+}
+
+// -----------------------------------------------------------------------------
+
+bool CallQualityFile::open (
+  const QString &filePath,
+  const QString &peerAddress,
+  qint64 startTime,
+  quint32 sampleInterval,
+  int maxRecordCount
+) {
+  close();
+
+  const qint64 maxFileSize = getMaxFileSize(maxRecordCount);
+  mFile.setFileName(filePath);
+  if (!mFile.open(QIODevice::ReadWrite | QIODevice::Truncate) || !mFile.resize(maxFileSize)) {
+    qWarning() << QStringLiteral("Unable to create call quality file: `%1` (%2).")
+      .arg(filePath).arg(mFile.errorString());
+    mFile.close();
+    return false;
+  }
+
+  uchar *data = mFile.map(0, maxFileSize);
+  if (!data) {
+    qWarning() << QStringLiteral("Unable to map call quality file: `%1` (%2).")
+      .arg(filePath).arg(mFile.errorString());
+    mFile.close();
+    mFile.remove();
+    return false;
+  }
+
+  mHeader = reinterpret_cast<CallQuality::FileHeader *>(data);
+  memset(mHeader, 0, sizeof *mHeader);
+  mHeader->magic = CallQuality::Magic;
+  mHeader->version = CallQuality::Version;
+  mHeader->recordSize = sizeof(CallQuality::Record);
+  mHeader->sampleInterval = sampleInterval;
+  mHeader->startTime = startTime;
+  const QByteArray address = peerAddress.toUtf8().left(int(sizeof mHeader->peerAddress) - 1);
+  memcpy(mHeader->peerAddress, address.constData(), size_t(address.size()));
+  mMaxRecordCount = maxRecordCount;
+
+  getWritingFiles().insert(QFileInfo(mFile).absoluteFilePath());
+  return true;
+}
+
+void CallQualityFile::close () {
+  if (!mHeader)
+    return;
+
+  const qint64 size = sizeof(CallQuality::FileHeader) + qint64(mHeader->recordCount) * sizeof(CallQuality::Record);
+  mFile.unmap(reinterpret_cast<uchar *>(mHeader));
+  mHeader = nullptr;
+  mFile.resize(size);
+  mFile.close();
+
+  getWritingFiles().remove(QFileInfo(mFile).absoluteFilePath());
+}
+
+// -----------------------------------------------------------------------------
+
+CallQuality::Record *CallQualityFile::beginRecord () {
+  if (!mHeader || mHeader->recordCount >= quint32(mMaxRecordCount))
+    return nullptr;
+
+  CallQuality::Record *record = reinterpret_cast<CallQuality::Record *>(
+    reinterpret_cast<uchar *>(mHeader) + sizeof(CallQuality::FileHeader)
+  ) + mHeader->recordCount;
+  memset(record, 0, sizeof *record);
+  return record;
+}
+
+void CallQualityFile::commitRecord () {
+  ++mHeader->recordCount;
+}
+
+// -----------------------------------------------------------------------------
+
+qint64 CallQualityFile::getMaxFileSize (int maxRecordCount) {
+  return sizeof(CallQuality::FileHeader) + qint64(maxRecordCount) * sizeof(CallQuality::Record);
+}
+
+bool CallQualityFile::isWriting (const QString &filePath) {
+  return getWritingFiles().contains(QFileInfo(filePath).absoluteFilePath());
+}
+
+void CallQualityFile::applyQuota (const QString &dirPath, qint64 quota, qint64 reservedSize) {
+  const QFileInfoList files = QDir(dirPath).entryInfoList(
+    { QStringLiteral("*.%1").arg(CallQuality::FileSuffix) }, QDir::Files, QDir::Time | QDir::Reversed
+  );
+
+  qint64 size = reservedSize;
+  for (const QFileInfo &file : files)
+    size += file.size();
+
+  // Remove the oldest files first.
+  for (const QFileInfo &file : files) {
+    if (size <= quota)
+      break;
+    if (isWriting(file.absoluteFilePath()))
+      continue; // Still mapped by another call.
+    if (QFile::remove(file.absoluteFilePath()))
+      size -= file.size();
+  }
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2010-2020 Belledonne Communications SARL.
+ *
+ * This file is part of linphone-desktop
+ * (see https://www.linphone.org).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CALL_QUALITY_FILE_H_
+#define CALL_QUALITY_FILE_H_
+
+#include <QFile>
+
+#include "CallQualityRecord.hpp"
+
+// =============================================================================
+// One memory-mapped call quality file, allocated once and truncated to the
+// used size on close. Free of core dependencies: used by the recorder and its
+// benchmark. Not thread safe.
+// =============================================================================
+
+class CallQualityFile {
+public:
+  CallQualityFile () = default;
+  ~CallQualityFile ();
+
+  bool open (
+    const QString &filePath,
+    const QString &peerAddress,
+    qint64 startTime,
+    quint32 sampleInterval,
+    int maxRecordCount
+  );
+  void close ();
+
+  bool isOpen () const {
+    return !!mHeader;
+  }
+
+  QString getFileName () const {
+    return mFile.fileName();
+  }
+
+  qint64 getStartTime () const {
+    return mHeader ? mHeader->startTime : 0;
+  }
+
+  // Zeroed record after the committed ones, null if the file is full.
+  CallQuality::Record *beginRecord ();
+  void commitRecord ();
+
+  static qint64 getMaxFileSize (int maxRecordCount);
+
+  // True if the file is opened by a `CallQualityFile` of this process.
+  static bool isWriting (const QString &filePath);
+
+  // Remove the oldest files of `dirPath` until `reservedSize` more bytes fit in the quota.
+  // Files that are still written are never removed.
+  static void applyQuota (const QString &dirPath, qint64 quota, qint64 reservedSize);
+
+private:
+  Q_DISABLE_COPY(CallQualityFile);
+
+  QFile mFile;
+  CallQuality::FileHeader *mHeader = nullptr; // Mapped file.
+  int mMaxRecordCount = 0;
+};
+
+#endif // CALL_QUALITY_FILE_H_
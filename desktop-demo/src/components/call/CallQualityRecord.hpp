@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2010-2020 Belledonne Communications SARL.
+ *
+ * This file is part of linphone-desktop
+ * (see https://www.linphone.org).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CALL_QUALITY_RECORD_H_
+#define CALL_QUALITY_RECORD_H_
+
+#include <QtGlobal>
+
+// =============================================================================
+// Binary layout of the call quality files: one header followed by fixed-size
+// records. Shared with the offline analyzer, keep it free of app dependencies.
+// =============================================================================
+
+namespace CallQuality {
+  constexpr quint32 Magic = 0x43515231; // "CQR1".
+  constexpr quint16 Version = 1;
+  constexpr char FileSuffix[] = "cqr";
+
+  enum RecordFlag : quint32 {
+    HasAudio = 0x1,
+    HasVideo = 0x2
+  };
+
+  struct FileHeader {
+    quint32 magic;
+    quint16 version;
+    quint16 recordSize;
+    quint32 recordCount; // Written after each record, only committed records are valid.
+    quint32 sampleInterval; // In milliseconds.
+    qint64 startTime; // In milliseconds since epoch.
+    char peerAddress[232]; // Null-terminated, may be truncated.
+  };
+
+  struct Record {
+    quint32 time; // In milliseconds since the start time.
+    quint32 flags;
+
+    float audioUploadBandwidth; // In kbits/s.
+    float audioDownloadBandwidth; // In kbits/s.
+    float audioSenderLossRate; // In %.
+    float audioReceiverLossRate; // In %.
+    float audioRoundTripDelay; // In seconds.
+    float audioJitterBuffer; // In ms.
+
+    float videoUploadBandwidth; // In kbits/s.
+    float videoDownloadBandwidth; // In kbits/s.
+    float videoSenderLossRate; // In %.
+    float videoReceiverLossRate; // In %.
+    float videoRoundTripDelay; // In seconds.
+    float videoReceivedFramerate;
+    float videoSentFramerate;
+  };
+
+  Q_STATIC_ASSERT(sizeof(FileHeader) == 256);
+  Q_STATIC_ASSERT(sizeof(Record) == 60);
+}
+
+#endif // CALL_QUALITY_RECORD_H_
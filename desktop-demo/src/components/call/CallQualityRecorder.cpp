@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2010-2020 Belledonne Communications SARL.
+ *
+ * This file is part of linphone-desktop
+ * (see https://www.linphone.org).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QDateTime>
+#include <QDir>
+#include <QRegularExpression>
+#include <QTimer>
+#include <QtDebug>
+
+#include "app/paths/Paths.hpp"
+#include "components/core/CoreManager.hpp"
+#include "components/settings/SettingsModel.hpp"
+#include "utils/Utils.hpp"
+
+#include "CallStatsModel.hpp"
+
+#include "CallQualityRecorder.hpp"
+
+// =============================================================================
+
+using namespace std;
+
+CallQualityRecorder::CallQualityRecorder (
+  const QString &peerAddress,
+  const CallStatsModel *audioStats,
+  const CallStatsModel *videoStats,
+  QObject *parent
+) : QObject(parent), mPeerAddress(peerAddress), mAudioStats(audioStats), mVideoStats(videoStats) {
+  mTimer = new QTimer(this);
+  mTimer->setInterval(SampleInterval);
+  mTimer->setTimerType(Qt::CoarseTimer);
+  QObject::connect(mTimer, &QTimer::timeout, this, &CallQualityRecorder::handleTimeout);
+}
+
+CallQualityRecorder::~CallQualityRecorder () {
+  stop();
+}
+
+// -----------------------------------------------------------------------------
+
+void CallQualityRecorder::start () {
+  SettingsModel *settingsModel = CoreManager::getInstance()->getSettingsModel();
+  if (mFile.isOpen() || !settingsModel->getCallQualityRecordingEnabled())
+    return;
+
+  const QString dirPath = Utils::coreStringToAppString(Paths::getCallQualityDirPath());
+  CallQualityFile::applyQuota(
+    dirPath, settingsModel->getCallQualityRecordingQuota(), CallQualityFile::getMaxFileSize(MaxRecordCount)
+  );
+
+  const QDateTime now = QDateTime::currentDateTime();
+  QString peer = mPeerAddress;
+  peer.replace(QRegularExpression("[^A-Za-z0-9@._-]"), "_");
+  const QString filePath = QDir(dirPath).filePath(
+    QStringLiteral("%1_%2.%3").arg(now.toString("yyyy-MM-dd_hh-mm-ss")).arg(peer).arg(CallQuality::FileSuffix)
+  );
+
+  if (mFile.open(filePath, mPeerAddress, now.toMSecsSinceEpoch(), SampleInterval, MaxRecordCount))
+    mTimer->start();
+}
+
+void CallQualityRecorder::stop () {
+  mTimer->stop();
+  mFile.close();
+}
+
+// -----------------------------------------------------------------------------
+
+void CallQualityRecorder::handleTimeout () {
+  CallQuality::Record *record = mFile.beginRecord();
+  if (!record) {
+    qInfo() << QStringLiteral("Call quality file is full: `%1`.").arg(mFile.getFileName());
+    stop();
+    return;
+  }
+
+  record->time = quint32(QDateTime::currentMSecsSinceEpoch() - mFile.getStartTime());
+
+  const CallStatsModel::Sample *sample = mAudioStats->getLastSample();
+  if (sample) {
+    record->flags |= CallQuality::HasAudio;
+    record->audioUploadBandwidth = sample->uploadBandwidth;
+    record->audioDownloadBandwidth = sample->downloadBandwidth;
+    record->audioSenderLossRate = sample->senderLossRate;
+    record->audioReceiverLossRate = sample->receiverLossRate;
+    record->audioRoundTripDelay = sample->roundTripDelay;
+    record->audioJitterBuffer = sample->jitterBuffer;
+  }
+
+  sample = mVideoStats->getLastSample();
+  if (sample) {
+    record->flags |= CallQuality::HasVideo;
+    record->videoUploadBandwidth = sample->uploadBandwidth;
+    record->videoDownloadBandwidth = sample->downloadBandwidth;
+    record->videoSenderLossRate = sample->senderLossRate;
+    record->videoReceiverLossRate = sample->receiverLossRate;
+    record->videoRoundTripDelay = sample->roundTripDelay;
+    record->videoReceivedFramerate = sample->receivedFramerate;
+    record->videoSentFramerate = sample->sentFramerate;
+  }
+
+  mFile.commitRecord();
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2010-2020 Belledonne Communications SARL.
+ *
+ * This file is part of linphone-desktop
+ * (see https://www.linphone.org).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CALL_QUALITY_RECORDER_H_
+#define CALL_QUALITY_RECORDER_H_
+
+#include <QObject>
+
+#include "CallQualityFile.hpp"
+
+// =============================================================================
+// Append the stats of a call to a memory-mapped file at a fixed rate.
+// The size of all files is bounded by a quota, the oldest files are removed.
+// =============================================================================
+
+class CallStatsModel;
+class QTimer;
+
+class CallQualityRecorder : public QObject {
+  Q_OBJECT;
+
+public:
+  static constexpr int SampleInterval = 1000; // In milliseconds.
+  static constexpr int MaxRecordCount = 4 * 60 * 60; // 4 hours by file.
+
+  CallQualityRecorder (
+    const QString &peerAddress,
+    const CallStatsModel *audioStats,
+    const CallStatsModel *videoStats,
+    QObject *parent = Q_NULLPTR
+  );
+  ~CallQualityRecorder ();
+
+  void start ();
+  void stop ();
+
+  bool isRecording () const {
+    return mFile.isOpen();
+  }
+
+private:
+  void handleTimeout ();
+
+  QString mPeerAddress;
+  const CallStatsModel *mAudioStats = nullptr;
+  const CallStatsModel *mVideoStats = nullptr;
+
+  QTimer *mTimer = nullptr;
+
+  CallQualityFile mFile;
+};
+
+#endif // CALL_QUALITY_RECORDER_H_
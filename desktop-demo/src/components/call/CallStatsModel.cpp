@@ -0,0 +1,346 @@
+/*
+ * Copyright (c) 2010-2020 Belledonne Communications SARL.
+ *
+ * This file is part of linphone-desktop
+ * (see https://www.linphone.org).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <iterator>
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QtDebug>
+
+#include "utils/Utils.hpp"
+
+#include "CallStatsModel.hpp"
+
+// =============================================================================
+
+using namespace std;
+
+namespace {
+  // Translated once by model, in the `CallModel` context.
+  constexpr const char *StatKeys[CallStatsModel::StatCount] = {
+    QT_TRANSLATE_NOOP("CallModel", "callStatsCodec"),
+    QT_TRANSLATE_NOOP("CallModel", "callStatsUploadBandwidth"),
+    QT_TRANSLATE_NOOP("CallModel", "callStatsDownloadBandwidth"),
+    QT_TRANSLATE_NOOP("CallModel", "callStatsIceState"),
+    QT_TRANSLATE_NOOP("CallModel", "callStatsIpFamily"),
+    QT_TRANSLATE_NOOP("CallModel", "callStatsSenderLossRate"),
+    QT_TRANSLATE_NOOP("CallModel", "callStatsReceiverLossRate"),
+    nullptr,
+    QT_TRANSLATE_NOOP("CallModel", "callStatsJitterBuffer"),
+    QT_TRANSLATE_NOOP("CallModel", "callStatsEstimatedDownloadBandwidth"),
+    QT_TRANSLATE_NOOP("CallModel", "callStatsSentVideoDefinition"),
+    QT_TRANSLATE_NOOP("CallModel", "callStatsReceivedVideoDefinition"),
+    QT_TRANSLATE_NOOP("CallModel", "callStatsReceivedFramerate"),
+    QT_TRANSLATE_NOOP("CallModel", "callStatsSentFramerate"),
+    QT_TRANSLATE_NOOP("CallModel", "callStatsRenderedFramerate"),
+    QT_TRANSLATE_NOOP("CallModel", "callStatsSkippedFramerate"),
+    QT_TRANSLATE_NOOP("CallModel", "callStatsRenderTime")
+  };
+}
+
+static inline QString translate (const char *key) {
+  return QCoreApplication::translate("CallModel", key);
+}
+
+static inline QString getVideoDefinition (const shared_ptr<const linphone::VideoDefinition> &videoDefinition) {
+  const QString name = Utils::coreStringToAppString(videoDefinition->getName());
+  const QString definition = QStringLiteral("%1x%2")
+    .arg(videoDefinition->getWidth())
+    .arg(videoDefinition->getHeight());
+
+  return definition == name ? definition : QStringLiteral("%1 (%2)").arg(definition).arg(name);
+}
+
+template<typename T>
+static inline bool isChanged (
+  const CallStatsModel::Sample *previous,
+  const CallStatsModel::Sample &sample,
+  T CallStatsModel::Sample::*field
+) {
+  return !previous || sample.*field != previous->*field;
+}
+
+// -----------------------------------------------------------------------------
+
+CallStatsModel::CallStatsModel (linphone::StreamType type, QObject *parent) : QAbstractListModel(parent) {
+  switch (type) {
+    case linphone::StreamType::Audio:
+      mStats << Codec << UploadBandwidth << DownloadBandwidth << IceState << IpFamily
+        << SenderLossRate << ReceiverLossRate << JitterBuffer;
+      break;
+    case linphone::StreamType::Video:
+      mStats << Codec << UploadBandwidth << DownloadBandwidth << IceState << IpFamily
+        << SenderLossRate << ReceiverLossRate << EstimatedDownloadBandwidth
+        << SentVideoDefinition << ReceivedVideoDefinition << ReceivedFramerate << SentFramerate
+        << RenderedFramerate << SkippedFramerate << RenderTime;
+      break;
+    default:
+      break;
+  }
+
+  fill(begin(mRows), end(mRows), -1);
+  for (int row = 0; row < mStats.count(); ++row) {
+    const Stat stat = mStats[row];
+    mRows[stat] = row;
+    mKeys << translate(StatKeys[stat]);
+  }
+  mValues.resize(mStats.count());
+}
+
+int CallStatsModel::rowCount (const QModelIndex &) const {
+  return mStats.count();
+}
+
+QHash<int, QByteArray> CallStatsModel::roleNames () const {
+  QHash<int, QByteArray> roles;
+  roles[KeyRole] = "key";
+  roles[ValueRole] = "value";
+  return roles;
+}
+
+QVariant CallStatsModel::data (const QModelIndex &index, int role) const {
+  int row = index.row();
+
+  if (!index.isValid() || row < 0 || row >= mStats.count())
+    return QVariant();
+
+  if (role == KeyRole)
+    return mKeys[row];
+  if (role == ValueRole)
+    return mValues[row];
+
+  return QVariant();
+}
+
+// -----------------------------------------------------------------------------
+
+void CallStatsModel::update (
+  const shared_ptr<const linphone::CallStats> &callStats,
+  const shared_ptr<const linphone::CallParams> &params,
+  const VideoFrameClock::Stats *frameStats
+) {
+  const linphone::StreamType type = callStats->getType();
+  shared_ptr<const linphone::PayloadType> payloadType;
+  switch (type) {
+    case linphone::StreamType::Audio:
+      payloadType = params->getUsedAudioPayloadType();
+      break;
+    case linphone::StreamType::Video:
+      payloadType = params->getUsedVideoPayloadType();
+      break;
+    default:
+      return;
+  }
+
+  // 1. Push a new sample.
+  const Sample *previous = getLastSample();
+
+  Sample &sample = mSamples[mSamplesHead];
+
+  sample.timestamp = QDateTime::currentMSecsSinceEpoch();
+  sample.uploadBandwidth = callStats->getUploadBandwidth();
+  sample.downloadBandwidth = callStats->getDownloadBandwidth();
+  sample.senderLossRate = callStats->getSenderLossRate();
+  sample.receiverLossRate = callStats->getReceiverLossRate();
+  sample.roundTripDelay = callStats->getRoundTripDelay();
+  if (type == linphone::StreamType::Audio) {
+    sample.jitterBuffer = callStats->getJitterBufferSizeMs();
+    sample.estimatedDownloadBandwidth = 0;
+    sample.receivedFramerate = 0;
+    sample.sentFramerate = 0;
+    sample.renderedFramerate = 0;
+    sample.skippedFramerate = 0;
+    sample.renderTime = -1;
+  } else {
+    sample.jitterBuffer = 0;
+    sample.estimatedDownloadBandwidth = callStats->getEstimatedDownloadBandwidth();
+    sample.receivedFramerate = params->getReceivedFramerate();
+    sample.sentFramerate = params->getSentFramerate();
+
+    // Rates since the previous sample. The counters restart if the items change.
+    const VideoFrameClock::Stats current = frameStats ? *frameStats : VideoFrameClock::Stats();
+    const VideoFrameClock::Stats &last = mFrameStats;
+    const qint64 elapsed = previous ? sample.timestamp - previous->timestamp : 0;
+    if (elapsed > 0 && current.renderedCount >= last.renderedCount && current.skippedCount >= last.skippedCount) {
+      sample.renderedFramerate = float(current.renderedCount - last.renderedCount) * 1000 / elapsed;
+      sample.skippedFramerate = float(current.skippedCount - last.skippedCount) * 1000 / elapsed;
+    } else {
+      sample.renderedFramerate = 0;
+      sample.skippedFramerate = 0;
+    }
+    sample.renderTime = current.timedRenderCount > last.timedRenderCount
+      ? float(current.renderTime - last.renderTime) / (current.timedRenderCount - last.timedRenderCount) / 1e6f
+      : -1;
+    mFrameStats = current;
+  }
+
+  mSamplesHead = (mSamplesHead + 1) % SampleCapacity;
+  if (mSamplesCount < SampleCapacity)
+    ++mSamplesCount;
+
+  // 2. Format only the changed values.
+  setValue(Codec, payloadType
+    ? QStringLiteral("%1 / %2kHz").arg(Utils::coreStringToAppString(payloadType->getMimeType())).arg(payloadType->getClockRate() / 1000)
+    : QString(""));
+
+  if (isChanged(previous, sample, &Sample::uploadBandwidth))
+    setValue(UploadBandwidth, QStringLiteral("%1 kbits/s").arg(int(sample.uploadBandwidth)));
+  if (isChanged(previous, sample, &Sample::downloadBandwidth))
+    setValue(DownloadBandwidth, QStringLiteral("%1 kbits/s").arg(int(sample.downloadBandwidth)));
+
+  const linphone::IceState iceState = callStats->getIceState();
+  if (!mIceStateSet || iceState != mIceState) {// Translated only when it changes.
+    mIceState = iceState;
+    mIceStateSet = true;
+    setValue(IceState, iceStateToString(iceState));
+  }
+
+  switch (callStats->getIpFamilyOfRemote()) {
+    case linphone::AddressFamily::Inet:
+      setValue(IpFamily, QStringLiteral("IPv4"));
+      break;
+    case linphone::AddressFamily::Inet6:
+      setValue(IpFamily, QStringLiteral("IPv6"));
+      break;
+    default:
+      setValue(IpFamily, QStringLiteral("Unknown"));
+      break;
+  }
+
+  if (isChanged(previous, sample, &Sample::senderLossRate))
+    setValue(SenderLossRate, QStringLiteral("%1 %").arg(static_cast<double>(sample.senderLossRate)));
+  if (isChanged(previous, sample, &Sample::receiverLossRate))
+    setValue(ReceiverLossRate, QStringLiteral("%1 %").arg(static_cast<double>(sample.receiverLossRate)));
+
+  if (type == linphone::StreamType::Audio) {
+    if (isChanged(previous, sample, &Sample::jitterBuffer))
+      setValue(JitterBuffer, QStringLiteral("%1 ms").arg(sample.jitterBuffer));
+    return;
+  }
+
+  if (isChanged(previous, sample, &Sample::estimatedDownloadBandwidth))
+    setValue(EstimatedDownloadBandwidth, QStringLiteral("%1 kbits/s").arg(int(sample.estimatedDownloadBandwidth)));
+  setValue(SentVideoDefinition, getVideoDefinition(params->getSentVideoDefinition()));
+  setValue(ReceivedVideoDefinition, getVideoDefinition(params->getReceivedVideoDefinition()));
+  if (isChanged(previous, sample, &Sample::receivedFramerate))
+    setValue(ReceivedFramerate, QStringLiteral("%1 FPS").arg(static_cast<double>(sample.receivedFramerate)));
+  if (isChanged(previous, sample, &Sample::sentFramerate))
+    setValue(SentFramerate, QStringLiteral("%1 FPS").arg(static_cast<double>(sample.sentFramerate)));
+  if (isChanged(previous, sample, &Sample::renderedFramerate))
+    setValue(RenderedFramerate, QStringLiteral("%1 FPS").arg(static_cast<double>(sample.renderedFramerate), 0, 'f', 1));
+  if (isChanged(previous, sample, &Sample::skippedFramerate))
+    setValue(SkippedFramerate, QStringLiteral("%1 FPS").arg(static_cast<double>(sample.skippedFramerate), 0, 'f', 1));
+  if (isChanged(previous, sample, &Sample::renderTime))
+    setValue(RenderTime, sample.renderTime < 0
+      ? QStringLiteral("-")
+      : QStringLiteral("%1 ms").arg(static_cast<double>(sample.renderTime), 0, 'f', 2));
+}
+
+// -----------------------------------------------------------------------------
+
+QVariantList CallStatsModel::getHistory (Stat stat) const {
+  QVariantList history;
+  history.reserve(mSamplesCount);
+
+  for (int i = 0; i < mSamplesCount; ++i) {
+    const Sample &sample = mSamples[(mSamplesHead - mSamplesCount + i + SampleCapacity) % SampleCapacity];
+    switch (stat) {
+      case UploadBandwidth:
+        history << sample.uploadBandwidth;
+        break;
+      case DownloadBandwidth:
+        history << sample.downloadBandwidth;
+        break;
+      case SenderLossRate:
+        history << sample.senderLossRate;
+        break;
+      case ReceiverLossRate:
+        history << sample.receiverLossRate;
+        break;
+      case RoundTripDelay:
+        history << sample.roundTripDelay;
+        break;
+      case JitterBuffer:
+        history << sample.jitterBuffer;
+        break;
+      case EstimatedDownloadBandwidth:
+        history << sample.estimatedDownloadBandwidth;
+        break;
+      case ReceivedFramerate:
+        history << sample.receivedFramerate;
+        break;
+      case SentFramerate:
+        history << sample.sentFramerate;
+        break;
+      case RenderedFramerate:
+        history << sample.renderedFramerate;
+        break;
+      case SkippedFramerate:
+        history << sample.skippedFramerate;
+        break;
+      case RenderTime:
+        history << sample.renderTime;
+        break;
+      default:
+        qWarning() << QStringLiteral("No history for stat: `%1`.").arg(stat);
+        return QVariantList();
+    }
+  }
+
+  return history;
+}
+
+const CallStatsModel::Sample *CallStatsModel::getLastSample () const {
+  return mSamplesCount
+    ? &mSamples[(mSamplesHead - 1 + SampleCapacity) % SampleCapacity]
+    : nullptr;
+}
+
+// -----------------------------------------------------------------------------
+
+void CallStatsModel::setValue (Stat stat, const QString &value) {
+  const int row = mRows[stat];
+  if (row == -1 || mValues[row] == value)
+    return;
+
+  mValues[row] = value;
+  const QModelIndex index = this->index(row);
+  emit dataChanged(index, index, { ValueRole });
+}
+
+QString CallStatsModel::iceStateToString (linphone::IceState state) {
+  switch (state) {
+    case linphone::IceState::NotActivated:
+      return translate(QT_TRANSLATE_NOOP("CallModel", "iceStateNotActivated"));
+    case linphone::IceState::Failed:
+      return translate(QT_TRANSLATE_NOOP("CallModel", "iceStateFailed"));
+    case linphone::IceState::InProgress:
+      return translate(QT_TRANSLATE_NOOP("CallModel", "iceStateInProgress"));
+    case linphone::IceState::ReflexiveConnection:
+      return translate(QT_TRANSLATE_NOOP("CallModel", "iceStateReflexiveConnection"));
+    case linphone::IceState::HostConnection:
+      return translate(QT_TRANSLATE_NOOP("CallModel", "iceStateHostConnection"));
+    case linphone::IceState::RelayConnection:
+      return translate(QT_TRANSLATE_NOOP("CallModel", "iceStateRelayConnection"));
+  }
+
+  return translate(QT_TRANSLATE_NOOP("CallModel", "iceStateInvalid"));
+}
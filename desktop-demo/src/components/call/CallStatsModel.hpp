@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2010-2020 Belledonne Communications SARL.
+ *
+ * This file is part of linphone-desktop
+ * (see https://www.linphone.org).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CALL_STATS_MODEL_H_
+#define CALL_STATS_MODEL_H_
+
+#include <memory>
+
+#include <QAbstractListModel>
+#include <QVector>
+#include <linphone++/linphone.hh>
+
+#include "components/camera/VideoFrameClock.hpp"
+
+// =============================================================================
+// Statistics of one stream of a call. Only the rows whose value has changed
+// are notified on update. The last samples are kept in a fixed-size ring.
+// =============================================================================
+
+class CallStatsModel : public QAbstractListModel {
+  Q_OBJECT;
+
+public:
+  enum Roles {
+    KeyRole = Qt::UserRole,
+    ValueRole
+  };
+
+  enum Stat {
+    Codec,
+    UploadBandwidth,
+    DownloadBandwidth,
+    IceState,
+    IpFamily,
+    SenderLossRate,
+    ReceiverLossRate,
+    RoundTripDelay, // Not displayed, history only.
+
+    // Audio.
+    JitterBuffer,
+
+    // Video.
+    EstimatedDownloadBandwidth,
+    SentVideoDefinition,
+    ReceivedVideoDefinition,
+    ReceivedFramerate, // Decoded by the core.
+    SentFramerate,
+    RenderedFramerate, // Drawn by the video items of the call.
+    SkippedFramerate,
+    RenderTime,
+
+    StatCount
+  };
+  Q_ENUM(Stat);
+
+  struct Sample {
+    qint64 timestamp = 0; // In milliseconds since epoch.
+    float uploadBandwidth = 0; // In kbits/s.
+    float downloadBandwidth = 0; // In kbits/s.
+    float estimatedDownloadBandwidth = 0; // In kbits/s.
+    float senderLossRate = 0; // In %.
+    float receiverLossRate = 0; // In %.
+    float roundTripDelay = 0; // In seconds.
+    int jitterBuffer = 0; // In ms.
+    float receivedFramerate = 0;
+    float sentFramerate = 0;
+    float renderedFramerate = 0;
+    float skippedFramerate = 0;
+    float renderTime = -1; // In ms, -1 if not measured.
+  };
+
+  static constexpr int SampleCapacity = 120;
+
+  CallStatsModel (linphone::StreamType type, QObject *parent = Q_NULLPTR);
+
+  int rowCount (const QModelIndex &index = QModelIndex()) const override;
+
+  QHash<int, QByteArray> roleNames () const override;
+  QVariant data (const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+  // `frameStats` are the counters of the video items since the call start.
+  void update (
+    const std::shared_ptr<const linphone::CallStats> &callStats,
+    const std::shared_ptr<const linphone::CallParams> &params,
+    const VideoFrameClock::Stats *frameStats = nullptr
+  );
+
+  // Last samples of a numeric stat, from the oldest to the newest.
+  Q_INVOKABLE QVariantList getHistory (Stat stat) const;
+
+  const Sample *getLastSample () const;
+
+private:
+  void setValue (Stat stat, const QString &value);
+
+  static QString iceStateToString (linphone::IceState state);
+
+  QVector<Stat> mStats; // Displayed stats, one by row.
+  int mRows[StatCount]; // Row of each stat, -1 if not displayed.
+
+  QVector<QString> mKeys;
+  QVector<QString> mValues;
+
+  VideoFrameClock::Stats mFrameStats; // Of the last sample.
+
+  linphone::IceState mIceState = linphone::IceState::NotActivated; // Of the last sample.
+  bool mIceStateSet = false;
+
+  Sample mSamples[SampleCapacity];
+  int mSamplesHead = 0;
+  int mSamplesCount = 0;
+};
+
+#endif // CALL_STATS_MODEL_H_
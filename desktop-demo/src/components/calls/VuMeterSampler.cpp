@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2010-2020 Belledonne Communications SARL.
+ *
+ * This file is part of linphone-desktop
+ * (see https://www.linphone.org).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cmath>
+
+#include <QTimer>
+
+#include "components/call/CallModel.hpp"
+#include "components/core/CoreHandlers.hpp"
+#include "components/core/CoreManager.hpp"
+#include "components/settings/SettingsModel.hpp"
+#include "utils/MediastreamerUtils.hpp"
+
+#include "VuMeterSampler.hpp"
+
+// =============================================================================
+
+using namespace std;
+
+namespace {
+  constexpr float RmsWindow = 300.f; // In milliseconds.
+  constexpr float PeakDecayTime = 1500.f; // Time to fall from 1 to 0, in milliseconds.
+}
+
+void VuMeterSampler::Level::update (float vu, float alpha, float decay) {
+  meanSquare += alpha * (vu * vu - meanSquare);
+  rms = sqrt(meanSquare);
+  peak = qMax(vu, peak - decay);
+}
+
+// -----------------------------------------------------------------------------
+
+VuMeterSampler::VuMeterSampler (QObject *parent) : QObject(parent) {
+  mTimer = new QTimer(this);
+  mTimer->setTimerType(Qt::PreciseTimer);
+  QObject::connect(mTimer, &QTimer::timeout, this, &VuMeterSampler::handleTimeout);
+
+  QObject::connect(
+    CoreManager::getInstance()->getHandlers().get(), &CoreHandlers::callStateChanged,
+    this, &VuMeterSampler::handleCallStateChanged
+  );
+}
+
+// -----------------------------------------------------------------------------
+
+void VuMeterSampler::handleCallStateChanged (const shared_ptr<linphone::Call> &, linphone::Call::State state) {
+  if (state != linphone::Call::State::StreamsRunning || mTimer->isActive())
+    return;
+
+  mTimer->start(1000 / CoreManager::getInstance()->getSettingsModel()->getVuMeterRate());
+}
+
+void VuMeterSampler::handleTimeout () {
+  const float interval = mTimer->interval();
+  const float alpha = 1.f - exp(-interval / RmsWindow);
+  const float decay = interval / PeakDecayTime;
+
+  ++mTickCount;
+  bool running = false;
+
+  shared_ptr<linphone::Core> core = CoreManager::getInstance()->getCore();
+  for (const auto &call : core->getCalls()) {
+    if (!call->dataExists("call-model"))
+      continue;
+
+    CallModel *callModel = &call->getData<CallModel>("call-model");
+    if (call->getState() != linphone::Call::State::StreamsRunning) {
+      mCallLevels.remove(callModel);
+      callModel->setVu(0.f, 0.f, 0.f, 0.f);
+      continue;
+    }
+
+    running = true;
+    CallLevels &levels = mCallLevels[callModel];
+    levels.speaker.update(MediastreamerUtils::computeVu(call->getPlayVolume()), alpha, decay);
+    levels.micro.update(MediastreamerUtils::computeVu(call->getRecordVolume()), alpha, decay);
+    levels.tick = mTickCount;
+    callModel->setVu(levels.speaker.rms, levels.speaker.peak, levels.micro.rms, levels.micro.peak);
+  }
+
+  // Remove the levels of terminated calls.
+  for (auto it = mCallLevels.begin(); it != mCallLevels.end(); ) {
+    if (it->tick != mTickCount)
+      it = mCallLevels.erase(it);
+    else
+      ++it;
+  }
+
+  const float conferenceMicroVu = mConferenceMicro.rms;
+  if (core->isInConference()) {
+    running = true;
+    mConferenceMicro.update(MediastreamerUtils::computeVu(core->getConferenceLocalInputVolume()), alpha, decay);
+  } else
+    mConferenceMicro = Level();
+  if (conferenceMicroVu != mConferenceMicro.rms)
+    emit conferenceMicroVuChanged(mConferenceMicro.rms);
+
+  // No wakeup without running call.
+  if (!running)
+    mTimer->stop();
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2010-2020 Belledonne Communications SARL.
+ *
+ * This file is part of linphone-desktop
+ * (see https://www.linphone.org).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef VU_METER_SAMPLER_H_
+#define VU_METER_SAMPLER_H_
+
+#include <memory>
+
+#include <QHash>
+#include <QObject>
+#include <linphone++/linphone.hh>
+
+// =============================================================================
+// Sample the input/output volumes of all calls with one timer. Each tick
+// updates a smoothed level (RMS) and a decaying peak, then pushes them to
+// the call models so QML only reads cached values.
+// =============================================================================
+
+class CallModel;
+class QTimer;
+
+class VuMeterSampler : public QObject {
+  Q_OBJECT;
+
+public:
+  VuMeterSampler (QObject *parent = Q_NULLPTR);
+
+  float getConferenceMicroVu () const {
+    return mConferenceMicro.rms;
+  }
+
+  // Ticks since the app start, to compare the cost of the sampling with N calls.
+  quint64 getTickCount () const {
+    return mTickCount;
+  }
+
+signals:
+  void conferenceMicroVuChanged (float vu);
+
+private:
+  struct Level {
+    float rms = 0.f;
+    float peak = 0.f;
+    float meanSquare = 0.f;
+
+    void update (float vu, float alpha, float decay);
+  };
+
+  struct CallLevels {
+    Level speaker;
+    Level micro;
+    quint64 tick = 0;
+  };
+
+  void handleCallStateChanged (const std::shared_ptr<linphone::Call> &call, linphone::Call::State state);
+  void handleTimeout ();
+
+  QTimer *mTimer = nullptr;
+  quint64 mTickCount = 0;
+
+  QHash<CallModel *, CallLevels> mCallLevels;
+  Level mConferenceMicro;
+};
+
+#endif // VU_METER_SAMPLER_H_
@@ -21,55 +21,66 @@
 #include <QOpenGLFramebufferObject>
 #include <QQuickWindow>
 #include <QThread>
-#include <QTimer>
 
 #include "components/call/CallModel.hpp"
 #include "components/core/CoreManager.hpp"
 
 #include "Camera.hpp"
+#include "VideoFrameClock.hpp"
 
 // =============================================================================
 
 using namespace std;
 
-namespace {
-constexpr int MaxFps = 30;
-}
-
-
 // =============================================================================
 Camera::Camera (QQuickItem *parent) : QQuickFramebufferObject(parent) {
 	// The fbo content must be y-mirrored because the ms rendering is y-inverted.
 	setMirrorVertically(true);
 	
-	mRefreshTimer = new QTimer(this);
-	mRefreshTimer->setInterval(1000 / MaxFps);
-	
-	QObject::connect(
-				mRefreshTimer, &QTimer::timeout,
-				this, &QQuickFramebufferObject::update,
-				Qt::DirectConnection
-				);
-	
-	mRefreshTimer->start();
+	updateFrameSource();
+}
+
+Camera::~Camera () {
+	CoreManager::getInstance()->getVideoFrameClock()->removeItem(this);
 }
 
+QVariantMap Camera::getFrameStats () const {
+	QQuickItem *item = const_cast<Camera *>(this);
+	return CoreManager::getInstance()->getVideoFrameClock()->getFrameStats(item);
+}
+
+// Called on the render thread. The window id is bound through the core, so it
+// must not run during an iteration. The frames are then rendered without the
+// core lock: the decoder fills the back buffer of the ms display while the
+// render thread draws the front one.
 QQuickFramebufferObject::Renderer *Camera::createRenderer () const {
+	CoreManager *coreManager = CoreManager::getInstance();
 	QQuickFramebufferObject::Renderer * renderer = NULL;
+	coreManager->lockVideoRender(VideoRenderLock::RenderSide);
 	if(mIsPreview){
-		CoreManager::getInstance()->getCore()->setNativePreviewWindowId(NULL);// Reset
-		renderer=(QQuickFramebufferObject::Renderer *)CoreManager::getInstance()->getCore()->getNativePreviewWindowId();
-		return renderer;
+		coreManager->getCore()->setNativePreviewWindowId(NULL);// Reset
+		renderer=(QQuickFramebufferObject::Renderer *)coreManager->getCore()->getNativePreviewWindowId();
 	}else{
 		auto call = mCallModel->getCall();
 		if(call){
 			call->setNativeVideoWindowId(NULL);// Reset
-			return (QQuickFramebufferObject::Renderer *) call->getNativeVideoWindowId();
+			renderer=(QQuickFramebufferObject::Renderer *) call->getNativeVideoWindowId();
 		}else{
-			CoreManager::getInstance()->getCore()->setNativeVideoWindowId(NULL);
-			return (QQuickFramebufferObject::Renderer *) CoreManager::getInstance()->getCore()->getNativeVideoWindowId();
+			coreManager->getCore()->setNativeVideoWindowId(NULL);
+			renderer=(QQuickFramebufferObject::Renderer *) coreManager->getCore()->getNativeVideoWindowId();
 		}
 	}
+	coreManager->unlockVideoRender();
+	return renderer;
+}
+
+// -----------------------------------------------------------------------------
+
+// Redraw on the decoded frames of the call. The preview and the core video
+// window have no frame notification, they are polled.
+void Camera::updateFrameSource () {
+	shared_ptr<linphone::Call> call = !mIsPreview && mCallModel ? mCallModel->getCall() : nullptr;
+	CoreManager::getInstance()->getVideoFrameClock()->setItemSource(this, call);
 }
 
 // -----------------------------------------------------------------------------
@@ -81,7 +92,7 @@ CallModel *Camera::getCallModel () const {
 void Camera::setCallModel (CallModel *callModel) {
 	if (mCallModel != callModel) {
 		mCallModel = callModel;
-		update();
+		updateFrameSource();
 		
 		emit callChanged(mCallModel);
 	}
@@ -94,7 +105,7 @@ bool Camera::getIsPreview () const {
 void Camera::setIsPreview (bool status) {
 	if (mIsPreview != status) {
 		mIsPreview = status;
-		update();
+		updateFrameSource();
 		
 		emit isPreviewChanged(status);
 	}
@@ -24,6 +24,7 @@
 #include <memory>
 
 #include <QQuickFramebufferObject>
+#include <QVariantMap>
 #include <mediastreamer2/msogl.h>
 
 // =============================================================================
@@ -44,14 +45,20 @@ class Camera : public QQuickFramebufferObject {
 
 public:
   Camera (QQuickItem *parent = Q_NULLPTR);
+  ~Camera ();
 
   QQuickFramebufferObject::Renderer *createRenderer () const override;
 
+  // Frame counters of the item, the render time is not measured.
+  Q_INVOKABLE QVariantMap getFrameStats () const;
+
 signals:
   void callChanged (CallModel *callModel);
   void isPreviewChanged (bool isPreview);
 
 private:
+  void updateFrameSource ();
+
   CallModel *getCallModel () const;
   void setCallModel (CallModel *callModel);
 
@@ -60,8 +67,6 @@ private:
 
   bool mIsPreview = false;
   CallModel *mCallModel = nullptr;
-
-  QTimer *mRefreshTimer = nullptr;
 };
 
 #endif // CAMERA_H_
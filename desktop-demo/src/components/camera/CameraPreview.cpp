@@ -21,19 +21,16 @@
 #include <QOpenGLFramebufferObject>
 #include <QQuickWindow>
 #include <QThread>
-#include <QTimer>
 
 #include "components/core/CoreManager.hpp"
 
 #include "CameraPreview.hpp"
+#include "VideoFrameClock.hpp"
 
 // =============================================================================
 
 using namespace std;
 
-namespace {
-constexpr int MaxFps = 30;
-}
 // -----------------------------------------------------------------------------
 
 QMutex CameraPreview::mCounterMutex;
@@ -51,19 +48,12 @@ CameraPreview::CameraPreview (QQuickItem *parent) : QQuickFramebufferObject(pare
 	// The fbo content must be y-mirrored because the ms rendering is y-inverted.
 	setMirrorVertically(true);
 	
-	mRefreshTimer = new QTimer(this);
-	mRefreshTimer->setInterval(1000 / MaxFps);
-	
-	QObject::connect(
-				mRefreshTimer, &QTimer::timeout,
-				this, &QQuickFramebufferObject::update,
-				Qt::DirectConnection
-				);
-	
-	mRefreshTimer->start();
+	// No frame notification for the preview: polled by the clock.
+	CoreManager::getInstance()->getVideoFrameClock()->setItemSource(this, nullptr);
 }
 
 CameraPreview::~CameraPreview () {
+	CoreManager::getInstance()->getVideoFrameClock()->removeItem(this);
 	mCounterMutex.lock();
 	if (--mCounter == 0)
 		CoreManager::getInstance()->getCore()->enableVideoPreview(false);
@@ -82,9 +72,13 @@ public:
 };
 
 QQuickFramebufferObject::Renderer *CameraPreview::createRenderer () const {
+	// Called on the render thread: see `Camera::createRenderer`.
+	CoreManager *coreManager = CoreManager::getInstance();
 	QQuickFramebufferObject::Renderer * renderer;
-	CoreManager::getInstance()->getCore()->setNativePreviewWindowId(NULL);// Reset
-	renderer=(QQuickFramebufferObject::Renderer *)CoreManager::getInstance()->getCore()->getNativePreviewWindowId();
+	coreManager->lockVideoRender(VideoRenderLock::RenderSide);
+	coreManager->getCore()->setNativePreviewWindowId(NULL);// Reset
+	renderer=(QQuickFramebufferObject::Renderer *)coreManager->getCore()->getNativePreviewWindowId();
+	coreManager->unlockVideoRender();
 	if(renderer)
 		return renderer;
 	else{
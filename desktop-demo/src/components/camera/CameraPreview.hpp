@@ -37,8 +37,6 @@ public:
   QQuickFramebufferObject::Renderer *createRenderer () const override;
 
 private:
-  QTimer *mRefreshTimer = nullptr;
-
   static QMutex mCounterMutex;
   static int mCounter;
 };
@@ -0,0 +1,352 @@
+/*
+ * Copyright (c) 2010-2020 Belledonne Communications SARL.
+ *
+ * This file is part of linphone-desktop
+ * (see https://www.linphone.org).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QQuickWindow>
+#include <QSGSimpleTextureNode>
+#include <QtDebug>
+
+#include <linphone/core.h>
+#include <mediastreamer2/mediastream.h>
+#include <mediastreamer2/msvideo.h>
+
+#include "components/call/CallModel.hpp"
+#include "components/core/CoreManager.hpp"
+#include "components/settings/SettingsModel.hpp"
+
+#include "SoftwareCamera.hpp"
+#include "VideoFrameClock.hpp"
+#include "YuvConverter.hpp"
+
+// =============================================================================
+
+using namespace std;
+
+namespace {
+  constexpr char SoftwareVideoRenderingName[] = "software_video_rendering";
+}
+
+constexpr char SoftwareCamera::DisplayFilterName[];
+
+// GUI thread, which iterates the core.
+static MSFilter *getDisplayFilter (const shared_ptr<linphone::Call> &call) {
+  VideoStream *stream = reinterpret_cast<VideoStream *>(linphone_call_get_stream(call->cPtr(), LinphoneStreamTypeVideo));
+  return stream ? stream->output : nullptr;
+}
+
+// -----------------------------------------------------------------------------
+// Receives the pictures of a display filter on the media ticker thread.
+// The sinks are recycled, never freed: a notification may still be running
+// when the sink of a destroyed item is detached.
+// -----------------------------------------------------------------------------
+
+class SoftwareCamera::FrameSink {
+public:
+  static FrameSink *acquire (QQuickItem *item) {
+    FrameSink *frameSink;
+    {
+      QMutexLocker locker(&mPoolMutex);
+      frameSink = mPool.isEmpty() ? new FrameSink() : mPool.takeLast();
+    }
+    QMutexLocker locker(&frameSink->mMutex);
+    frameSink->mItem = item;
+    return frameSink;
+  }
+
+  // GUI thread, after `detach`.
+  void release () {
+    {
+      QMutexLocker locker(&mMutex);
+      if (mFrameCount)
+        qInfo() << QStringLiteral("Software camera: %1 frames, last %2x%3 for %4x%5. Per frame: %6 us of conversion, %7 bytes uploaded.")
+          .arg(mFrameCount)
+          .arg(mFrame.width()).arg(mFrame.height())
+          .arg(mTargetSize.width()).arg(mTargetSize.height())
+          .arg(mConversionTime / qint64(mFrameCount) / 1000)
+          .arg(mUploadedBytes / mFrameCount);
+      mFrameCount = 0;
+      mConversionTime = 0;
+      mUploadedBytes = 0;
+
+      mItem = nullptr;
+      mCall = nullptr;
+      mTargetSize = QSize();
+      mFrame = QImage();
+    }
+    QMutexLocker locker(&mPoolMutex);
+    mPool << this;
+  }
+
+  // GUI thread.
+  void setSource (const linphone::Call *call, bool isPreview) {
+    QMutexLocker locker(&mMutex);
+    mCall = call;
+    mIsPreview = isPreview;
+    if (!call)
+      mFrame = QImage();
+  }
+
+  // Size of the item in pixels. Invalid if unknown: the frames keep their
+  // size. Empty if the item is hidden: the frames are dropped.
+  void setTargetSize (const QSize &size) {
+    QMutexLocker locker(&mMutex);
+    mTargetSize = size;
+  }
+
+  // Render thread, the GUI thread is blocked.
+  QImage takeFrame (bool &changed) {
+    QMutexLocker locker(&mMutex);
+    changed = mFrameChanged;
+    mFrameChanged = false;
+    if (changed)
+      mUploadedBytes += quint64(mFrame.bytesPerLine()) * quint64(mFrame.height());
+    return mFrame;
+  }
+
+  // GUI thread. A filter which is not the output of the stream anymore was
+  // destroyed with its stream.
+  void attach (MSFilter *filter) {
+    if (filter == mFilter)
+      return;
+    mFilter = filter;
+    if (filter)
+      ms_filter_add_notify_callback(filter, handleEvent, this, TRUE);
+  }
+
+  void detach (MSFilter *filter) {
+    if (filter && filter == mFilter)
+      ms_filter_remove_notify_callback(filter, handleEvent, this);
+    mFilter = nullptr;
+  }
+
+private:
+  FrameSink () = default;
+
+  static void handleEvent (void *userData, MSFilter *, unsigned int id, void *arg) {
+    if (id == MS_EXT_DISPLAY_ON_DRAW)
+      static_cast<FrameSink *>(userData)->push(*static_cast<MSExtDisplayOutput *>(arg));
+  }
+
+  void push (const MSExtDisplayOutput &output) {
+    QQuickItem *item;
+    const linphone::Call *call;
+    QSize targetSize;
+    bool isPreview;
+    {
+      QMutexLocker locker(&mMutex);
+      item = mItem;
+      call = mCall;
+      targetSize = mTargetSize;
+      isPreview = mIsPreview;
+    }
+
+    const MSPicture &picture = isPreview ? output.local_view : output.remote_view;
+    if (!call || picture.w <= 0 || picture.h <= 0 || !picture.planes[0])
+      return;
+    if (targetSize.isValid() && targetSize.isEmpty())
+      return;
+
+    // Never larger than the item: the scene graph scales up. The nearest
+    // neighbour scaling only reads the sampled rows, so a thumbnail costs
+    // its own size and not the size of the stream.
+    QSize size(picture.w, picture.h);
+    if (targetSize.isValid() && (size.width() > targetSize.width() || size.height() > targetSize.height()))
+      size = size.scaled(targetSize, Qt::KeepAspectRatio).expandedTo(QSize(1, 1));
+
+    if (mBackFrame.size() != size)
+      mBackFrame = QImage(size, QImage::Format_RGB32);
+
+    const YuvPicture yuvPicture = {
+      picture.w, picture.h,
+      { picture.planes[0], picture.planes[1], picture.planes[2] },
+      { picture.strides[0], picture.strides[1], picture.strides[2] }
+    };
+    QElapsedTimer timer;
+    timer.start();
+    YuvConverter::convert(yuvPicture, mBackFrame.bits(), mBackFrame.bytesPerLine(), size.width(), size.height());
+    const qint64 conversionTime = timer.nsecsElapsed();
+
+    {
+      QMutexLocker locker(&mMutex);
+      if (mCall != call)
+        return;
+      mFrame.swap(mBackFrame);
+      mFrameChanged = true;
+      ++mFrameCount;
+      mConversionTime += conversionTime;
+    }
+    // Only the item of this sink: the local and remote views of a call have their own frames.
+    CoreManager::getInstance()->getVideoFrameClock()->notifyFrame(item);
+  }
+
+  QMutex mMutex;
+  QQuickItem *mItem = nullptr; // Only a key of the clock, it may be destroyed.
+  const linphone::Call *mCall = nullptr;
+  bool mIsPreview = false;
+  QSize mTargetSize;
+  QImage mFrame;
+  bool mFrameChanged = false;
+
+  quint64 mFrameCount = 0;
+  qint64 mConversionTime = 0; // In nanoseconds.
+  quint64 mUploadedBytes = 0;
+
+  QImage mBackFrame; // Ticker thread.
+  MSFilter *mFilter = nullptr; // GUI thread.
+
+  static QMutex mPoolMutex;
+  static QList<FrameSink *> mPool;
+};
+
+QMutex SoftwareCamera::FrameSink::mPoolMutex;
+QList<SoftwareCamera::FrameSink *> SoftwareCamera::FrameSink::mPool;
+
+// -----------------------------------------------------------------------------
+
+SoftwareCamera::SoftwareCamera (QQuickItem *parent) : QQuickItem(parent) {
+  setFlag(ItemHasContents, true);
+  mFrameSink = FrameSink::acquire(this);
+  attach();
+}
+
+SoftwareCamera::~SoftwareCamera () {
+  detach();
+
+  CoreManager::getInstance()->getVideoFrameClock()->removeItem(this);
+  mFrameSink->release();
+}
+
+bool SoftwareCamera::isEnabled (const shared_ptr<linphone::Config> &config) {
+  if (config && config->getInt(SettingsModel::UiSection, SoftwareVideoRenderingName, 0))
+    return true;
+
+  // For example with `QT_QUICK_BACKEND=software`: the MSQOGL filter can't work.
+  return QQuickWindow::sceneGraphBackend() == QLatin1String("software");
+}
+
+QVariantMap SoftwareCamera::getFrameStats () const {
+  QQuickItem *item = const_cast<SoftwareCamera *>(this);
+  return CoreManager::getInstance()->getVideoFrameClock()->getFrameStats(item);
+}
+
+// -----------------------------------------------------------------------------
+
+void SoftwareCamera::itemChange (ItemChange change, const ItemChangeData &value) {
+  // No paint node update for a hidden item: drop its frames from here.
+  if (change == ItemVisibleHasChanged)
+    mFrameSink->setTargetSize(value.boolValue ? QSize() : QSize(0, 0));
+  QQuickItem::itemChange(change, value);
+}
+
+QSGNode *SoftwareCamera::updatePaintNode (QSGNode *oldNode, UpdatePaintNodeData *) {
+  QElapsedTimer timer;
+  timer.start();
+
+  const QSizeF itemSize(width(), height());
+  const qreal ratio = window() ? window()->effectiveDevicePixelRatio() : 1.0;
+  mFrameSink->setTargetSize((itemSize * ratio).toSize());
+
+  bool changed;
+  const QImage frame = mFrameSink->takeFrame(changed);
+  if (frame.isNull() || itemSize.isEmpty() || !window()) {
+    delete oldNode;
+    return nullptr;
+  }
+
+  QSGSimpleTextureNode *node = static_cast<QSGSimpleTextureNode *>(oldNode);
+  if (!node) {
+    node = new QSGSimpleTextureNode();
+    node->setOwnsTexture(true);
+    node->setFiltering(QSGTexture::Linear);
+    changed = true;
+  }
+  if (changed) {
+    node->setTexture(window()->createTextureFromImage(frame));
+    CoreManager::getInstance()->getVideoFrameClock()->addRenderTime(this, timer.nsecsElapsed());
+  }
+
+  const QSizeF frameSize = QSizeF(frame.size()).scaled(itemSize, Qt::KeepAspectRatio);
+  node->setRect(QRectF(
+    QPointF((itemSize.width() - frameSize.width()) / 2, (itemSize.height() - frameSize.height()) / 2),
+    frameSize
+  ));
+  return node;
+}
+
+// -----------------------------------------------------------------------------
+
+// The display filter is created with the video stream: attach again when the
+// call status changes.
+void SoftwareCamera::attach () {
+  mCall = mCallModel ? mCallModel->getCall() : nullptr;
+  mFrameSink->setSource(mCall.get(), mIsPreview);
+  CoreManager::getInstance()->getVideoFrameClock()->setItemSource(this, mCall, false, mIsPreview);
+  if (!mCall)
+    return;
+
+  mFrameSink->attach(getDisplayFilter(mCall));
+}
+
+void SoftwareCamera::detach () {
+  if (!mCall)
+    return;
+
+  mFrameSink->setSource(nullptr, mIsPreview);
+
+  mFrameSink->detach(getDisplayFilter(mCall));
+  mCall = nullptr;
+}
+
+// -----------------------------------------------------------------------------
+
+CallModel *SoftwareCamera::getCallModel () const {
+  return mCallModel;
+}
+
+void SoftwareCamera::setCallModel (CallModel *callModel) {
+  if (mCallModel != callModel) {
+    if (mCallModel)
+      QObject::disconnect(mCallModel, &CallModel::statusChanged, this, &SoftwareCamera::attach);
+    detach();
+
+    mCallModel = callModel;
+    if (mCallModel)
+      QObject::connect(mCallModel, &CallModel::statusChanged, this, &SoftwareCamera::attach);
+    attach();
+
+    emit callChanged(mCallModel);
+  }
+}
+
+bool SoftwareCamera::getIsPreview () const {
+  return mIsPreview;
+}
+
+void SoftwareCamera::setIsPreview (bool status) {
+  if (mIsPreview != status) {
+    mIsPreview = status;
+    mFrameSink->setSource(mCall.get(), status);
+    CoreManager::getInstance()->getVideoFrameClock()->setItemSource(this, mCall, false, status);
+    update();
+
+    emit isPreviewChanged(status);
+  }
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2010-2020 Belledonne Communications SARL.
+ *
+ * This file is part of linphone-desktop
+ * (see https://www.linphone.org).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SOFTWARE_CAMERA_H_
+#define SOFTWARE_CAMERA_H_
+
+#include <memory>
+
+#include <QQuickItem>
+#include <QVariantMap>
+
+// =============================================================================
+// Video item for the machines without usable GL: the core displays the frames
+// with the MSExtDisplay filter, which gives the raw I420 pictures. They are
+// converted to RGB on the media ticker thread, downscaled to the pixel size of
+// the item (device pixel ratio included), then drawn as an image by the scene
+// graph. Hidden items convert nothing.
+// Registered as `Camera` and `CameraPreview` when enabled. The preview is the
+// local view of the call: there is no picture without a call.
+// =============================================================================
+
+namespace linphone {
+  class Call;
+  class Config;
+}
+
+class CallModel;
+
+class SoftwareCamera : public QQuickItem {
+  Q_OBJECT;
+
+  Q_PROPERTY(CallModel * call READ getCallModel WRITE setCallModel NOTIFY callChanged);
+  Q_PROPERTY(bool isPreview READ getIsPreview WRITE setIsPreview NOTIFY isPreviewChanged);
+
+public:
+  static constexpr char DisplayFilterName[] = "MSExtDisplay";
+
+  SoftwareCamera (QQuickItem *parent = Q_NULLPTR);
+  ~SoftwareCamera ();
+
+  // With `ui/software_video_rendering=1` or the software backend of Qt Quick.
+  static bool isEnabled (const std::shared_ptr<linphone::Config> &config);
+
+  // Frame counters and texture upload time of the item.
+  Q_INVOKABLE QVariantMap getFrameStats () const;
+
+signals:
+  void callChanged (CallModel *callModel);
+  void isPreviewChanged (bool isPreview);
+
+protected:
+  void itemChange (ItemChange change, const ItemChangeData &value) override;
+  QSGNode *updatePaintNode (QSGNode *oldNode, UpdatePaintNodeData *data) override;
+
+  bool getIsPreview () const;
+  void setIsPreview (bool status);
+
+private:
+  class FrameSink;
+
+  CallModel *getCallModel () const;
+  void setCallModel (CallModel *callModel);
+
+  void attach ();
+  void detach ();
+
+  bool mIsPreview = false;
+  CallModel *mCallModel = nullptr;
+
+  std::shared_ptr<linphone::Call> mCall;
+  FrameSink *mFrameSink = nullptr;
+};
+
+class SoftwareCameraPreview : public SoftwareCamera {
+  Q_OBJECT;
+
+public:
+  SoftwareCameraPreview (QQuickItem *parent = Q_NULLPTR) : SoftwareCamera(parent) {
+    setIsPreview(true);
+  }
+};
+
+#endif // SOFTWARE_CAMERA_H_
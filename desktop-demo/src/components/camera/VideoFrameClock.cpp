@@ -0,0 +1,408 @@
+/*
+ * Copyright (c) 2010-2020 Belledonne Communications SARL.
+ *
+ * This file is part of linphone-desktop
+ * (see https://www.linphone.org).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QQuickItem>
+#include <QQuickWindow>
+#include <QStringList>
+#include <QTimer>
+
+#include <linphone++/linphone.hh>
+
+#include "VideoFrameClock.hpp"
+
+// =============================================================================
+
+using namespace std;
+
+namespace {
+  constexpr int MaxFps = 30;
+
+  // Redraw anyway if a window did not swap after an update, for example if it is hidden.
+  constexpr int MaxSwapWait = 100;
+
+  // Renew the frame notifications, in case one was requested before the decoder existed.
+  constexpr int KeepAliveInterval = 1000;
+
+  // A longer time between two video frames is a pause of the video, not a frame time.
+  constexpr qint64 MaxFrameTime = 1000000000;
+
+  int getFrameTimeBucket (qint64 frameTime) {
+    qint64 ms = frameTime / 1000000;
+    int bucket = 0;
+    while (ms > 0 && bucket < VideoFrameClock::FrameTimeBucketCount - 1) {
+      ms >>= 1;
+      ++bucket;
+    }
+    return bucket;
+  }
+}
+
+constexpr int VideoFrameClock::FrameTimeBucketCount;
+
+// -----------------------------------------------------------------------------
+
+class VideoFrameClock::CallFrameListener : public linphone::CallListener {
+public:
+  CallFrameListener (VideoFrameClock *clock) : mClock(clock) {}
+
+  // Called by the core, not necessarily on the GUI thread.
+  void onNextVideoFrameDecoded (const shared_ptr<linphone::Call> &call) override {
+    VideoFrameClock *clock = mClock;
+    if (clock && clock->notifyFrame(call.get()))
+      call->requestNotifyNextVideoFrameDecoded();
+  }
+
+  atomic<VideoFrameClock *> mClock;
+};
+
+// -----------------------------------------------------------------------------
+
+VideoFrameClock::VideoFrameClock (QObject *parent) : QObject(parent) {
+  mCallFrameListener = make_shared<CallFrameListener>(this);
+
+  mPollTimer = new QTimer(this);
+  mPollTimer->setInterval(1000 / MaxFps);
+  QObject::connect(mPollTimer, &QTimer::timeout, this, &VideoFrameClock::poll);
+
+  mKeepAliveTimer = new QTimer(this);
+  mKeepAliveTimer->setInterval(KeepAliveInterval);
+  QObject::connect(mKeepAliveTimer, &QTimer::timeout, this, &VideoFrameClock::requestFrames);
+}
+
+VideoFrameClock::~VideoFrameClock () {
+  mCallFrameListener->mClock = nullptr;
+}
+
+// -----------------------------------------------------------------------------
+
+VideoFrameClock::Stats &VideoFrameClock::Stats::operator+= (const Stats &other) {
+  receivedCount += other.receivedCount;
+  renderedCount += other.renderedCount;
+  skippedCount += other.skippedCount;
+  timedRenderCount += other.timedRenderCount;
+  renderTime += other.renderTime;
+  maxRenderTime = qMax(maxRenderTime, other.maxRenderTime);
+  return *this;
+}
+
+QVariantMap VideoFrameClock::Stats::toVariantMap () const {
+  QVariantMap map;
+  map["received"] = receivedCount;
+  map["rendered"] = renderedCount;
+  map["skipped"] = skippedCount;
+  // In microseconds, -1 if the item can't time its rendering.
+  map["renderTime"] = timedRenderCount ? renderTime / qint64(timedRenderCount) / 1000 : -1;
+  map["maxRenderTime"] = timedRenderCount ? maxRenderTime / 1000 : -1;
+  return map;
+}
+
+QString VideoFrameClock::FrameTimes::toString () const {
+  QStringList buckets;
+  for (int i = 0; i < FrameTimeBucketCount; ++i) {
+    if (!histogram[i])
+      continue;
+
+    const QString bound = i == 0
+      ? QStringLiteral("<1ms")
+      : i == FrameTimeBucketCount - 1
+        ? QStringLiteral(">=%1ms").arg(1 << (i - 1))
+        : QStringLiteral("<%1ms").arg(1 << i);
+    buckets << QStringLiteral("%1:%2").arg(bound).arg(histogram[i]);
+  }
+
+  return QStringLiteral("%1 frames, avg %2 ms, max %3 ms [%4]")
+    .arg(count)
+    .arg(count ? totalTime / qint64(count) / 1000000 : 0)
+    .arg(maxTime / 1000000)
+    .arg(buckets.join(' '));
+}
+
+// -----------------------------------------------------------------------------
+
+void VideoFrameClock::setItemSource (
+  QQuickItem *item,
+  const shared_ptr<linphone::Call> &call,
+  bool isWatching,
+  bool isPreview
+) {
+  bool isNew;
+  bool wasWatchingCall;
+  shared_ptr<linphone::Call> oldCall;
+  {
+    QMutexLocker locker(&mMutex);
+    isNew = !mItems.contains(item);
+    Item &info = mItems[item];
+    oldCall = info.call;
+    wasWatchingCall = info.isWatching;
+    if (oldCall != call || info.isPreview != isPreview)
+      info.stats = Stats();
+    info.call = call;
+    info.isWatching = isWatching;
+    info.isPreview = isPreview;
+    info.dirty = true;
+  }
+
+  if (isNew || oldCall != call || wasWatchingCall != isWatching) {
+    if (oldCall && !isWatched(oldCall.get()))
+      unwatchCall(oldCall);
+    if (call && isWatching)
+      watchCall(call);
+    updateTimers();
+  }
+
+  scheduleFlush();
+}
+
+void VideoFrameClock::removeItem (QQuickItem *item) {
+  shared_ptr<linphone::Call> call;
+  {
+    QMutexLocker locker(&mMutex);
+    auto it = mItems.find(item);
+    if (it == mItems.end())
+      return;
+    call = it->call;
+    mItems.erase(it);
+  }
+
+  if (call && !isWatched(call.get()))
+    unwatchCall(call);
+  updateTimers();
+}
+
+bool VideoFrameClock::notifyFrame (const linphone::Call *call) {
+  bool found = false;
+  {
+    QMutexLocker locker(&mMutex);
+    for (auto it = mItems.begin(); it != mItems.end(); ++it)
+      if (it->call.get() == call) {
+        markDirty(*it);
+        found = true;
+      }
+  }
+
+  if (found)
+    scheduleFlush();
+  return found;
+}
+
+bool VideoFrameClock::notifyFrame (QQuickItem *item) {
+  {
+    QMutexLocker locker(&mMutex);
+    auto it = mItems.find(item);
+    if (it == mItems.end())
+      return false;
+    markDirty(*it);
+  }
+
+  scheduleFlush();
+  return true;
+}
+
+void VideoFrameClock::addRenderTime (QQuickItem *item, qint64 renderTime) {
+  QMutexLocker locker(&mMutex);
+  auto it = mItems.find(item);
+  if (it == mItems.end())
+    return;
+
+  Stats &stats = it->stats;
+  ++stats.timedRenderCount;
+  stats.renderTime += renderTime;
+  stats.maxRenderTime = qMax(stats.maxRenderTime, renderTime);
+}
+
+QVariantMap VideoFrameClock::getFrameStats (QQuickItem *item) const {
+  Stats stats;
+  shared_ptr<linphone::Call> call;
+  {
+    QMutexLocker locker(&mMutex);
+    auto it = mItems.constFind(item);
+    if (it != mItems.cend()) {
+      stats = it->stats;
+      call = it->call;
+    }
+  }
+
+  QVariantMap map = stats.toVariantMap();
+  shared_ptr<const linphone::CallParams> params = call ? call->getCurrentParams() : nullptr;
+  map["decodedFramerate"] = params ? params->getReceivedFramerate() : -1;
+  return map;
+}
+
+VideoFrameClock::Stats VideoFrameClock::getCallStats (const linphone::Call *call) const {
+  Stats stats;
+  QMutexLocker locker(&mMutex);
+  for (const Item &item : mItems)
+    if (item.call.get() == call && !item.isPreview)
+      stats += item.stats;
+  return stats;
+}
+
+// -----------------------------------------------------------------------------
+
+// A frame which replaces a frame not drawn yet is skipped.
+void VideoFrameClock::markDirty (Item &item) {
+  if (item.dirty && item.stats.receivedCount)
+    ++item.stats.skippedCount;
+  ++item.stats.receivedCount;
+  item.dirty = true;
+}
+
+bool VideoFrameClock::isWatched (const linphone::Call *call) const {
+  QMutexLocker locker(&mMutex);
+  for (const Item &item : mItems)
+    if (item.call.get() == call && item.isWatching)
+      return true;
+  return false;
+}
+
+// The listener is shared by all the items of a call, it must be added once.
+void VideoFrameClock::watchCall (const shared_ptr<linphone::Call> &call) {
+  call->removeListener(mCallFrameListener);
+  call->addListener(mCallFrameListener);
+  call->requestNotifyNextVideoFrameDecoded();
+}
+
+void VideoFrameClock::unwatchCall (const shared_ptr<linphone::Call> &call) {
+  call->removeListener(mCallFrameListener);
+}
+
+void VideoFrameClock::updateTimers () {
+  bool hasPolledItems = false;
+  bool hasCallItems = false;
+  {
+    QMutexLocker locker(&mMutex);
+    for (const Item &item : mItems) {
+      if (item.call)
+        hasCallItems = hasCallItems || item.isWatching;
+      else
+        hasPolledItems = true;
+    }
+  }
+
+  if (!hasPolledItems)
+    mPollTimer->stop();
+  else if (!mPollTimer->isActive())
+    mPollTimer->start();
+
+  if (!hasCallItems)
+    mKeepAliveTimer->stop();
+  else if (!mKeepAliveTimer->isActive())
+    mKeepAliveTimer->start();
+}
+
+// -----------------------------------------------------------------------------
+
+void VideoFrameClock::scheduleFlush () {
+  if (!mFlushPending.exchange(true))
+    QMetaObject::invokeMethod(this, "flush", Qt::QueuedConnection);
+}
+
+void VideoFrameClock::flush () {
+  mFlushPending = false;
+
+  QList<QQuickItem *> items;
+  {
+    QMutexLocker locker(&mMutex);
+    for (auto it = mItems.begin(); it != mItems.end(); ++it) {
+      if (!it->dirty)
+        continue;
+      QQuickWindow *window = it.key()->window();
+      if (window && !isWindowReady(window))
+        continue;
+      it->dirty = false;
+      ++it->stats.renderedCount;
+      items << it.key();
+    }
+  }
+
+  // All the items of a window are updated together, so they are drawn in the same frame.
+  for (QQuickItem *item : items) {
+    item->update();
+    QQuickWindow *window = item->window();
+    if (window) {
+      Window &info = mWindows[window];
+      info.waitingForSwap = true;
+      info.updateTime.start();
+    }
+  }
+}
+
+void VideoFrameClock::poll () {
+  {
+    QMutexLocker locker(&mMutex);
+    for (auto it = mItems.begin(); it != mItems.end(); ++it)
+      if (!it->call)
+        it->dirty = true;
+  }
+  flush();
+}
+
+void VideoFrameClock::requestFrames () {
+  QList<shared_ptr<linphone::Call>> calls;
+  {
+    QMutexLocker locker(&mMutex);
+    for (const Item &item : mItems)
+      if (item.call && item.isWatching && !calls.contains(item.call))
+        calls << item.call;
+  }
+
+  for (const shared_ptr<linphone::Call> &call : calls)
+    call->requestNotifyNextVideoFrameDecoded();
+}
+
+// -----------------------------------------------------------------------------
+
+bool VideoFrameClock::isWindowReady (QQuickWindow *window) {
+  auto it = mWindows.find(window);
+  if (it == mWindows.end()) {
+    // `frameSwapped` is emitted by the render thread.
+    QObject::connect(window, &QQuickWindow::frameSwapped, this, [this, window] {
+      handleFrameSwapped(window);
+    }, Qt::QueuedConnection);
+    QObject::connect(window, &QObject::destroyed, this, [this, window] {
+      mWindows.remove(window);
+    });
+    mWindows.insert(window, Window());
+    return true;
+  }
+
+  return !it->waitingForSwap || it->updateTime.elapsed() > MaxSwapWait;
+}
+
+void VideoFrameClock::handleFrameSwapped (QQuickWindow *window) {
+  auto it = mWindows.find(window);
+  if (it == mWindows.end() || !it->waitingForSwap)
+    return;
+
+  it->waitingForSwap = false;
+
+  if (it->swapTime.isValid()) {
+    const qint64 frameTime = it->swapTime.nsecsElapsed();
+    if (frameTime < MaxFrameTime) {
+      ++mFrameTimes.count;
+      mFrameTimes.totalTime += frameTime;
+      mFrameTimes.maxTime = qMax(mFrameTimes.maxTime, frameTime);
+      ++mFrameTimes.histogram[getFrameTimeBucket(frameTime)];
+    }
+  }
+  it->swapTime.start();
+
+  flush();
+}
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2010-2020 Belledonne Communications SARL.
+ *
+ * This file is part of linphone-desktop
+ * (see https://www.linphone.org).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef VIDEO_FRAME_CLOCK_H_
+#define VIDEO_FRAME_CLOCK_H_
+
+#include <atomic>
+#include <memory>
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QVariantMap>
+
+// =============================================================================
+// Schedules the redraws of the video items. An item bound to a call is redrawn
+// only when the decoder of this call delivers a new frame. The other ones (the
+// preview) have no frame notification and are polled by one shared timer.
+// A window gets at most one batch of updates per frame: the next ones wait for
+// its `frameSwapped`, so the video items follow the vsync of their window.
+// Each item counts its frames: a frame received while the previous one was
+// not drawn yet is skipped. The intervals between the video frames of the
+// windows are kept in a histogram, to see the stalls of the video.
+// =============================================================================
+
+namespace linphone {
+  class Call;
+}
+
+class QQuickItem;
+class QQuickWindow;
+class QTimer;
+
+class VideoFrameClock : public QObject {
+  Q_OBJECT;
+
+public:
+  struct Stats {
+    quint64 receivedCount = 0;
+    quint64 renderedCount = 0;
+    quint64 skippedCount = 0;
+    quint64 timedRenderCount = 0;
+    qint64 renderTime = 0; // In nanoseconds.
+    qint64 maxRenderTime = 0; // In nanoseconds.
+
+    Stats &operator+= (const Stats &other);
+    QVariantMap toVariantMap () const;
+  };
+
+  // Frame times buckets: [0, 1[ ms, then [2^(i - 1), 2^i[ ms. The last one
+  // contains all frame times longer than 2^(FrameTimeBucketCount - 2) ms.
+  static constexpr int FrameTimeBucketCount = 12;
+
+  struct FrameTimes {
+    quint64 count = 0;
+    qint64 totalTime = 0; // In nanoseconds.
+    qint64 maxTime = 0;   // In nanoseconds.
+    quint64 histogram[FrameTimeBucketCount] = {};
+
+    QString toString () const;
+  };
+
+  VideoFrameClock (QObject *parent = Q_NULLPTR);
+  ~VideoFrameClock ();
+
+  // GUI thread. Redraw `item` on the frames of `call`, or poll it if `call` is
+  // null. If `isWatching` is false, the frames are notified by the item itself.
+  // `isPreview` is set for an item which shows the local camera of `call`.
+  void setItemSource (
+    QQuickItem *item,
+    const std::shared_ptr<linphone::Call> &call,
+    bool isWatching = true,
+    bool isPreview = false
+  );
+  void removeItem (QQuickItem *item);
+
+  // Can be called from any thread. Returns false if no item shows this call.
+  bool notifyFrame (const linphone::Call *call);
+  bool notifyFrame (QQuickItem *item);
+
+  // Can be called from any thread, for the items which can time their rendering.
+  void addRenderTime (QQuickItem *item, qint64 renderTime);
+
+  // The counters of the items which show the remote video of `call`.
+  Stats getCallStats (const linphone::Call *call) const;
+
+  // GUI thread. The counters of an item and the framerate of the decoder which feeds it.
+  QVariantMap getFrameStats (QQuickItem *item) const;
+
+  // GUI thread. The times between two swaps of a window which draws video items.
+  FrameTimes getFrameTimes () const {
+    return mFrameTimes;
+  }
+
+private:
+  class CallFrameListener;
+
+  struct Item {
+    std::shared_ptr<linphone::Call> call;
+    bool isWatching = true;
+    bool isPreview = false;
+    bool dirty = true;
+    Stats stats;
+  };
+
+  struct Window {
+    bool waitingForSwap = false;
+    QElapsedTimer updateTime;
+    QElapsedTimer swapTime;
+  };
+
+  static void markDirty (Item &item);
+
+  bool isWatched (const linphone::Call *call) const;
+  void watchCall (const std::shared_ptr<linphone::Call> &call);
+  void unwatchCall (const std::shared_ptr<linphone::Call> &call);
+  void updateTimers ();
+
+  void scheduleFlush ();
+  Q_INVOKABLE void flush ();
+  void poll ();
+  void requestFrames ();
+
+  bool isWindowReady (QQuickWindow *window);
+  void handleFrameSwapped (QQuickWindow *window);
+
+  // Items are written on the GUI thread and read by the frame notifications.
+  mutable QMutex mMutex;
+  QHash<QQuickItem *, Item> mItems;
+
+  std::atomic<bool> mFlushPending { false };
+  QHash<QQuickWindow *, Window> mWindows;
+  FrameTimes mFrameTimes;
+
+  std::shared_ptr<CallFrameListener> mCallFrameListener;
+  QTimer *mPollTimer = nullptr;
+  QTimer *mKeepAliveTimer = nullptr;
+};
+
+#endif // VIDEO_FRAME_CLOCK_H_
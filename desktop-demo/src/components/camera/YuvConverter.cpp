@@ -0,0 +1,433 @@
+/*
+ * Copyright (c) 2010-2020 Belledonne Communications SARL.
+ *
+ * This file is part of linphone-desktop
+ * (see https://www.linphone.org).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+  #define YUV_CONVERTER_X86
+  #include <immintrin.h>
+  #ifdef _MSC_VER
+    #include <intrin.h>
+  #endif // ifdef _MSC_VER
+#endif // if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+  #define YUV_CONVERTER_NEON
+  #include <arm_neon.h>
+#endif // if defined(__ARM_NEON) || defined(__ARM_NEON__)
+
+#if defined(YUV_CONVERTER_X86) && defined(__GNUC__)
+  #define TARGET_SSE2 __attribute__((target("sse2")))
+  #define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+  #define TARGET_SSE2
+  #define TARGET_AVX2
+#endif // if defined(YUV_CONVERTER_X86) && defined(__GNUC__)
+
+#include "YuvConverter.hpp"
+
+// =============================================================================
+
+using namespace std;
+
+namespace {
+  // R = Y' + 1.596 V', G = Y' - 0.391 U' - 0.813 V', B = Y' + 2.018 U'
+  // with Y' = 1.164 (Y - 16), U' = U - 128 and V' = V - 128, multiplied by 64.
+  // The terms fit in 16 bits. Only the sum of B may overflow, and then it is
+  // clamped to 255 anyway: the saturated SIMD additions give the same result.
+  constexpr int YFactor = 75;
+  constexpr int VRFactor = 102;
+  constexpr int UGFactor = 25;
+  constexpr int VGFactor = 52;
+  constexpr int UBFactor = 129;
+  constexpr int Rounding = 32;
+  constexpr int Shift = 6;
+}
+
+using RowFunction = void (*)(const uint8_t *y, const uint8_t *u, const uint8_t *v, uint32_t *dst, int width);
+
+// -----------------------------------------------------------------------------
+// Scalar.
+// -----------------------------------------------------------------------------
+
+static inline uint32_t clampToByte (int value) {
+  return uint32_t(value < 0 ? 0 : (value > 255 ? 255 : value));
+}
+
+// `u` and `v` have one sample for two pixels.
+static void convertRowScalar (const uint8_t *y, const uint8_t *u, const uint8_t *v, uint32_t *dst, int width) {
+  for (int x = 0; x < width; ++x) {
+    const int yy = (y[x] - 16) * YFactor + Rounding;
+    const int uu = u[x >> 1] - 128;
+    const int vv = v[x >> 1] - 128;
+
+    const uint32_t r = clampToByte((yy + VRFactor * vv) >> Shift);
+    const uint32_t g = clampToByte((yy - UGFactor * uu - VGFactor * vv) >> Shift);
+    const uint32_t b = clampToByte((yy + UBFactor * uu) >> Shift);
+    dst[x] = 0xff000000 | (r << 16) | (g << 8) | b;
+  }
+}
+
+// -----------------------------------------------------------------------------
+// SSE2: 16 pixels per step.
+// -----------------------------------------------------------------------------
+
+#ifdef YUV_CONVERTER_X86
+
+// Compute 8 pixels from 16-bit Y, U and V.
+TARGET_SSE2 static inline void computeRgbSse2 (
+  __m128i y, __m128i u, __m128i v,
+  __m128i &r, __m128i &g, __m128i &b
+) {
+  const __m128i yy = _mm_add_epi16(
+    _mm_mullo_epi16(_mm_sub_epi16(y, _mm_set1_epi16(16)), _mm_set1_epi16(YFactor)),
+    _mm_set1_epi16(Rounding)
+  );
+  r = _mm_srai_epi16(_mm_adds_epi16(yy, _mm_mullo_epi16(v, _mm_set1_epi16(VRFactor))), Shift);
+  g = _mm_srai_epi16(_mm_subs_epi16(
+    _mm_subs_epi16(yy, _mm_mullo_epi16(u, _mm_set1_epi16(UGFactor))),
+    _mm_mullo_epi16(v, _mm_set1_epi16(VGFactor))
+  ), Shift);
+  b = _mm_srai_epi16(_mm_adds_epi16(yy, _mm_mullo_epi16(u, _mm_set1_epi16(UBFactor))), Shift);
+}
+
+TARGET_SSE2 static void convertRowSse2 (const uint8_t *y, const uint8_t *u, const uint8_t *v, uint32_t *dst, int width) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i alpha = _mm_set1_epi8(char(0xff));
+  const __m128i bias = _mm_set1_epi16(128);
+
+  int x = 0;
+  for (; x + 16 <= width; x += 16) {
+    const __m128i y8 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(y + x));
+    const __m128i u16 = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(u + x / 2)), zero), bias);
+    const __m128i v16 = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(v + x / 2)), zero), bias);
+
+    // One chroma sample for two pixels.
+    __m128i rLow, gLow, bLow, rHigh, gHigh, bHigh;
+    computeRgbSse2(_mm_unpacklo_epi8(y8, zero), _mm_unpacklo_epi16(u16, u16), _mm_unpacklo_epi16(v16, v16), rLow, gLow, bLow);
+    computeRgbSse2(_mm_unpackhi_epi8(y8, zero), _mm_unpackhi_epi16(u16, u16), _mm_unpackhi_epi16(v16, v16), rHigh, gHigh, bHigh);
+
+    const __m128i r8 = _mm_packus_epi16(rLow, rHigh);
+    const __m128i g8 = _mm_packus_epi16(gLow, gHigh);
+    const __m128i b8 = _mm_packus_epi16(bLow, bHigh);
+
+    // Interleave to B, G, R, A bytes: 0xAARRGGBB in little endian.
+    const __m128i bgLow = _mm_unpacklo_epi8(b8, g8);
+    const __m128i bgHigh = _mm_unpackhi_epi8(b8, g8);
+    const __m128i raLow = _mm_unpacklo_epi8(r8, alpha);
+    const __m128i raHigh = _mm_unpackhi_epi8(r8, alpha);
+
+    __m128i *out = reinterpret_cast<__m128i *>(dst + x);
+    _mm_storeu_si128(out, _mm_unpacklo_epi16(bgLow, raLow));
+    _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(bgLow, raLow));
+    _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(bgHigh, raHigh));
+    _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(bgHigh, raHigh));
+  }
+
+  convertRowScalar(y + x, u + x / 2, v + x / 2, dst + x, width - x);
+}
+
+// -----------------------------------------------------------------------------
+// AVX2: 32 pixels per step. The unpack and pack instructions work on each
+// 128-bit lane, so the chroma and the outputs are permuted around them.
+// -----------------------------------------------------------------------------
+
+TARGET_AVX2 static inline void computeRgbAvx2 (
+  __m256i y, __m256i u, __m256i v,
+  __m256i &r, __m256i &g, __m256i &b
+) {
+  const __m256i yy = _mm256_add_epi16(
+    _mm256_mullo_epi16(_mm256_sub_epi16(y, _mm256_set1_epi16(16)), _mm256_set1_epi16(YFactor)),
+    _mm256_set1_epi16(Rounding)
+  );
+  r = _mm256_srai_epi16(_mm256_adds_epi16(yy, _mm256_mullo_epi16(v, _mm256_set1_epi16(VRFactor))), Shift);
+  g = _mm256_srai_epi16(_mm256_subs_epi16(
+    _mm256_subs_epi16(yy, _mm256_mullo_epi16(u, _mm256_set1_epi16(UGFactor))),
+    _mm256_mullo_epi16(v, _mm256_set1_epi16(VGFactor))
+  ), Shift);
+  b = _mm256_srai_epi16(_mm256_adds_epi16(yy, _mm256_mullo_epi16(u, _mm256_set1_epi16(UBFactor))), Shift);
+}
+
+TARGET_AVX2 static void convertRowAvx2 (const uint8_t *y, const uint8_t *u, const uint8_t *v, uint32_t *dst, int width) {
+  const __m256i alpha = _mm256_set1_epi8(char(0xff));
+  const __m256i bias = _mm256_set1_epi16(128);
+
+  int x = 0;
+  for (; x + 32 <= width; x += 32) {
+    const __m128i yLow8 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(y + x));
+    const __m128i yHigh8 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(y + x + 16));
+
+    // Samples 0-3 and 8-11 in the first lane, 4-7 and 12-15 in the second one:
+    // the unpacks then give the chroma of the pixels 0-15 and 16-31.
+    const __m256i u16 = _mm256_permute4x64_epi64(_mm256_sub_epi16(
+      _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(u + x / 2))), bias
+    ), 0xd8);
+    const __m256i v16 = _mm256_permute4x64_epi64(_mm256_sub_epi16(
+      _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(v + x / 2))), bias
+    ), 0xd8);
+
+    __m256i rLow, gLow, bLow, rHigh, gHigh, bHigh;
+    computeRgbAvx2(_mm256_cvtepu8_epi16(yLow8), _mm256_unpacklo_epi16(u16, u16), _mm256_unpacklo_epi16(v16, v16), rLow, gLow, bLow);
+    computeRgbAvx2(_mm256_cvtepu8_epi16(yHigh8), _mm256_unpackhi_epi16(u16, u16), _mm256_unpackhi_epi16(v16, v16), rHigh, gHigh, bHigh);
+
+    // Pixels 0-7, 16-23 | 8-15, 24-31, reordered to 0-31.
+    const __m256i r8 = _mm256_permute4x64_epi64(_mm256_packus_epi16(rLow, rHigh), 0xd8);
+    const __m256i g8 = _mm256_permute4x64_epi64(_mm256_packus_epi16(gLow, gHigh), 0xd8);
+    const __m256i b8 = _mm256_permute4x64_epi64(_mm256_packus_epi16(bLow, bHigh), 0xd8);
+
+    // Pixels 0-7, 16-23 | 8-15, 24-31 again, per group of 4.
+    const __m256i bgLow = _mm256_unpacklo_epi8(b8, g8);
+    const __m256i bgHigh = _mm256_unpackhi_epi8(b8, g8);
+    const __m256i raLow = _mm256_unpacklo_epi8(r8, alpha);
+    const __m256i raHigh = _mm256_unpackhi_epi8(r8, alpha);
+
+    const __m256i p0 = _mm256_unpacklo_epi16(bgLow, raLow);   // 0-3 | 16-19
+    const __m256i p1 = _mm256_unpackhi_epi16(bgLow, raLow);   // 4-7 | 20-23
+    const __m256i p2 = _mm256_unpacklo_epi16(bgHigh, raHigh); // 8-11 | 24-27
+    const __m256i p3 = _mm256_unpackhi_epi16(bgHigh, raHigh); // 12-15 | 28-31
+
+    __m256i *out = reinterpret_cast<__m256i *>(dst + x);
+    _mm256_storeu_si256(out, _mm256_permute2x128_si256(p0, p1, 0x20));
+    _mm256_storeu_si256(out + 1, _mm256_permute2x128_si256(p2, p3, 0x20));
+    _mm256_storeu_si256(out + 2, _mm256_permute2x128_si256(p0, p1, 0x31));
+    _mm256_storeu_si256(out + 3, _mm256_permute2x128_si256(p2, p3, 0x31));
+  }
+
+  convertRowScalar(y + x, u + x / 2, v + x / 2, dst + x, width - x);
+}
+
+static bool cpuHasSse2 () {
+  #if defined(__x86_64__) || defined(_M_X64)
+    return true;
+  #elif defined(__GNUC__)
+    return __builtin_cpu_supports("sse2");
+  #else
+    int info[4];
+    __cpuid(info, 1);
+    return info[3] & (1 << 26);
+  #endif // if defined(__x86_64__) || defined(_M_X64)
+}
+
+static bool cpuHasAvx2 () {
+  #ifdef __GNUC__
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+  #else
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+      return false;
+
+    // The OS must save the ymm registers.
+    __cpuid(info, 1);
+    if (!(info[2] & (1 << 27)) || (_xgetbv(0) & 0x6) != 0x6)
+      return false;
+
+    __cpuidex(info, 7, 0);
+    return info[1] & (1 << 5);
+  #endif // ifdef __GNUC__
+}
+
+#endif // ifdef YUV_CONVERTER_X86
+
+// -----------------------------------------------------------------------------
+// NEON: 16 pixels per step.
+// -----------------------------------------------------------------------------
+
+#ifdef YUV_CONVERTER_NEON
+
+static inline uint8x8_t computeChannelNeon (int16x8_t value) {
+  return vqmovun_s16(vshrq_n_s16(value, Shift));
+}
+
+static inline void computeRgbNeon (
+  int16x8_t y, int16x8_t u, int16x8_t v,
+  uint8x8_t &r, uint8x8_t &g, uint8x8_t &b
+) {
+  const int16x8_t yy = vaddq_s16(vmulq_n_s16(vsubq_s16(y, vdupq_n_s16(16)), YFactor), vdupq_n_s16(Rounding));
+  r = computeChannelNeon(vqaddq_s16(yy, vmulq_n_s16(v, VRFactor)));
+  g = computeChannelNeon(vqsubq_s16(vqsubq_s16(yy, vmulq_n_s16(u, UGFactor)), vmulq_n_s16(v, VGFactor)));
+  b = computeChannelNeon(vqaddq_s16(yy, vmulq_n_s16(u, UBFactor)));
+}
+
+static void convertRowNeon (const uint8_t *y, const uint8_t *u, const uint8_t *v, uint32_t *dst, int width) {
+  const int16x8_t bias = vdupq_n_s16(128);
+
+  int x = 0;
+  for (; x + 16 <= width; x += 16) {
+    const uint8x16_t y8 = vld1q_u8(y + x);
+    const int16x8_t u16 = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vld1_u8(u + x / 2))), bias);
+    const int16x8_t v16 = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vld1_u8(v + x / 2))), bias);
+
+    // One chroma sample for two pixels.
+    const int16x8x2_t uu = vzipq_s16(u16, u16);
+    const int16x8x2_t vv = vzipq_s16(v16, v16);
+
+    uint8x8_t rLow, gLow, bLow, rHigh, gHigh, bHigh;
+    computeRgbNeon(vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(y8))), uu.val[0], vv.val[0], rLow, gLow, bLow);
+    computeRgbNeon(vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(y8))), uu.val[1], vv.val[1], rHigh, gHigh, bHigh);
+
+    uint8x16x4_t bgra;
+    bgra.val[0] = vcombine_u8(bLow, bHigh);
+    bgra.val[1] = vcombine_u8(gLow, gHigh);
+    bgra.val[2] = vcombine_u8(rLow, rHigh);
+    bgra.val[3] = vdupq_n_u8(0xff);
+    vst4q_u8(reinterpret_cast<uint8_t *>(dst + x), bgra);
+  }
+
+  convertRowScalar(y + x, u + x / 2, v + x / 2, dst + x, width - x);
+}
+
+#endif // ifdef YUV_CONVERTER_NEON
+
+// -----------------------------------------------------------------------------
+
+static RowFunction getRowFunction (YuvConverter::Kernel kernel) {
+  switch (kernel) {
+    #ifdef YUV_CONVERTER_X86
+      case YuvConverter::Sse2Kernel:
+        return convertRowSse2;
+      case YuvConverter::Avx2Kernel:
+        return convertRowAvx2;
+    #endif // ifdef YUV_CONVERTER_X86
+
+    #ifdef YUV_CONVERTER_NEON
+      case YuvConverter::NeonKernel:
+        return convertRowNeon;
+    #endif // ifdef YUV_CONVERTER_NEON
+
+    default:
+      break;
+  }
+  return convertRowScalar;
+}
+
+bool YuvConverter::isSupported (Kernel kernel) {
+  switch (kernel) {
+    case ScalarKernel:
+      return true;
+
+    #ifdef YUV_CONVERTER_X86
+      case Sse2Kernel: {
+        static const bool supported = cpuHasSse2();
+        return supported;
+      }
+      case Avx2Kernel: {
+        static const bool supported = cpuHasAvx2();
+        return supported;
+      }
+    #endif // ifdef YUV_CONVERTER_X86
+
+    #ifdef YUV_CONVERTER_NEON
+      case NeonKernel:
+        return true;
+    #endif // ifdef YUV_CONVERTER_NEON
+
+    default:
+      break;
+  }
+  return false;
+}
+
+YuvConverter::Kernel YuvConverter::getBestKernel () {
+  static const Kernel kernel = isSupported(Avx2Kernel)
+    ? Avx2Kernel
+    : (isSupported(Sse2Kernel) ? Sse2Kernel : (isSupported(NeonKernel) ? NeonKernel : ScalarKernel));
+  return kernel;
+}
+
+const char *YuvConverter::getKernelName (Kernel kernel) {
+  switch (kernel) {
+    case ScalarKernel:
+      return "scalar";
+    case Sse2Kernel:
+      return "sse2";
+    case Avx2Kernel:
+      return "avx2";
+    case NeonKernel:
+      return "neon";
+    default:
+      break;
+  }
+  return "unknown";
+}
+
+// -----------------------------------------------------------------------------
+
+// Index of the source sample at the center of the destination one.
+static inline int getSourceIndex (int index, int size, int sourceSize) {
+  return min(int((2 * int64_t(index) + 1) * sourceSize / (2 * int64_t(size))), sourceSize - 1);
+}
+
+void YuvConverter::convert (const YuvPicture &picture, uint8_t *dst, int stride, int width, int height, Kernel kernel) {
+  if (width <= 0 || height <= 0 || picture.width <= 0 || picture.height <= 0)
+    return;
+
+  const RowFunction convertRow = getRowFunction(isSupported(kernel) ? kernel : ScalarKernel);
+
+  // Same width: the rows of the picture are converted in place. Otherwise they
+  // are sampled first, with one chroma sample for two destination pixels.
+  const bool sameWidth = width == picture.width;
+  const int chromaWidth = (width + 1) / 2;
+  const int pictureChromaWidth = (picture.width + 1) / 2;
+
+  vector<int> xMap;
+  vector<int> chromaXMap;
+  vector<uint8_t> yRow, uRow, vRow;
+  if (!sameWidth) {
+    xMap.resize(size_t(width));
+    for (int x = 0; x < width; ++x)
+      xMap[size_t(x)] = getSourceIndex(x, width, picture.width);
+    chromaXMap.resize(size_t(chromaWidth));
+    for (int x = 0; x < chromaWidth; ++x)
+      chromaXMap[size_t(x)] = getSourceIndex(x, chromaWidth, pictureChromaWidth);
+
+    yRow.resize(size_t(width));
+    uRow.resize(size_t(chromaWidth));
+    vRow.resize(size_t(chromaWidth));
+  }
+
+  int lastChromaY = -1;
+  for (int y = 0; y < height; ++y) {
+    const int sourceY = height == picture.height ? y : getSourceIndex(y, height, picture.height);
+    const int sourceChromaY = sourceY / 2;
+    const uint8_t *ySource = picture.planes[0] + ptrdiff_t(sourceY) * picture.strides[0];
+    const uint8_t *uSource = picture.planes[1] + ptrdiff_t(sourceChromaY) * picture.strides[1];
+    const uint8_t *vSource = picture.planes[2] + ptrdiff_t(sourceChromaY) * picture.strides[2];
+    uint32_t *out = reinterpret_cast<uint32_t *>(dst + ptrdiff_t(y) * stride);
+
+    if (sameWidth) {
+      convertRow(ySource, uSource, vSource, out, width);
+      continue;
+    }
+
+    for (int x = 0; x < width; ++x)
+      yRow[size_t(x)] = ySource[xMap[size_t(x)]];
+    if (sourceChromaY != lastChromaY) {
+      for (int x = 0; x < chromaWidth; ++x) {
+        uRow[size_t(x)] = uSource[chromaXMap[size_t(x)]];
+        vRow[size_t(x)] = vSource[chromaXMap[size_t(x)]];
+      }
+      lastChromaY = sourceChromaY;
+    }
+    convertRow(yRow.data(), uRow.data(), vRow.data(), out, width);
+  }
+}
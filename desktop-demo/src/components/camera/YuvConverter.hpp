@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2010-2020 Belledonne Communications SARL.
+ *
+ * This file is part of linphone-desktop
+ * (see https://www.linphone.org).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef YUV_CONVERTER_H_
+#define YUV_CONVERTER_H_
+
+#include <cstdint>
+
+// =============================================================================
+// Converts the I420 frames of mediastreamer to 32-bit RGB images
+// (QImage::Format_RGB32), with a nearest neighbour scaling. BT.601 limited
+// range, 6-bit fixed point: the SIMD kernels give the same bytes as the
+// scalar one.
+// =============================================================================
+
+struct YuvPicture {
+  int width;
+  int height;
+  const uint8_t *planes[3]; // Y, U, V.
+  int strides[3];
+};
+
+class YuvConverter {
+public:
+  enum Kernel {
+    ScalarKernel,
+    Sse2Kernel,
+    Avx2Kernel,
+    NeonKernel,
+    KernelCount
+  };
+
+  // Supported by the build and by the cpu.
+  static bool isSupported (Kernel kernel);
+  static Kernel getBestKernel ();
+  static const char *getKernelName (Kernel kernel);
+
+  // Write `width` x `height` pixels in `dst`. `stride` is in bytes.
+  static void convert (const YuvPicture &picture, uint8_t *dst, int stride, int width, int height, Kernel kernel);
+  static void convert (const YuvPicture &picture, uint8_t *dst, int stride, int width, int height) {
+    convert(picture, dst, stride, width, height, getBestKernel());
+  }
+};
+
+#endif // YUV_CONVERTER_H_
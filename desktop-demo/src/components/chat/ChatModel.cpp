@@ -271,6 +271,8 @@ private:
     size_t offset,
     size_t
   ) override {
+    // Keep iterating fast while the file is transferred.
+    CoreManager::getInstance()->notifyCoreActivity();
     if (!mChatModel)
       return;
 
@@ -284,6 +286,7 @@ private:
   }
 
   void onMsgStateChanged (const shared_ptr<linphone::ChatMessage> &message, linphone::ChatMessage::State state) override {
+    CoreManager::getInstance()->notifyCoreActivity();
     if (!mChatModel)
       return;
 
@@ -296,7 +299,8 @@ private:
       createThumbnail(message);
       fillThumbnailProperty((*it).first, message);
       (*it).first["wasDownloaded"] = true;
-      App::getInstance()->getNotifier()->notifyReceivedFileMessage(message);
+      if (Notifier *notifier = App::getInstance()->getNotifier())
+        notifier->notifyReceivedFileMessage(message);
     }
 
     (*it).first["status"] = static_cast<MessageStatus>(state);
@@ -327,8 +331,11 @@ ChatModel::ChatModel (const QString &peerAddress, const QString &localAddress) {
   {
     CoreHandlers *coreHandlers = mCoreHandlers.get();
     QObject::connect(coreHandlers, &CoreHandlers::messageReceived, this, &ChatModel::handleMessageReceived);
-    QObject::connect(coreHandlers, &CoreHandlers::callStateChanged, this, &ChatModel::handleCallStateChanged);
-    QObject::connect(coreHandlers, &CoreHandlers::isComposingChanged, this, &ChatModel::handleIsComposingChanged);
+
+    // Only the events of this chat room.
+    ChatRoomEvents *chatRoomEvents = coreHandlers->getChatRoomEvents(mChatRoom, this);
+    QObject::connect(chatRoomEvents, &ChatRoomEvents::callEnded, this, &ChatModel::handleCallEnded);
+    QObject::connect(chatRoomEvents, &ChatRoomEvents::isComposingChanged, this, &ChatModel::handleIsComposingChanged);
   }
   
 }
@@ -749,12 +756,8 @@ void ChatModel::insertMessageAtEnd (const shared_ptr<linphone::ChatMessage> &mes
 
 // -----------------------------------------------------------------------------
 
-void ChatModel::handleCallStateChanged (const shared_ptr<linphone::Call> &call, linphone::Call::State state) {
-  if (
-    (state == linphone::Call::State::End || state == linphone::Call::State::Error) &&
-    mChatRoom == CoreManager::getInstance()->getCore()->findChatRoom(call->getRemoteAddress(), mChatRoom->getLocalAddress())
-  )
-    insertCall(call->getCallLog());
+void ChatModel::handleCallEnded (const shared_ptr<linphone::Call> &call) {
+  insertCall(call->getCallLog());
 }
 
 void ChatModel::handleIsComposingChanged (const shared_ptr<linphone::ChatRoom> &chatRoom) {
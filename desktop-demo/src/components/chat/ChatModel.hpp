@@ -137,7 +137,7 @@ private:
   void insertCall (const std::shared_ptr<linphone::CallLog> &callLog);
   void insertMessageAtEnd (const std::shared_ptr<linphone::ChatMessage> &message);
 
-  void handleCallStateChanged (const std::shared_ptr<linphone::Call> &call, linphone::Call::State state);
+  void handleCallEnded (const std::shared_ptr<linphone::Call> &call);
   void handleIsComposingChanged (const std::shared_ptr<linphone::ChatRoom> &chatRoom);
   void handleMessageReceived (const std::shared_ptr<linphone::ChatMessage> &message);
 
@@ -36,7 +36,7 @@ using namespace std;
 ConferenceHelperModel::ConferenceHelperModel (QObject *parent) : QSortFilterProxyModel(parent) {
   mCore = CoreManager::getInstance()->getCore();
   mConferenceAddModel = new ConferenceAddModel(this);
-  App::getInstance()->getEngine()->setObjectOwnership(mConferenceAddModel, QQmlEngine::CppOwnership);
+  QQmlEngine::setObjectOwnership(mConferenceAddModel, QQmlEngine::CppOwnership);
 
   QObject::connect(this, &CallsListModel::rowsRemoved, [this] {
     invalidate();
@@ -23,11 +23,11 @@
 
 #include "components/call/CallModel.hpp"
 #include "components/calls/CallsListModel.hpp"
+#include "components/calls/VuMeterSampler.hpp"
 #include "components/core/CoreHandlers.hpp"
 #include "components/core/CoreManager.hpp"
 #include "components/settings/SettingsModel.hpp"
 #include "utils/LinphoneUtils.hpp"
-#include "utils/MediastreamerUtils.hpp"
 #include "utils/Utils.hpp"
 
 #include "ConferenceModel.hpp"
@@ -49,6 +49,10 @@ ConferenceModel::ConferenceModel (QObject *parent) : QSortFilterProxyModel(paren
   QObject::connect(
     CoreManager::getInstance()->getHandlers().get(), &CoreHandlers::callStateChanged,
     this, [this] { emit conferenceChanged(); });
+  QObject::connect(
+    CoreManager::getInstance()->getVuMeterSampler(), &VuMeterSampler::conferenceMicroVuChanged,
+    this, &ConferenceModel::microVuChanged
+  );
 }
 // Show all paraticpants thar should be, will be or are still in conference
 bool ConferenceModel::filterAcceptsRow (int sourceRow, const QModelIndex &sourceParent) const {
@@ -125,9 +129,7 @@ bool ConferenceModel::getRecording () const {
 // -----------------------------------------------------------------------------
 
 float ConferenceModel::getMicroVu () const {
-  return MediastreamerUtils::computeVu(
-    CoreManager::getInstance()->getCore()->getConferenceLocalInputVolume()
-  );
+  return CoreManager::getInstance()->getVuMeterSampler()->getConferenceMicroVu();
 }
 
 // -----------------------------------------------------------------------------
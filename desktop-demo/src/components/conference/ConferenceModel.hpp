@@ -33,7 +33,7 @@ class ConferenceModel : public QSortFilterProxyModel {
   Q_PROPERTY(int count READ getCount NOTIFY countChanged);
 
   Q_PROPERTY(bool microMuted READ getMicroMuted WRITE setMicroMuted NOTIFY microMutedChanged);
-  Q_PROPERTY(float microVu READ getMicroVu CONSTANT);
+  Q_PROPERTY(float microVu READ getMicroVu NOTIFY microVuChanged);
 
   Q_PROPERTY(bool recording READ getRecording NOTIFY recordingChanged);
   Q_PROPERTY(bool isInConf READ isInConference NOTIFY conferenceChanged);
@@ -56,6 +56,7 @@ signals:
   void countChanged (int count);
 
   void microMutedChanged (bool status);
+  void microVuChanged (float vu);
   void recordingChanged (bool status);
   void conferenceChanged ();
 
@@ -78,8 +78,9 @@ void ContactModel::setVcardModel (VcardModel *vcardModel) {
   qInfo() << QStringLiteral("Set vcard on contact:") << this << vcardModel;
   setVcardModelInternal(vcardModel);
 
-  // Flush vcard.
+  // Flush vcard. The friend may rewrite its addresses in the vcard.
   mLinphoneFriend->done();
+  mVcardModel->reload();
 
   updateSipAddresses(oldVcardModel);
 }
@@ -92,7 +93,7 @@ void ContactModel::setVcardModelInternal (VcardModel *vcardModel) {
   mVcardModel->mAvatarIsReadOnly = false;
   mVcardModel->mIsReadOnly = true;
 
-  App::getInstance()->getEngine()->setObjectOwnership(mVcardModel, QQmlEngine::CppOwnership);
+  QQmlEngine::setObjectOwnership(mVcardModel, QQmlEngine::CppOwnership);
   mVcardModel->setParent(this);
 
   if (mLinphoneFriend->getVcard() != vcardModel->mVcard)
@@ -19,6 +19,7 @@
  */
 
 #include <belcard/belcard.hpp>
+#include <linphone++/linphone.hh>
 #include <QFileInfo>
 #include <QImageReader>
 #include <QUuid>
@@ -26,7 +27,6 @@
 #include "app/App.hpp"
 #include "app/paths/Paths.hpp"
 #include "app/providers/AvatarProvider.hpp"
-#include "components/core/CoreManager.hpp"
 #include "components/sip-addresses/SipAddressesModel.hpp"
 #include "utils/Utils.hpp"
 
@@ -267,12 +267,14 @@ void VcardModel::setCountry (const QString &country) {
 // -----------------------------------------------------------------------------
 
 QVariantList VcardModel::getSipAddresses () const {
-  shared_ptr<linphone::Core> core = CoreManager::getInstance()->getCore();
+  if (mSipAddressesIsValid)
+    return mSipAddresses;
+
   QVariantList list;
 
   for (const auto &address : mVcard->getVcard()->getImpp()) {
     string value = address->getValue();
-    shared_ptr<linphone::Address> linphoneAddress = core->createAddress(value);
+    shared_ptr<linphone::Address> linphoneAddress = linphone::Factory::get()->createAddress(value);
 
     if (linphoneAddress)
       list << Utils::coreStringToAppString(linphoneAddress->asStringUriOnly());
@@ -281,13 +283,20 @@ QVariantList VcardModel::getSipAddresses () const {
         .arg(Utils::coreStringToAppString(value));
   }
 
+  mSipAddresses = list;
+  mSipAddressesIsValid = true;
+
   return list;
 }
 
 bool VcardModel::addSipAddress (const QString &sipAddress) {
+  return addInterpretedSipAddress(SipAddressesModel::interpretSipAddress(sipAddress));
+}
+
+bool VcardModel::addInterpretedSipAddress (const QString &sipAddress) {
   CHECK_VCARD_IS_WRITABLE(this);
 
-  string interpretedSipAddress = Utils::appStringToCoreString(SipAddressesModel::interpretSipAddress(sipAddress));
+  string interpretedSipAddress = Utils::appStringToCoreString(sipAddress);
   if (interpretedSipAddress.empty())
     return false;
 
@@ -305,6 +314,7 @@ bool VcardModel::addSipAddress (const QString &sipAddress) {
   }
 
   qInfo() << QStringLiteral("Add new sip address on vcard: `%1`.").arg(sipAddress);
+  mSipAddressesIsValid = false;
 
   emit vcardUpdated();
   return true;
@@ -332,6 +342,7 @@ void VcardModel::removeSipAddress (const QString &sipAddress) {
 
   qInfo() << QStringLiteral("Remove sip address on vcard: `%1`.").arg(sipAddress);
   belcard->removeImpp(value);
+  mSipAddressesIsValid = false;
 
   emit vcardUpdated();
 }
@@ -506,6 +517,15 @@ bool VcardModel::updateUrl (const QString &oldUrl, const QString &url) {
   return addUrl(url);
 }
 
+// -----------------------------------------------------------------------------
+
+void VcardModel::reload () {
+  mSipAddressesIsValid = false;
+  mSipAddresses.clear();
+
+  emit vcardUpdated();
+}
+
 QString VcardModel::encode(const QString& data)const{// Convert '\n', ',', '\' to  "\n", "\,", "\\"
     QString encoded;
     for(int i = 0 ; i < data.length() ; ++i){
@@ -80,6 +80,10 @@ public:
   Q_INVOKABLE void removeSipAddress (const QString &sipAddress);
   Q_INVOKABLE bool updateSipAddress (const QString &oldSipAddress, const QString &sipAddress);
 
+  // Same as `addSipAddress` for an address already interpreted: doesn't use
+  // the core, so a detached vcard can be filled outside the GUI thread.
+  bool addInterpretedSipAddress (const QString &sipAddress);
+
   Q_INVOKABLE bool addCompany (const QString &company);
   Q_INVOKABLE void removeCompany (const QString &company);
   Q_INVOKABLE bool updateCompany (const QString &oldCompany, const QString &company);
@@ -102,6 +106,10 @@ public:
   QString encode(const QString& data)const;// Convert '\n', ',', '\' to  "\n", "\,", "\\"
   QString decode(const QString& data)const;// Convert "\n", "\,", "\\" to '\n', ',', '\'
 
+  // Drop parsed data. Must be called if the underlying vcard is modified
+  // without using the mutators of this model, e.g. by `Friend::done`.
+  void reload ();
+
 signals:
   void vcardUpdated ();
 
@@ -112,6 +120,11 @@ private:
   bool mAvatarIsReadOnly = true;
 
   std::shared_ptr<linphone::Vcard> mVcard;
+
+  // Parsed and normalized sip addresses. Built on first access and reset by
+  // the sip address mutators.
+  mutable QVariantList mSipAddresses;
+  mutable bool mSipAddressesIsValid = false;
 };
 
 Q_DECLARE_METATYPE(VcardModel *);
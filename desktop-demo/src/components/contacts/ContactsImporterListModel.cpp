@@ -34,7 +34,6 @@ using namespace std;
 ContactsImporterListModel::ContactsImporterListModel (QObject *parent) : QAbstractListModel(parent) {
   // Init contacts with linphone friends list.
 	mMaxContactsImporterId = -1;
-	QQmlEngine *engine = App::getInstance()->getEngine();
 	auto config = CoreManager::getInstance()->getCore()->getConfig();
 	PluginsManager::getPlugins();// Initialize list
 // Read configuration file
@@ -56,7 +55,7 @@ ContactsImporterListModel::ContactsImporterListModel (QObject *parent) : QAbstra
 						ContactsImporterModel * model = new ContactsImporterModel(data, this);
 	// See: http://doc.qt.io/qt-5/qtqml-cppintegration-data.html#data-ownership
 	// The returned value must have a explicit parent or a QQmlEngine::CppOwnership.
-						engine->setObjectOwnership(model, QQmlEngine::CppOwnership);
+						QQmlEngine::setObjectOwnership(model, QQmlEngine::CppOwnership);
 						model->setIdentity(id);
 						model->loadConfiguration();// Read the configuration contacts inside the plugin
 						addContactsImporter(model);
@@ -137,7 +136,7 @@ ContactsImporterModel *ContactsImporterListModel::createContactsImporter(QVarian
 		if(dataInstance) {
 // get default values
 			contactsImporter = new ContactsImporterModel(dataInstance, this);
-			App::getInstance()->getEngine()->setObjectOwnership(contactsImporter, QQmlEngine::CppOwnership);
+			QQmlEngine::setObjectOwnership(contactsImporter, QQmlEngine::CppOwnership);
 			QVariantMap newData = ContactsImporterPluginsManager::getDefaultValues(data["pluginID"].toString());// Start with defaults from plugin
 			QVariantMap InstanceFields = contactsImporter->getFields();
 			for(auto field = InstanceFields.begin() ; field != InstanceFields.end() ; ++field)// Insert or Update with the defaults of an instance
@@ -176,6 +175,7 @@ void ContactsImporterListModel::removeContactsImporter (ContactsImporterModel *c
 			int id = contactsImporter->getIdentity();
 			string section = Utils::appStringToCoreString(PluginsManager::gPluginsConfigSection+"_"+QString::number(id)+"_"+QString::number(PluginDataAPI::CONTACTS));
 			CoreManager::getInstance()->getCore()->getConfig()->cleanSection(section);
+			contactsImporter->removeSyncState();
 			if( id == mMaxContactsImporterId)// Decrease mMaxContactsImporterId in a safe way
 				--mMaxContactsImporterId;
 		}
@@ -19,14 +19,19 @@
  */
 
 #include "ContactsImporterModel.hpp"
-#include "ContactsImporterPluginsManager.hpp"
+#include "ContactsImporterWorker.hpp"
 #include "../../utils/Utils.hpp"
+#include "app/paths/Paths.hpp"
+#include "components/contacts/ContactsListModel.hpp"
+#include "components/core/CoreManager.hpp"
 
 //#include <linphoneapp/contacts/ContactsImporterDataAPI.hpp>
 #include "include/LinphoneApp/PluginDataAPI.hpp"
 
 #include <QPluginLoader>
 #include <QDebug>
+#include <QFile>
+#include <QThread>
 
 // =============================================================================
 
@@ -39,6 +44,14 @@ ContactsImporterModel::ContactsImporterModel (PluginDataAPI * data, QObject *par
 	setDataAPI(data);
 }
 
+ContactsImporterModel::~ContactsImporterModel () {
+	if (mImportThread) {// The worker cannot outlive its receiver.
+		cancelImport();
+		mImportThread->quit();
+		mImportThread->wait();
+	}
+}
+
 // -----------------------------------------------------------------------------
 
 void ContactsImporterModel::setDataAPI(PluginDataAPI *data){
@@ -75,8 +88,12 @@ QVariantMap ContactsImporterModel::getFields(){
 }
 
 void ContactsImporterModel::setFields(const QVariantMap &pFields){
-	if( isUsable())
+	if( isUsable()){
+		const bool wasDeltaSync = isDeltaSync();
 		mData->setInputFields(PluginDataAPI::CONTACTS, pFields);
+		if(wasDeltaSync && !isDeltaSync())// The next sync must start from a full import.
+			removeSyncState();
+	}
 }
 
 int ContactsImporterModel::getIdentity()const{
@@ -111,9 +128,104 @@ void ContactsImporterModel::importContacts(){
 		qWarning() << "Cannot import contacts, mData is NULL or plugin cannot be loaded ";
 }
 
+void ContactsImporterModel::cancelImport(){
+	if(mImportWorker){
+		qInfo() << "Cancel contacts import at " << mImportedCount << "/" << mImportTotalCount;
+		mImportWorker->cancel();
+	}
+}
+
+bool ContactsImporterModel::isImporting() const{
+	return mImportThread != nullptr;
+}
+
+bool ContactsImporterModel::isDeltaSync() const{
+	return mData && mData->getInputFields(PluginDataAPI::CONTACTS)[PluginDataAPI::CONTACTS].value("deltaSync").toBool();
+}
+
+QString ContactsImporterModel::getSyncStateFilePath() const{
+	return Utils::coreStringToAppString(Paths::getContactsImportDirPath()) + QString::number(mIdentity) + ".sync";
+}
+
+void ContactsImporterModel::removeSyncState(){
+	if(mIdentity >= 0)
+		QFile::remove(getSyncStateFilePath());
+}
+
+int ContactsImporterModel::getImportedCount() const{
+	return mImportedCount;
+}
+
+int ContactsImporterModel::getImportTotalCount() const{
+	return mImportTotalCount;
+}
+
+ContactsListModel *ContactsImporterModel::getContactsListModel() const{
+	return mContactsListModel ? mContactsListModel : CoreManager::getInstance()->getContactsListModel();
+}
+
+void ContactsImporterModel::setContactsListModel(ContactsListModel *contactsListModel){
+	mContactsListModel = contactsListModel;
+}
+
+// Contacts are prepared in a worker thread and added by batches in order to keep the GUI responsive on big address books.
 void ContactsImporterModel::parsedContacts(const PluginDataAPI::PluginCapability& actionType,  QVector<QMultiMap<QString, QString> > contacts){
-	if(actionType == PluginDataAPI::CONTACTS)
-		ContactsImporterPluginsManager::importContacts(contacts);
+	if(actionType != PluginDataAPI::CONTACTS)
+		return;
+	if(mImportThread){
+		qWarning() << "A contacts import is already running, ignore " << contacts.size() << " contacts";
+		return;
+	}
+	mImportedCount = 0;
+	mImportTotalCount = contacts.size();
+	mImportThread = new QThread(this);
+	mImportWorker = new ContactsImporterWorker(contacts);
+	contacts.clear();
+	if(isDeltaSync())
+		mImportWorker->setSyncStateFilePath(getSyncStateFilePath());
+	mImportWorker->moveToThread(mImportThread);
+
+	connect(mImportThread, &QThread::started, mImportWorker, &ContactsImporterWorker::run);
+	connect(mImportWorker, &ContactsImporterWorker::batchReady, this, &ContactsImporterModel::applyContactsBatch);
+	connect(mImportWorker, &ContactsImporterWorker::finished, this, &ContactsImporterModel::handleImportFinished);
+	connect(mImportThread, &QThread::finished, mImportWorker, &QObject::deleteLater);
+
+	emit importingChanged(true);
+	emit importProgressChanged(mImportedCount, mImportTotalCount);
+	mImportTimer.start();
+	mImportThread->start(QThread::LowPriority);
+}
+
+void ContactsImporterModel::applyContactsBatch(
+	const QVector<ImportedContact> &added,
+	const QVector<ImportedContact> &updated,
+	const QVector<ImportedContact> &removed,
+	int processedCount,
+	int totalCount
+){
+	if(!mImportWorker || mImportWorker->isCanceled())
+		return;
+	ContactsListModel *contacts = getContactsListModel();
+	ContactsImporterWorker::ImportedVcards vcards;
+	if(!added.isEmpty())
+		vcards = ContactsImporterWorker::addContacts(contacts, added);
+	if(!updated.isEmpty())
+		vcards.unite(ContactsImporterWorker::updateContacts(contacts, updated));
+	if(!removed.isEmpty())
+		ContactsImporterWorker::removeContacts(contacts, removed);
+	mImportWorker->batchApplied(vcards);
+	mImportedCount = processedCount;
+	mImportTotalCount = totalCount;
+	emit importProgressChanged(mImportedCount, mImportTotalCount);
+}
+
+void ContactsImporterModel::handleImportFinished(bool canceled){
+	qInfo() << "Contacts import " << (canceled ? "canceled" : "done") << " : " << mImportedCount << "/" << mImportTotalCount << " in " << mImportTimer.elapsed() << "ms";
+	mImportThread->quit();
+	mImportThread->wait();
+	mImportThread->deleteLater();
+	mImportThread = nullptr;
+	emit importingChanged(false);
 }
 
 void ContactsImporterModel::updateInputs(const PluginDataAPI::PluginCapability& capability, const QVariantMap &inputs){
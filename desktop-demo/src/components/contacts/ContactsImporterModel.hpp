@@ -21,7 +21,10 @@
 #ifndef CONTACTS_IMPORTER_MODEL_H_
 #define CONTACTS_IMPORTER_MODEL_H_
 
+#include <QElapsedTimer>
+#include <QHash>
 #include <QObject>
+#include <QPointer>
 #include <QVariantMap>
 
 #include "utils/plugins/PluginsManager.hpp"
@@ -29,14 +32,24 @@
 
 // =============================================================================
 
+class ContactsImporterWorker;
+class ContactsListModel;
+class QThread;
+struct ImportedContact;
+
 class ContactsImporterModel : public PluginsModel {
 	Q_OBJECT
 
 	Q_PROPERTY(QVariantMap fields READ getFields WRITE setFields NOTIFY fieldsChanged)
 	Q_PROPERTY(int identity READ getIdentity WRITE setIdentity NOTIFY identityChanged)
+	Q_PROPERTY(bool importing READ isImporting NOTIFY importingChanged)
+	Q_PROPERTY(int importedCount READ getImportedCount NOTIFY importProgressChanged)
+	Q_PROPERTY(int importTotalCount READ getImportTotalCount NOTIFY importProgressChanged)
+	Q_PROPERTY(bool deltaSync READ isDeltaSync NOTIFY fieldsChanged)
 
 public:
 	ContactsImporterModel (PluginDataAPI * data, QObject *parent = nullptr);
+	~ContactsImporterModel ();
 
 	void setDataAPI(PluginDataAPI *data);
 	PluginDataAPI *getDataAPI();
@@ -50,6 +63,16 @@ public:
 	
 	void loadConfiguration();
 	Q_INVOKABLE void importContacts();
+	Q_INVOKABLE void cancelImport();	// Stop the current import. Contacts that have already been added are kept.
+
+	bool isImporting() const;
+	bool isDeltaSync() const;	// Only apply the differences with the previous import. Enabled by the `deltaSync` field.
+	QString getSyncStateFilePath() const;
+	void removeSyncState();
+	int getImportedCount() const;
+	int getImportTotalCount() const;
+	ContactsListModel *getContactsListModel() const;
+	void setContactsListModel(ContactsListModel *contactsListModel);	// Receive the imported contacts. The contacts of the application by default.
 
 public slots:
 	void parsedContacts(const PluginDataAPI::PluginCapability& actionType, QVector<QMultiMap<QString, QString> > contacts);
@@ -61,10 +84,28 @@ signals:
 	void identityChanged(int identity);
 	void errorMessage(const QString& message);
 	void statusMessage(const QString& message);
+	void importingChanged(bool importing);
+	void importProgressChanged(int importedCount, int totalCount);
 	
 private:
+	void applyContactsBatch(
+		const QVector<ImportedContact> &added,
+		const QVector<ImportedContact> &updated,
+		const QVector<ImportedContact> &removed,
+		int processedCount,
+		int totalCount
+	);
+	void handleImportFinished(bool canceled);
+
 	int mIdentity;	// The identity of the model in configuration. It must be unique between all contact plugins.
 	PluginDataAPI *mData;	// The instance of the plugin with its plugin Loader.
+
+	ContactsListModel *mContactsListModel = nullptr;
+	QThread *mImportThread = nullptr;
+	QPointer<ContactsImporterWorker> mImportWorker;	// Live in `mImportThread`.
+	int mImportedCount = 0;
+	int mImportTotalCount = 0;
+	QElapsedTimer mImportTimer;
 };
 
 Q_DECLARE_METATYPE(ContactsImporterModel *);
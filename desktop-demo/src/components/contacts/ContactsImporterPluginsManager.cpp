@@ -28,7 +28,6 @@
 #include "components/contacts/ContactsListModel.hpp"
 #include "components/contacts/ContactsImporterListModel.hpp"
 #include "components/core/CoreManager.hpp"
-#include "components/sip-addresses/SipAddressesModel.hpp"
 
 
 #include <QDir>
@@ -82,36 +81,3 @@ void ContactsImporterPluginsManager::importContacts(ContactsImporterModel * mode
 			qWarning() << "Error : Cannot import contacts : pluginID is empty";
 	}
 }
-
-void ContactsImporterPluginsManager::importContacts(const QVector<QMultiMap<QString, QString> >& pContacts ){
-	for(int i = 0 ; i < pContacts.size() ; ++i){
-		VcardModel  * card = CoreManager::getInstance()->createDetachedVcardModel();
-		SipAddressesModel * sipConvertion = CoreManager::getInstance()->getSipAddressesModel();
-		QString domain = pContacts[i].values("sipDomain").at(0);
-		//if(pContacts[i].contains("phoneNumber"))
-		//	card->addSipAddress(sipConvertion->interpretSipAddress(pContacts[i].values("phoneNumber").at(0)+"@"+domain, false));
-		if(pContacts[i].contains("displayName")  && pContacts[i].values("displayName").size() > 0)
-			card->setUsername(pContacts[i].values("displayName").at(0));
-		if(pContacts[i].contains("sipUsername") && pContacts[i].values("sipUsername").size() > 0){
-			QString sipUsername = pContacts[i].values("sipUsername").at(0);
-			QString convertedUsername = sipConvertion->interpretSipAddress(sipUsername, domain);
-			if(!convertedUsername.contains(domain)){
-				convertedUsername = convertedUsername.replace('@',"%40")+"@"+domain;
-			}
-			card->addSipAddress(convertedUsername);
-			if( sipUsername.contains('@')){
-				card->addEmail(sipUsername);
-			}
-		}
-		if(pContacts[i].contains("email"))
-			for(auto email : pContacts[i].values("email"))
-				card->addEmail(email);
-		if(pContacts[i].contains("organization"))
-			for(auto company : pContacts[i].values("organization"))
-				card->addCompany(company);
-		if( card->getSipAddresses().size()>0){
-			CoreManager::getInstance()->getContactsListModel()->addContact(card);
-		}else
-			delete card;
-	}
-}
@@ -41,7 +41,6 @@ public:
 	Q_INVOKABLE static QVariantList getPlugins();	// Get a list of all available plugins
 	Q_INVOKABLE static QVariantMap getContactsImporterPluginDescription(const QString& pluginID);	// Get the description of the plugin. It is used for GUI to create dynamically items
 	Q_INVOKABLE static void importContacts(ContactsImporterModel * model);	// Request the import of the model
-	static void importContacts(const QVector<QMultiMap<QString, QString> >& contacts );	// Merge these data into contacts
 
 };
 
@@ -0,0 +1,400 @@
+/*
+ * Copyright (c) 2010-2020 Belledonne Communications SARL.
+ *
+ * This file is part of linphone-desktop
+ * (see https://www.linphone.org).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ContactsImporterWorker.hpp"
+
+#include <linphone++/linphone.hh>
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDebug>
+#include <QFile>
+#include <QSaveFile>
+#include <QSet>
+
+#include "components/contact/ContactModel.hpp"
+#include "components/contact/VcardModel.hpp"
+#include "components/contacts/ContactsListModel.hpp"
+#include "utils/Utils.hpp"
+
+// =============================================================================
+
+namespace {
+	constexpr quint32 SyncStateMagic = 0x4c435353;// "LCSS"
+	constexpr quint32 SyncStateVersion = 3;
+
+	void addSortedValues (QCryptographicHash &hash, const QVariantList &values) {
+		QStringList strings;
+		for (const auto &value : values)
+			strings << value.toString();
+		strings.sort();
+		strings.removeDuplicates();
+		hash.addData(strings.join(QLatin1Char('\n')).toUtf8());
+		hash.addData("\0", 1);
+	}
+}
+
+ContactsImporterWorker::ContactsImporterWorker (const QVector<QMultiMap<QString, QString> > &contacts, QObject *parent) : QObject(parent), mPendingBatches(MaxPendingBatches) {
+	qRegisterMetaType<QVector<ImportedContact> >();
+	mContacts = contacts;
+}
+
+void ContactsImporterWorker::setSyncStateFilePath (const QString &path) {
+	mSyncStateFilePath = path;
+}
+
+void ContactsImporterWorker::cancel () {
+	mCanceled.storeRelease(1);
+	mPendingBatches.release(MaxPendingBatches);// Wake up the worker if it waits for the GUI.
+}
+
+bool ContactsImporterWorker::isCanceled () const {
+	return mCanceled.loadAcquire() != 0;
+}
+
+void ContactsImporterWorker::batchApplied (const ImportedVcards &vcards) {
+	if (!vcards.isEmpty()) {
+		QMutexLocker locker(&mImportedVcardsMutex);
+		mImportedVcards.unite(vcards);
+	}
+	mPendingBatches.release();
+}
+
+bool ContactsImporterWorker::waitForReceiver () {
+	mPendingBatches.acquire();
+	return !isCanceled();
+}
+
+// -----------------------------------------------------------------------------
+
+// Keep only the first value of single-valued keys, trim everything and check mandatory fields.
+bool ContactsImporterWorker::prepareContact (QMultiMap<QString, QString> &contact) {
+	QMultiMap<QString, QString> prepared;
+	for (const char *key : { "displayName", "sipUsername", "sipDomain" }) {
+		const QString value = contact.value(key).trimmed();
+		if (!value.isEmpty())
+			prepared.insert(key, value);
+	}
+	if (!prepared.contains("sipUsername") || !prepared.contains("sipDomain"))
+		return false;
+	for (const char *key : { "email", "organization" }) {
+		const QStringList values = contact.values(key);
+		for (auto it = values.crbegin(); it != values.crend(); ++it) {// Keep insertion order.
+			const QString value = it->trimmed();
+			if (!value.isEmpty())
+				prepared.insert(key, value);
+		}
+	}
+	contact = prepared;
+	return true;
+}
+
+// -----------------------------------------------------------------------------
+
+// The source identifies a contact by its username and its domain. This key is not interpreted:
+// interpreting an address needs the core.
+QString ContactsImporterWorker::getSyncKey (const QMultiMap<QString, QString> &contact) {
+	return contact.value("sipUsername") + QLatin1Char('\n') + contact.value("sipDomain").toLower();
+}
+
+// The username is normalized with the domain of the source: `sip:username@domain`. A username that
+// is already an address of another domain is escaped into the source domain.
+QString ContactsImporterWorker::getSipAddress (const QMultiMap<QString, QString> &fields) {
+	const QString sipUsername = fields.value("sipUsername");
+	const QString domain = fields.value("sipDomain");
+	if (sipUsername.isEmpty())
+		return QString("");
+	QString uri = sipUsername;
+	if (!uri.startsWith("sip:", Qt::CaseInsensitive) && !uri.startsWith("sips:", Qt::CaseInsensitive))
+		uri = QStringLiteral("sip:") + (uri.contains('@') ? uri : uri + "@" + domain);
+	std::shared_ptr<linphone::Address> address = linphone::Factory::get()->createAddress(Utils::appStringToCoreString(uri));
+	if (!address || address->getUsername().empty())
+		return QString("");
+	QString sipAddress = Utils::coreStringToAppString(address->asStringUriOnly());
+	if (!sipAddress.contains(domain))
+		sipAddress = sipAddress.replace('@', "%40") + "@" + domain;
+	return sipAddress;
+}
+
+VcardModel *ContactsImporterWorker::createVcardModel (const QMultiMap<QString, QString> &fields) {
+	const QString sipAddress = getSipAddress(fields);
+	if (sipAddress.isEmpty())
+		return nullptr;
+	VcardModel *card = new VcardModel(linphone::Factory::get()->createVcard(), false);
+	if (fields.contains("displayName"))
+		card->setUsername(fields.value("displayName"));
+	const QString sipUsername = fields.value("sipUsername");
+	card->addInterpretedSipAddress(sipAddress);
+	if (sipUsername.contains('@'))
+		card->addEmail(sipUsername);
+	for (const auto &email : fields.values("email"))
+		card->addEmail(email);
+	for (const auto &company : fields.values("organization"))
+		card->addCompany(company);
+	if (card->getSipAddresses().isEmpty()) {
+		delete card;
+		return nullptr;
+	}
+	return card;
+}
+
+// -----------------------------------------------------------------------------
+
+// Only the fields set by `createVcardModel` are used. The order of the values doesn't matter.
+QByteArray ContactsImporterWorker::getFingerprint (const VcardModel *vcardModel) {
+	QCryptographicHash hash(QCryptographicHash::Sha1);
+	hash.addData(vcardModel->getUsername().toUtf8());
+	hash.addData("\0", 1);
+	addSortedValues(hash, vcardModel->getSipAddresses());
+	addSortedValues(hash, vcardModel->getEmails());
+	addSortedValues(hash, vcardModel->getCompanies());
+	return hash.result();
+}
+
+ContactsImporterWorker::ImportedVcard ContactsImporterWorker::getImportedVcard (const VcardModel *vcardModel) {
+	return qMakePair(vcardModel->getSipAddresses().value(0).toString(), getFingerprint(vcardModel));
+}
+
+// -----------------------------------------------------------------------------
+
+ContactsImporterWorker::ImportedVcards ContactsImporterWorker::addContacts (ContactsListModel *contacts, const QVector<ImportedContact> &added) {
+	ImportedVcards vcards;
+	QList<VcardModel *> cards;
+	int skippedCount = 0;
+	for (const ImportedContact &imported : added) {
+		VcardModel *card = createVcardModel(imported.fields);
+		if (!card) {
+			++skippedCount;
+			continue;
+		}
+		vcards.insert(imported.syncKey, getImportedVcard(card));// Before a merge.
+		cards << card;
+	}
+	if (skippedCount > 0)
+		qWarning() << QStringLiteral("%1 contact(s) without valid sip address have been skipped.").arg(skippedCount);
+	if (!cards.isEmpty())
+		contacts->addContacts(cards);
+	return vcards;
+}
+
+ContactsImporterWorker::ImportedVcards ContactsImporterWorker::updateContacts (ContactsListModel *contacts, const QVector<ImportedContact> &updated) {
+	const QHash<QString, ContactModel *> contactsBySipAddress = contacts->getContactsBySipAddress();
+	ImportedVcards vcards;
+	QVector<ImportedContact> newContacts;
+	int keptCount = 0;
+	for (const ImportedContact &imported : updated) {
+		ContactModel *contact = contactsBySipAddress.value(imported.previousVcard.first);
+		if (!contact) {// Removed locally: add it again.
+			newContacts << imported;
+			continue;
+		}
+		// Edited or merged by the user: keep it, and keep the previous vcard in the sync state.
+		if (getFingerprint(contact->getVcardModel()) != imported.previousVcard.second) {
+			vcards.insert(imported.syncKey, imported.previousVcard);
+			++keptCount;
+			continue;
+		}
+		VcardModel *card = createVcardModel(imported.fields);
+		if (!card)
+			continue;
+		vcards.insert(imported.syncKey, getImportedVcard(card));
+		if (card->getAvatar().isEmpty())
+			card->setAvatar(contact->getVcardModel()->getAvatar());
+		contact->setVcardModel(card);
+	}
+	if (keptCount > 0)
+		qInfo() << QStringLiteral("%1 contact(s) changed in the source have been kept because they have been modified.").arg(keptCount);
+	vcards.unite(addContacts(contacts, newContacts));
+	return vcards;
+}
+
+void ContactsImporterWorker::removeContacts (ContactsListModel *contacts, const QVector<ImportedContact> &removed) {
+	const QHash<QString, ContactModel *> contactsBySipAddress = contacts->getContactsBySipAddress();
+	QSet<ContactModel *> toRemove;// A contact can have several removed addresses.
+	int keptCount = 0;
+	for (const ImportedContact &imported : removed) {
+		ContactModel *contact = contactsBySipAddress.value(imported.previousVcard.first);
+		if (!contact)
+			continue;
+		// Edited or merged by the user: it is not the imported contact anymore.
+		if (getFingerprint(contact->getVcardModel()) == imported.previousVcard.second)
+			toRemove.insert(contact);
+		else
+			++keptCount;
+	}
+	if (keptCount > 0)
+		qInfo() << QStringLiteral("%1 contact(s) removed from the source have been kept because they have been modified.").arg(keptCount);
+	for (ContactModel *contact : toRemove)
+		contacts->removeContact(contact);
+}
+
+QByteArray ContactsImporterWorker::getSyncHash (const QMultiMap<QString, QString> &contact) {
+	QCryptographicHash hash(QCryptographicHash::Sha1);
+	for (auto it = contact.cbegin(); it != contact.cend(); ++it) {// Sorted by key.
+		hash.addData(it.key().toUtf8());
+		hash.addData("=", 1);
+		hash.addData(it.value().toUtf8());
+		hash.addData("\n", 1);
+	}
+	return hash.result();
+}
+
+ContactsImporterWorker::SyncState ContactsImporterWorker::loadSyncState () const {
+	SyncState state;
+	QFile file(mSyncStateFilePath);
+	if (!file.exists())
+		return state;
+	if (!file.open(QIODevice::ReadOnly)) {
+		qWarning() << QStringLiteral("Unable to read contacts sync state: `%1`.").arg(mSyncStateFilePath);
+		return state;
+	}
+
+	QDataStream stream(&file);
+	quint32 magic, version;
+	stream >> magic >> version;
+	if (magic != SyncStateMagic || version != SyncStateVersion) {
+		qWarning() << QStringLiteral("Ignore incompatible contacts sync state: `%1`.").arg(mSyncStateFilePath);
+		return state;
+	}
+	stream.setVersion(QDataStream::Qt_5_0);
+	stream >> state;
+	if (stream.status() != QDataStream::Ok) {
+		qWarning() << QStringLiteral("Ignore corrupted contacts sync state: `%1`.").arg(mSyncStateFilePath);
+		state.clear();
+	}
+	return state;
+}
+
+void ContactsImporterWorker::saveSyncState (const SyncState &state) const {
+	QSaveFile file(mSyncStateFilePath);
+	if (!file.open(QIODevice::WriteOnly)) {
+		qWarning() << QStringLiteral("Unable to write contacts sync state: `%1`.").arg(mSyncStateFilePath);
+		return;
+	}
+
+	QDataStream stream(&file);
+	stream << SyncStateMagic << SyncStateVersion;
+	stream.setVersion(QDataStream::Qt_5_0);
+	stream << state;
+	if (!file.commit())
+		qWarning() << QStringLiteral("Unable to write contacts sync state: `%1`.").arg(mSyncStateFilePath);
+}
+
+// -----------------------------------------------------------------------------
+
+void ContactsImporterWorker::run () {
+	const bool sync = !mSyncStateFilePath.isEmpty();
+	SyncState previousState = sync ? loadSyncState() : SyncState();
+	QHash<QString, QByteArray> hashes;	// Sync key => hash, of the contacts given to the receiver.
+	SyncState state;
+
+	const int total = mContacts.size();
+	int processed = 0;
+	int skipped = 0;
+	int unchanged = 0;
+	int updatedCount = 0;
+
+	while (processed < total && !isCanceled()) {
+		QVector<ImportedContact> added, updated;
+		for (; processed < total && added.size() + updated.size() < BatchSize; ++processed) {
+			QMultiMap<QString, QString> &contact = mContacts[processed];
+			if (!prepareContact(contact)) {
+				++skipped;
+				contact.clear();
+				continue;
+			}
+
+			ImportedContact imported;
+			imported.syncKey = getSyncKey(contact);
+			bool isUpdate = false;
+			if (sync) {
+				const QByteArray hash = getSyncHash(contact);
+				auto it = previousState.find(imported.syncKey);
+				if (it != previousState.end()) {
+					const bool isUnchanged = it.value().first == hash;
+					if (isUnchanged)
+						state.insert(imported.syncKey, it.value());
+					else
+						imported.previousVcard = it.value().second;
+					previousState.erase(it);
+					if (isUnchanged) {
+						++unchanged;
+						contact.clear();
+						continue;
+					}
+					isUpdate = true;
+				}
+				hashes.insert(imported.syncKey, hash);
+			}
+
+			imported.fields.swap(contact);
+			if (isUpdate) {
+				updated << imported;
+				++updatedCount;
+			} else
+				added << imported;
+		}
+
+		if (!waitForReceiver())
+			break;
+		emit batchReady(added, updated, QVector<ImportedContact>(), processed, total);
+	}
+	mContacts.clear();
+
+	// Remaining entries of the previous state are not in the source anymore.
+	const int removedCount = previousState.size();
+	for (auto it = previousState.cbegin(); it != previousState.cend() && !isCanceled(); ) {
+		QVector<ImportedContact> removed;
+		for (; it != previousState.cend() && removed.size() < BatchSize; ++it) {
+			ImportedContact imported;
+			imported.syncKey = it.key();
+			imported.previousVcard = it.value().second;
+			removed << imported;
+		}
+
+		if (!waitForReceiver())
+			break;
+		emit batchReady(QVector<ImportedContact>(), QVector<ImportedContact>(), removed, processed, total);
+	}
+
+	if (skipped > 0)
+		qWarning() << QStringLiteral("%1 contact(s) without sip username or domain have been skipped.").arg(skipped);
+
+	if (sync) {
+		// Save the state only when everything has been applied.
+		bool applied = true;
+		for (int i = 0; i < MaxPendingBatches && applied; ++i)
+			applied = waitForReceiver();
+		if (applied) {
+			qInfo() << QStringLiteral("Contacts sync: %1 unchanged, %2 updated, %3 removed.")
+				.arg(unchanged).arg(updatedCount).arg(removedCount);
+			// A contact without vcard could not be interpreted by the receiver: it is given again next time.
+			QMutexLocker locker(&mImportedVcardsMutex);
+			for (auto it = hashes.cbegin(); it != hashes.cend(); ++it) {
+				auto vcard = mImportedVcards.constFind(it.key());
+				if (vcard != mImportedVcards.cend())
+					state.insert(it.key(), qMakePair(it.value(), vcard.value()));
+			}
+			saveSyncState(state);
+		}
+	}
+
+	emit finished(isCanceled());
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2010-2020 Belledonne Communications SARL.
+ *
+ * This file is part of linphone-desktop
+ * (see https://www.linphone.org).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CONTACTS_IMPORTER_WORKER_H_
+#define CONTACTS_IMPORTER_WORKER_H_
+
+#include <QAtomicInt>
+#include <QHash>
+#include <QMultiMap>
+#include <QMutex>
+#include <QObject>
+#include <QPair>
+#include <QSemaphore>
+#include <QStringList>
+#include <QVector>
+
+// =============================================================================
+
+class ContactsListModel;
+class VcardModel;
+
+// A contact given by a plugin, checked and trimmed by the worker. Its vcard is created by the
+// receiver in the GUI thread: the core cannot be used from the worker.
+struct ImportedContact {
+	QString syncKey;	// Identify the contact of the source between two imports.
+	QMultiMap<QString, QString> fields;	// Empty for a removed contact.
+	// For an updated or a removed contact: the sip address and the fingerprint of the vcard given by
+	// the previous import.
+	QPair<QString, QByteArray> previousVcard;
+};
+
+Q_DECLARE_METATYPE(ImportedContact);
+
+// Prepare contacts received from a plugin outside the GUI thread and give them back by batches.
+// The worker only handles plain data. At most `MaxPendingBatches` batches can wait to be applied:
+// `batchApplied` must be called by the receiver after each `batchReady`.
+//
+// If a sync state file is set, only the differences with the previous import are given back. The
+// receiver reports the vcards it created with `batchApplied`, and the state file is written only
+// when every batch has been applied.
+class ContactsImporterWorker : public QObject {
+	Q_OBJECT
+
+public:
+	// The sip address and the fingerprint of a vcard created for an imported contact.
+	typedef QPair<QString, QByteArray> ImportedVcard;
+	// Sync key => vcard.
+	typedef QHash<QString, ImportedVcard> ImportedVcards;
+
+	ContactsImporterWorker (const QVector<QMultiMap<QString, QString> > &contacts, QObject *parent = nullptr);
+
+	void setSyncStateFilePath (const QString &path);	// Must be set before `run`.
+
+	void cancel ();	// Can be called from any thread.
+	bool isCanceled () const;
+
+	void batchApplied (const ImportedVcards &vcards = ImportedVcards());	// Can be called from any thread.
+
+	static constexpr int BatchSize = 500;
+	static constexpr int MaxPendingBatches = 2;
+
+public slots:
+	void run ();
+
+signals:
+	// Without sync state, all contacts are given in `added`.
+	void batchReady (
+		QVector<ImportedContact> added,
+		QVector<ImportedContact> updated,
+		QVector<ImportedContact> removed,
+		int processedCount,
+		int totalCount
+	);
+	void finished (bool canceled);
+
+public:
+	// GUI thread: they use the core.
+	static QString getSipAddress (const QMultiMap<QString, QString> &fields);	// Empty if it cannot be interpreted.
+	static VcardModel *createVcardModel (const QMultiMap<QString, QString> &fields);	// Null if the contact has no valid sip address.
+	// Identify the content of a vcard: a contact changed by the user since its import has another fingerprint.
+	static QByteArray getFingerprint (const VcardModel *vcardModel);
+	static ImportedVcard getImportedVcard (const VcardModel *vcardModel);	// First sip address and fingerprint.
+
+	// GUI thread: apply a batch to `contacts`. Return the vcards given to the contacts, by sync key.
+	static ImportedVcards addContacts (ContactsListModel *contacts, const QVector<ImportedContact> &added);	// Merge the new vcards into the contacts.
+	// Replace the vcards of the previous import, only if the contacts still have them (same fingerprint).
+	static ImportedVcards updateContacts (ContactsListModel *contacts, const QVector<ImportedContact> &updated);
+	// Remove the contacts of the previous import, only if they still have the vcards given by the import (same fingerprint).
+	static void removeContacts (ContactsListModel *contacts, const QVector<ImportedContact> &removed);
+
+private:
+	// Sync key => (hash of the source contact, vcard).
+	typedef QHash<QString, QPair<QByteArray, ImportedVcard> > SyncState;
+
+	static bool prepareContact (QMultiMap<QString, QString> &contact);	// Return false if the contact cannot be imported.
+	static QString getSyncKey (const QMultiMap<QString, QString> &contact);
+	static QByteArray getSyncHash (const QMultiMap<QString, QString> &contact);
+
+	SyncState loadSyncState () const;
+	void saveSyncState (const SyncState &state) const;
+
+	bool waitForReceiver ();	// Return false if canceled.
+
+	QVector<QMultiMap<QString, QString> > mContacts;
+	QString mSyncStateFilePath;
+	QAtomicInt mCanceled = 0;
+	QSemaphore mPendingBatches;
+
+	QMutex mImportedVcardsMutex;
+	ImportedVcards mImportedVcards;	// Reported by the receiver.
+};
+
+#endif // CONTACTS_IMPORTER_WORKER_H_
@@ -31,8 +31,11 @@
 
 using namespace std;
 
-ContactsListModel::ContactsListModel (QObject *parent) : QAbstractListModel(parent) {
-  mLinphoneFriends = CoreManager::getInstance()->getCore()->getFriendsLists().front();
+ContactsListModel::ContactsListModel (QObject *parent) :
+  ContactsListModel(CoreManager::getInstance()->getCore()->getFriendsLists().front(), parent) {}
+
+ContactsListModel::ContactsListModel (const shared_ptr<linphone::FriendList> &linphoneFriends, QObject *parent) : QAbstractListModel(parent) {
+  mLinphoneFriends = linphoneFriends;
   // Clean friends.
   {
     list<shared_ptr<linphone::Friend>> toRemove;
@@ -48,13 +51,12 @@ ContactsListModel::ContactsListModel (QObject *parent) : QAbstractListModel(pare
   }
 
   // Init contacts with linphone friends list.
-  QQmlEngine *engine = App::getInstance()->getEngine();
   for (const auto &linphoneFriend : mLinphoneFriends->getFriends()) {
     ContactModel *contact = new ContactModel(this, linphoneFriend);
 
     // See: http://doc.qt.io/qt-5/qtqml-cppintegration-data.html#data-ownership
     // The returned value must have a explicit parent or a QQmlEngine::CppOwnership.
-    engine->setObjectOwnership(contact, QQmlEngine::CppOwnership);
+    QQmlEngine::setObjectOwnership(contact, QQmlEngine::CppOwnership);
 
     addContact(contact);
   }
@@ -124,6 +126,16 @@ ContactModel *ContactsListModel::findContactModelFromUsername (const QString &us
   return it != mList.end() ? *it : nullptr;
 }
 
+QHash<QString, ContactModel *> ContactsListModel::getContactsBySipAddress () const {
+  QHash<QString, ContactModel *> contacts;
+  contacts.reserve(mList.count());
+  for (ContactModel *contact : mList)
+    for (const auto &sipAddress : contact->getVcardModel()->getSipAddresses())
+      if (!contacts.contains(sipAddress.toString())) // Same result as `findContactModelFromSipAddress`.
+        contacts.insert(sipAddress.toString(), contact);
+  return contacts;
+}
+
 // -----------------------------------------------------------------------------
 
 ContactModel *ContactsListModel::addContact (VcardModel *vcardModel) {
@@ -135,7 +147,7 @@ ContactModel *ContactsListModel::addContact (VcardModel *vcardModel) {
   }
 
   contact = new ContactModel(this, vcardModel);
-  App::getInstance()->getEngine()->setObjectOwnership(contact, QQmlEngine::CppOwnership);
+  QQmlEngine::setObjectOwnership(contact, QQmlEngine::CppOwnership);
 
   if (mLinphoneFriends->addFriend(contact->mLinphoneFriend) != linphone::FriendList::Status::OK) {
     qWarning() << QStringLiteral("Unable to add contact from vcard:") << vcardModel;
@@ -159,6 +171,60 @@ ContactModel *ContactsListModel::addContact (VcardModel *vcardModel) {
   return contact;
 }
 
+void ContactsListModel::addContacts (const QList<VcardModel *> &vcardModels) {
+  QList<ContactModel *> contacts;
+
+  // Usernames are decoded once per batch, not once per vcard and contact.
+  QHash<QString, ContactModel *> contactsByUsername;
+  contactsByUsername.reserve(mList.count());
+  for (ContactModel *contact : mList) {
+    const QString username = contact->getVcardModel()->getUsername();
+    if (!contactsByUsername.contains(username)) // Same result as `findContactModelFromUsername`.
+      contactsByUsername.insert(username, contact);
+  }
+
+  for (VcardModel *vcardModel : vcardModels) {
+    const QString username = vcardModel->getUsername();
+
+    // Try to merge vcardModel to an existing contact, or to a contact of this batch.
+    ContactModel *contact = contactsByUsername.value(username);
+    if (contact) {
+      contact->mergeVcardModel(vcardModel);
+      continue;
+    }
+
+    contact = new ContactModel(this, vcardModel);
+    QQmlEngine::setObjectOwnership(contact, QQmlEngine::CppOwnership);
+
+    if (mLinphoneFriends->addFriend(contact->mLinphoneFriend) != linphone::FriendList::Status::OK) {
+      qWarning() << QStringLiteral("Unable to add contact from vcard:") << vcardModel;
+      delete contact;
+      continue;
+    }
+
+    contactsByUsername.insert(username, contact);
+    contacts << contact;
+  }
+
+  if (contacts.isEmpty())
+    return;
+
+  qInfo() << QStringLiteral("Add %1 contacts from vcards.").arg(contacts.count());
+
+  // Make sure new subscribe is issued.
+  mLinphoneFriends->updateSubscriptions();
+
+  int row = mList.count();
+
+  beginInsertRows(QModelIndex(), row, row + contacts.count() - 1);
+  for (ContactModel *contact : contacts)
+    addContact(contact);
+  endInsertRows();
+
+  for (ContactModel *contact : contacts)
+    emit contactAdded(contact);
+}
+
 void ContactsListModel::removeContact (ContactModel *contact) {
   qInfo() << QStringLiteral("Removing contact:") << contact;
 
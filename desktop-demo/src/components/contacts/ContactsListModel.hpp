@@ -40,7 +40,8 @@ class ContactsListModel : public QAbstractListModel {
   Q_OBJECT;
 
 public:
-  ContactsListModel (QObject *parent = Q_NULLPTR);
+  ContactsListModel (QObject *parent = Q_NULLPTR); // With the friends list of the core.
+  ContactsListModel (const std::shared_ptr<linphone::FriendList> &linphoneFriends, QObject *parent = Q_NULLPTR);
 
   int rowCount (const QModelIndex &index = QModelIndex()) const override;
 
@@ -52,8 +53,10 @@ public:
 
   ContactModel *findContactModelFromSipAddress (const QString &sipAddress) const;
   ContactModel *findContactModelFromUsername (const QString &username) const;
+  QHash<QString, ContactModel *> getContactsBySipAddress () const; // To find many contacts without scanning the list each time.
 
   Q_INVOKABLE ContactModel *addContact (VcardModel *vcardModel);
+  void addContacts (const QList<VcardModel *> &vcardModels); // Same as `addContact` but with one insertion for all new contacts.
   Q_INVOKABLE void removeContact (ContactModel *contact);
 
   Q_INVOKABLE void cleanAvatars ();
@@ -18,6 +18,7 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <QElapsedTimer>
 #include <QMutex>
 #include <QtDebug>
 #include <QThread>
@@ -42,11 +43,91 @@ using namespace std;
 
 CoreHandlers::CoreHandlers (CoreManager *coreManager) {
     Q_UNUSED(coreManager)
+    mProfiler = new CoreHandlersProfiler(this);
 }
 
 CoreHandlers::~CoreHandlers () {
 }
 
+// -----------------------------------------------------------------------------
+// Dispatch of the core events.
+// -----------------------------------------------------------------------------
+
+void CoreHandlers::dispatch (const char *callback, const function<void()> &handler) {
+  CoreManager *coreManager = CoreManager::getInstance();
+  if (coreManager)
+    coreManager->notifyCoreActivity();
+
+  if (!mProfiler->isEnabled()) {
+    handler();
+    return;
+  }
+
+  QElapsedTimer timer;
+  timer.start();
+  handler();
+  mProfiler->record(callback, timer.nsecsElapsed());
+}
+
+// -----------------------------------------------------------------------------
+// Keyed events.
+// -----------------------------------------------------------------------------
+
+ChatRoomEvents *CoreHandlers::getChatRoomEvents (const shared_ptr<linphone::ChatRoom> &chatRoom, QObject *receiver) {
+  return getEvents(mChatRoomEvents, chatRoom, receiver);
+}
+
+CallEvents *CoreHandlers::getCallEvents (const shared_ptr<linphone::Call> &call, QObject *receiver) {
+  return getEvents(mCallEvents, call, receiver);
+}
+
+template<typename Events, typename Key>
+Events *CoreHandlers::getEvents (QHash<const Key *, Events *> &events, const shared_ptr<Key> &key, QObject *receiver) {
+  const Key *rawKey = key.get();
+  Events *keyEvents = events.value(rawKey);
+  if (!keyEvents) {
+    keyEvents = new Events(key, this);
+    events.insert(rawKey, keyEvents);
+  }
+
+  ++keyEvents->mReceiverCount;
+  QObject::connect(receiver, &QObject::destroyed, keyEvents, [&events, rawKey, keyEvents] {
+    if (--keyEvents->mReceiverCount == 0) {
+      events.remove(rawKey);
+      keyEvents->deleteLater();
+    }
+  });
+
+  return keyEvents;
+}
+
+// Find the chat rooms of the peer once per local address, not once per chat model.
+void CoreHandlers::emitCallEnded (const shared_ptr<linphone::Call> &call) {
+  if (mChatRoomEvents.isEmpty())
+    return;
+
+  shared_ptr<linphone::Core> core = CoreManager::getInstance()->getCore();
+  const shared_ptr<const linphone::Address> remoteAddress = call->getRemoteAddress();
+
+  QList<shared_ptr<const linphone::Address>> localAddresses;
+  for (const ChatRoomEvents *events : mChatRoomEvents) {
+    shared_ptr<const linphone::Address> localAddress = events->mChatRoom->getLocalAddress();
+    bool found = false;
+    for (const auto &address : localAddresses)
+      if ((found = address->weakEqual(localAddress)))
+        break;
+    if (!found)
+      localAddresses << localAddress;
+  }
+
+  for (const auto &localAddress : localAddresses) {
+    shared_ptr<linphone::ChatRoom> chatRoom = core->findChatRoom(remoteAddress, localAddress);
+    ChatRoomEvents *events = chatRoom ? mChatRoomEvents.value(chatRoom.get()) : nullptr;
+    if (events)
+      emit events->callEnded(call);
+  }
+}
+
 // -----------------------------------------------------------------------------
 void CoreHandlers::onAuthenticationRequested (
   const shared_ptr<linphone::Core> & core,
@@ -56,7 +137,7 @@ void CoreHandlers::onAuthenticationRequested (
   Q_UNUSED(core)
   Q_UNUSED(method)
   if( authInfo ) {
-      emit authenticationRequested(authInfo);
+      dispatch(__func__, [=] { emit authenticationRequested(authInfo); });
   }
 }
 
@@ -67,7 +148,11 @@ void CoreHandlers::onCallEncryptionChanged (
   const string &
 ) {
     qInfo() << "onCallEncryptionChanged" << Utils::coreStringToAppString(call->getDiversionAddress()->asString());
-  emit callEncryptionChanged(call);
+  dispatch(__func__, [=] {
+    emit callEncryptionChanged(call);
+    if (CallEvents *events = mCallEvents.value(call.get()))
+      emit events->callEncryptionChanged(call);
+  });
 }
 
 void CoreHandlers::onCallStateChanged (
@@ -77,16 +162,24 @@ void CoreHandlers::onCallStateChanged (
   const string &
 ) {
     qInfo() << "onCallStateChanged" << Utils::coreStringToAppString(call->getDiversionAddress()->asString());
-  emit callStateChanged(call, state);
-
-  SettingsModel *settingsModel = CoreManager::getInstance()->getSettingsModel();
-  if (
-    call->getState() == linphone::Call::State::IncomingReceived && (
-      !settingsModel->getAutoAnswerStatus() ||
-      settingsModel->getAutoAnswerDelay() > 0
+  dispatch(__func__, [=] {
+    emit callStateChanged(call, state);
+    if (CallEvents *events = mCallEvents.value(call.get()))
+      emit events->callStateChanged(call, state);
+    if (state == linphone::Call::State::End || state == linphone::Call::State::Error)
+      emitCallEnded(call);
+
+    SettingsModel *settingsModel = CoreManager::getInstance()->getSettingsModel();
+    Notifier *notifier = App::getInstance()->getNotifier(); // Null when headless.
+    if (
+      notifier &&
+      call->getState() == linphone::Call::State::IncomingReceived && (
+        !settingsModel->getAutoAnswerStatus() ||
+        settingsModel->getAutoAnswerDelay() > 0
+      )
     )
-  )
-    App::getInstance()->getNotifier()->notifyReceivedCall(call);
+      notifier->notifyReceivedCall(call);
+  });
 }
 
 void CoreHandlers::onCallStatsUpdated (
@@ -95,13 +188,17 @@ void CoreHandlers::onCallStatsUpdated (
   const shared_ptr<const linphone::CallStats> &stats
 ) {
     qInfo() << "onCallStatsUpdated" << Utils::coreStringToAppString(call->getDiversionAddress()->asString());
-  call->getData<CallModel>("call-model").updateStats(stats);
+  dispatch(__func__, [=] { call->getData<CallModel>("call-model").updateStats(stats); });
 }
 
 void CoreHandlers::onCallCreated(const shared_ptr<linphone::Core> &,
 				  const shared_ptr<linphone::Call> &call) {
     qInfo() << "onCallCreated" << Utils::coreStringToAppString(call->getDiversionAddress()->asString());
-  emit callCreated(call);
+  dispatch(__func__, [=] { emit callCreated(call); });
+}
+
+void CoreHandlers::onCallLogUpdated (const shared_ptr<linphone::Core> &, const shared_ptr<linphone::CallLog> &callLog) {
+  dispatch(__func__, [=] { emit callLogUpdated(callLog); });
 }
 
 void CoreHandlers::onConfiguringStatus(
@@ -109,7 +206,7 @@ void CoreHandlers::onConfiguringStatus(
   linphone::ConfiguringState status,
   const std::string & message){
   Q_UNUSED(core)
-  emit setLastRemoteProvisioningState(status);
+  dispatch(__func__, [=] { emit setLastRemoteProvisioningState(status); });
   if(status == linphone::ConfiguringState::Failed){
 	  qWarning() << "Remote provisioning has failed and was removed : "<< QString::fromStdString(message);
 	  core->setProvisioningUri("");
@@ -122,7 +219,7 @@ void CoreHandlers::onDtmfReceived(
     int dtmf) {
     Q_UNUSED(lc)
     Q_UNUSED(call)
-    CoreManager::getInstance()->getCore()->playDtmf((char)dtmf, CallModel::DtmfSoundDelay);
+    lc->playDtmf((char)dtmf, CallModel::DtmfSoundDelay);
 }
 void CoreHandlers::onGlobalStateChanged (
   const shared_ptr<linphone::Core> &core,
@@ -134,15 +231,15 @@ void CoreHandlers::onGlobalStateChanged (
     switch(gstate){
         case linphone::GlobalState::On :
             qInfo() << "Core is running " << QString::fromStdString(message);
-            emit coreStarted();
+            dispatch(__func__, [=] { emit coreStarted(); });
             break;
         case linphone::GlobalState::Off :
             qInfo() << "Core is stopped " << QString::fromStdString(message);
-            emit coreStopped();
+            dispatch(__func__, [=] { emit coreStopped(); });
             break;
         case linphone::GlobalState::Startup : // Usefull to start core iterations
             qInfo() << "Core is starting " << QString::fromStdString(message);
-            emit coreStarting();
+            dispatch(__func__, [=] { emit coreStarting(); });
             break;
         default:{}
     }
@@ -152,7 +249,11 @@ void CoreHandlers::onIsComposingReceived (
   const shared_ptr<linphone::Core> &,
   const shared_ptr<linphone::ChatRoom> &room
 ) {
-  emit isComposingChanged(room);
+  dispatch(__func__, [=] {
+    emit isComposingChanged(room);
+    if (ChatRoomEvents *events = mChatRoomEvents.value(room.get()))
+      emit events->isComposingChanged(room);
+  });
 }
 
 void CoreHandlers::onLogCollectionUploadStateChanged (
@@ -160,7 +261,7 @@ void CoreHandlers::onLogCollectionUploadStateChanged (
   linphone::Core::LogCollectionUploadState state,
   const string &info
 ) {
-  emit logsUploadStateChanged(state, info);
+  dispatch(__func__, [=] { emit logsUploadStateChanged(state, info); });
 }
 
 void CoreHandlers::onLogCollectionUploadProgressIndication (
@@ -213,7 +314,8 @@ void CoreHandlers::onNotifyPresenceReceivedForUriOrTel (
   const string &uriOrTel,
   const shared_ptr<const linphone::PresenceModel> &presenceModel
 ) {
-  emit presenceReceived(Utils::coreStringToAppString(uriOrTel), presenceModel);
+  const QString sipAddress = Utils::coreStringToAppString(uriOrTel);
+  dispatch(__func__, [=] { emit presenceReceived(sipAddress, presenceModel); });
 }
 
 void CoreHandlers::onNotifyPresenceReceived (
@@ -221,8 +323,10 @@ void CoreHandlers::onNotifyPresenceReceived (
   const shared_ptr<linphone::Friend> &linphoneFriend
 ) {
   // Ignore friend without vcard because the `contact-model` data doesn't exist.
-  if (linphoneFriend->getVcard() && linphoneFriend->dataExists("contact-model"))
-    linphoneFriend->getData<ContactModel>("contact-model").refreshPresence();
+  dispatch(__func__, [=] {
+    if (linphoneFriend->getVcard() && linphoneFriend->dataExists("contact-model"))
+      linphoneFriend->getData<ContactModel>("contact-model").refreshPresence();
+  });
 }
 
 void CoreHandlers::onRegistrationStateChanged (
@@ -231,7 +335,7 @@ void CoreHandlers::onRegistrationStateChanged (
   linphone::RegistrationState state,
   const string &
 ) {
-  emit registrationStateChanged(proxyConfig, state);
+  dispatch(__func__, [=] { emit registrationStateChanged(proxyConfig, state); });
 }
 
 void CoreHandlers::onTransferStateChanged (
@@ -272,14 +376,14 @@ void CoreHandlers::onTransferStateChanged (
     // 3. Done.
     case linphone::Call::State::Connected:
       qInfo() << QStringLiteral("Call transfer succeeded.");
-      emit callTransferSucceeded(call);
+      dispatch(__func__, [=] { emit callTransferSucceeded(call); });
       break;
 
     // 4. Error.
     case linphone::Call::State::End:
     case linphone::Call::State::Error:
       qWarning() << QStringLiteral("Call transfer failed.");
-      emit callTransferFailed(call);
+      dispatch(__func__, [=] { emit callTransferFailed(call); });
       break;
   }
 }
@@ -291,15 +395,19 @@ void CoreHandlers::onVersionUpdateCheckResultReceived (
   const string &url
 ) {
   if (result == linphone::VersionUpdateCheckResult::NewVersionAvailable)
-    App::getInstance()->getNotifier()->notifyNewVersionAvailable(
-      Utils::coreStringToAppString(version),
-      Utils::coreStringToAppString(url)
-    );
+    dispatch(__func__, [=] {
+      Notifier *notifier = App::getInstance()->getNotifier();
+      if (notifier)
+        notifier->notifyNewVersionAvailable(
+          Utils::coreStringToAppString(version),
+          Utils::coreStringToAppString(url)
+        );
+    });
 }
 void CoreHandlers::onEcCalibrationResult(
     const std::shared_ptr<linphone::Core> &,
     linphone::EcCalibratorStatus status,
     int delayMs
   ) {
-  emit ecCalibrationResult(status, delayMs);
+  dispatch(__func__, [=] { emit ecCalibrationResult(status, delayMs); });
 }
@@ -21,9 +21,15 @@
 #ifndef CORE_HANDLERS_H_
 #define CORE_HANDLERS_H_
 
+#include <functional>
+
 #include <linphone++/linphone.hh>
+#include <QHash>
 #include <QObject>
 
+#include "CoreHandlersProfiler.hpp"
+#include "KeyedEvents.hpp"
+
 // =============================================================================
 
 class CoreManager;
@@ -38,6 +44,16 @@ public:
   CoreHandlers (CoreManager *coreManager);
   ~CoreHandlers ();
 
+  CoreHandlersProfiler *getProfiler () const {
+    return mProfiler;
+  }
+
+  // Keyed events: only the receivers of a chat room or a call are called
+  // instead of all the receivers of the broadcast signals. The registration
+  // ends with the receiver.
+  ChatRoomEvents *getChatRoomEvents (const std::shared_ptr<linphone::ChatRoom> &chatRoom, QObject *receiver);
+  CallEvents *getCallEvents (const std::shared_ptr<linphone::Call> &call, QObject *receiver);
+
 signals:
   void authenticationRequested (const std::shared_ptr<linphone::AuthInfo> &authInfo);
   void callEncryptionChanged (const std::shared_ptr<linphone::Call> &call);
@@ -45,6 +61,7 @@ signals:
   void callTransferFailed (const std::shared_ptr<linphone::Call> &call);
   void callTransferSucceeded (const std::shared_ptr<linphone::Call> &call);
   void callCreated(const std::shared_ptr<linphone::Call> & call);
+  void callLogUpdated (const std::shared_ptr<linphone::CallLog> &callLog);
   void coreStarting();
   void coreStarted ();
   void coreStopped ();
@@ -57,6 +74,19 @@ signals:
   void setLastRemoteProvisioningState(const linphone::ConfiguringState &state);
 
 private:
+  // Call the handler and notify the core activity.
+  // `callback` names the handler in the profiler, it must be a string literal.
+  void dispatch (const char *callback, const std::function<void()> &handler);
+
+  template<typename Events, typename Key>
+  Events *getEvents (QHash<const Key *, Events *> &events, const std::shared_ptr<Key> &key, QObject *receiver);
+
+  void emitCallEnded (const std::shared_ptr<linphone::Call> &call);
+
+  QHash<const linphone::ChatRoom *, ChatRoomEvents *> mChatRoomEvents;
+  QHash<const linphone::Call *, CallEvents *> mCallEvents;
+
+  CoreHandlersProfiler *mProfiler = nullptr;
 
   // ---------------------------------------------------------------------------
   // Linphone callbacks.
@@ -93,6 +123,11 @@ private:
     const std::shared_ptr<linphone::Call> & call
   ) override;
 
+  void onCallLogUpdated (
+    const std::shared_ptr<linphone::Core> &core,
+    const std::shared_ptr<linphone::CallLog> &callLog
+  ) override;
+
   void onConfiguringStatus(
     const std::shared_ptr<linphone::Core> & core,
     linphone::ConfiguringState status,
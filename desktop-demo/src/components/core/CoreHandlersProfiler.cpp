@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2010-2020 Belledonne Communications SARL.
+ *
+ * This file is part of linphone-desktop
+ * (see https://www.linphone.org).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+
+#include <QStringList>
+#include <QTimer>
+#include <QtDebug>
+
+#include "CoreHandlersProfiler.hpp"
+
+// =============================================================================
+
+using namespace std;
+
+constexpr int CoreHandlersProfiler::Histogram::SubBucketBits;
+constexpr int CoreHandlersProfiler::Histogram::SubBucketCount;
+constexpr int CoreHandlersProfiler::Histogram::BucketCount;
+
+// Values below `SubBucketCount` us have their own bucket. Above, a power of two
+// is split in `SubBucketCount` buckets.
+int CoreHandlersProfiler::Histogram::getBucket (quint64 us) {
+  if (us < quint64(SubBucketCount))
+    return int(us);
+
+  int exponent = 0;
+  while (exponent < 63 && us >> (exponent + 1))// A shift by 64 is undefined.
+    ++exponent;
+
+  const int subBucket = int(us >> (exponent - SubBucketBits)) & (SubBucketCount - 1);
+  return (exponent - SubBucketBits + 1) * SubBucketCount + subBucket;
+}
+
+quint64 CoreHandlersProfiler::Histogram::getBucketValue (int bucket) {
+  if (bucket < SubBucketCount)
+    return quint64(bucket);
+
+  const int exponent = bucket / SubBucketCount + SubBucketBits - 1;
+  const int subBucket = bucket % SubBucketCount;
+  return quint64(SubBucketCount + subBucket) << (exponent - SubBucketBits);
+}
+
+void CoreHandlersProfiler::Histogram::record (qint64 duration) {
+  ++mCount;
+  mTotal += duration;
+  mMax = qMax(mMax, duration);
+  ++mBuckets[getBucket(quint64(qMax(duration, qint64(0))) / 1000)];
+}
+
+qint64 CoreHandlersProfiler::Histogram::getPercentile (double percentile) const {
+  if (!mCount)
+    return 0;
+
+  const quint64 rank = max(quint64(1), quint64(percentile / 100.0 * double(mCount) + 0.5));
+  quint64 count = 0;
+  for (int bucket = 0; bucket < BucketCount; ++bucket) {
+    count += mBuckets[bucket];
+    if (count >= rank)
+      return min(qint64(getBucketValue(bucket)) * 1000, mMax);
+  }
+  return mMax;
+}
+
+// -----------------------------------------------------------------------------
+
+CoreHandlersProfiler::CoreHandlersProfiler (QObject *parent) : QObject(parent) {
+  mLogTimer = new QTimer(this);
+  QObject::connect(mLogTimer, &QTimer::timeout, this, &CoreHandlersProfiler::log);
+}
+
+void CoreHandlersProfiler::setEnabled (bool enabled, int logInterval) {
+  mEnabled = enabled;
+  if (enabled && logInterval > 0)
+    mLogTimer->start(logInterval * 1000);
+  else
+    mLogTimer->stop();
+}
+
+void CoreHandlersProfiler::record (const char *callback, qint64 duration) {
+  mHistograms[callback].record(duration);
+}
+
+void CoreHandlersProfiler::reset () {
+  mHistograms.clear();
+}
+
+QString CoreHandlersProfiler::toString () const {
+  QList<QPair<QString, const Histogram *>> histograms;
+  for (auto it = mHistograms.cbegin(); it != mHistograms.cend(); ++it)
+    histograms << qMakePair(QString::fromLatin1(it.key()), &it.value());
+  sort(histograms.begin(), histograms.end(), [](const QPair<QString, const Histogram *> &a, const QPair<QString, const Histogram *> &b) {
+    return a.first < b.first;
+  });
+
+  QStringList lines;
+  for (const auto &histogram : histograms)
+    lines << QStringLiteral("%1: %2 calls, mean %3 us, p50 %4 us, p90 %5 us, p99 %6 us, max %7 us")
+      .arg(histogram.first)
+      .arg(histogram.second->getCount())
+      .arg(histogram.second->getMean() / 1000)
+      .arg(histogram.second->getPercentile(50) / 1000)
+      .arg(histogram.second->getPercentile(90) / 1000)
+      .arg(histogram.second->getPercentile(99) / 1000)
+      .arg(histogram.second->getMax() / 1000);
+  return lines.join('\n');
+}
+
+void CoreHandlersProfiler::log () const {
+  if (!mHistograms.isEmpty())
+    qInfo().noquote() << QStringLiteral("Core handlers durations:\n") + toString();
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2010-2020 Belledonne Communications SARL.
+ *
+ * This file is part of linphone-desktop
+ * (see https://www.linphone.org).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CORE_HANDLERS_PROFILER_H_
+#define CORE_HANDLERS_PROFILER_H_
+
+#include <atomic>
+
+#include <QHash>
+#include <QObject>
+
+// =============================================================================
+// Durations of the core handlers, including the slots called synchronously by
+// their signals. One log-linear histogram per callback: 8 buckets per power of
+// two of microseconds, so each value is known within 12.5%.
+// Disabled by default. A disabled profiler costs an atomic load per event.
+// =============================================================================
+
+class QTimer;
+
+class CoreHandlersProfiler : public QObject {
+  Q_OBJECT;
+
+public:
+  class Histogram {
+  public:
+    void record (qint64 duration);
+
+    quint64 getCount () const {
+      return mCount;
+    }
+
+    // In nanoseconds.
+    qint64 getMean () const {
+      return mCount ? mTotal / qint64(mCount) : 0;
+    }
+    qint64 getMax () const {
+      return mMax;
+    }
+    qint64 getPercentile (double percentile) const;
+
+    static constexpr int SubBucketBits = 3;
+    static constexpr int SubBucketCount = 1 << SubBucketBits;
+    static constexpr int BucketCount = (64 - SubBucketBits + 1) * SubBucketCount;
+
+    static int getBucket (quint64 us);
+    static quint64 getBucketValue (int bucket); // Lowest value of the bucket, in us.
+
+  private:
+    quint64 mCount = 0;
+    qint64 mTotal = 0;
+    qint64 mMax = 0;
+    quint64 mBuckets[BucketCount] = {};
+  };
+
+  CoreHandlersProfiler (QObject *parent = Q_NULLPTR);
+
+  // Can be called from any thread.
+  bool isEnabled () const {
+    return mEnabled.load(std::memory_order_relaxed);
+  }
+
+  // Dump the histograms in the logs every `logInterval` s if not 0.
+  void setEnabled (bool enabled, int logInterval = 0);
+
+  // GUI thread only. `callback` must be a string literal.
+  void record (const char *callback, qint64 duration);
+  void reset ();
+
+  QString toString () const;
+
+private:
+  void log () const;
+
+  std::atomic<bool> mEnabled { false };
+  QHash<const char *, Histogram> mHistograms;
+  QTimer *mLogTimer = nullptr;
+};
+
+#endif // CORE_HANDLERS_PROFILER_H_
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2010-2020 Belledonne Communications SARL.
+ *
+ * This file is part of linphone-desktop
+ * (see https://www.linphone.org).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CoreIterationScheduler.hpp"
+
+// =============================================================================
+
+CoreIterationScheduler::CoreIterationScheduler (int fastInterval, int idleInterval, int quietDelay) :
+  mFastInterval(fastInterval), mIdleInterval(qMax(fastInterval, idleInterval)), mQuietDelay(quietDelay), mInterval(fastInterval) {}
+
+int CoreIterationScheduler::next (bool busy) {
+  ++mWakeupCount;
+
+  if (busy || mActivity.exchange(false, std::memory_order_relaxed)) {
+    mQuietTime = 0;
+    mInterval = mFastInterval;
+    return mFastInterval;
+  }
+
+  int interval = mInterval;
+  mQuietTime += interval;
+  if (mQuietTime >= mQuietDelay) {
+    interval = qMin(interval * 2, mIdleInterval);
+    mInterval = interval;
+  }
+
+  return interval;
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2010-2020 Belledonne Communications SARL.
+ *
+ * This file is part of linphone-desktop
+ * (see https://www.linphone.org).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CORE_ITERATION_SCHEDULER_H_
+#define CORE_ITERATION_SCHEDULER_H_
+
+#include <atomic>
+
+#include <QtGlobal>
+
+// =============================================================================
+// Choose the interval between two core iterations. Iterate fast while the
+// core is busy or was active recently, then double the interval up to the
+// idle interval.
+// =============================================================================
+
+class CoreIterationScheduler {
+public:
+  CoreIterationScheduler (int fastInterval, int idleInterval, int quietDelay);
+
+  // Can be called from any thread.
+  void notifyActivity () {
+    mActivity.store(true, std::memory_order_relaxed);
+  }
+
+  // Called after each iteration. Returns the next interval.
+  int next (bool busy);
+
+  int getFastInterval () const {
+    return mFastInterval;
+  }
+
+  // Can be called from any thread.
+  int getInterval () const {
+    return mInterval.load(std::memory_order_relaxed);
+  }
+
+  quint64 getWakeupCount () const {
+    return mWakeupCount;
+  }
+
+private:
+  const int mFastInterval;
+  const int mIdleInterval;
+  const int mQuietDelay;
+
+  std::atomic<bool> mActivity { true };
+  std::atomic<int> mInterval;
+  int mQuietTime = 0;
+  quint64 mWakeupCount = 0;
+};
+
+#endif // CORE_ITERATION_SCHEDULER_H_
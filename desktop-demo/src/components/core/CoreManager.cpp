@@ -20,18 +20,26 @@
 
 #include <QCoreApplication>
 #include <QDir>
+#include <QElapsedTimer>
+#include <QEvent>
 #include <QSysInfo>
 #include <QtConcurrent>
+#include <QThread>
 #include <QTimer>
 #include <QFile>
 #include <QTest>
 #include "config.h"
 
 #include "app/paths/Paths.hpp"
+#include "app/tracer/Tracer.hpp"
 #include "components/calls/CallsListModel.hpp"
+#include "components/calls/VuMeterSampler.hpp"
+#include "components/camera/SoftwareCamera.hpp"
+#include "components/camera/VideoFrameClock.hpp"
 #include "components/contact/VcardModel.hpp"
 #include "components/contacts/ContactsListModel.hpp"
 #include "components/contacts/ContactsImporterListModel.hpp"
+#include "components/history/HistoryStatsModel.hpp"
 #include "components/ldap/LdapListModel.hpp"
 #include "components/settings/AccountSettingsModel.hpp"
 #include "components/settings/SettingsModel.hpp"
@@ -40,6 +48,7 @@
 #include "utils/Utils.hpp"
 
 #include "CoreHandlers.hpp"
+#include "CoreIterationScheduler.hpp"
 #include "CoreManager.hpp"
 #include <linphone/core.h>
 
@@ -50,6 +59,17 @@ using namespace std;
 namespace {
   constexpr int CbsCallInterval = 20;
 
+  // Back off to `core_idle_iterate_interval` after `CbsQuietDelay` without activity.
+  // The core has no socket wakeup: incoming packets wait at most the idle interval,
+  // so it cannot exceed `CbsIdleCallInterval`.
+  constexpr char CbsIdleCallIntervalName[] = "core_idle_iterate_interval";
+
+  constexpr char HandlersProfilingEnabledName[] = "core_handlers_profiling_enabled";
+  constexpr char HandlersProfilingLogIntervalName[] = "core_handlers_profiling_log_interval";
+  constexpr int HandlersProfilingLogInterval = 60;
+  constexpr int CbsIdleCallInterval = 100;
+  constexpr int CbsQuietDelay = 2000;
+
   constexpr char RcVersionName[] = "rc_version";
   constexpr int RcVersionCurrent = 1;
 
@@ -68,12 +88,15 @@ CoreManager::CoreManager (QObject *parent, const QString &configPath) :
 	QObject(parent), mHandlers(make_shared<CoreHandlers>(this)) {
 	mCore = nullptr;
 	mLastRemoteProvisioningState = linphone::ConfiguringState::Skipped;
+	mVideoFrameClock = new VideoFrameClock(this);
 	CoreHandlers *coreHandlers = mHandlers.get();
 	QObject::connect(coreHandlers, &CoreHandlers::coreStarting, this, &CoreManager::startIterate, Qt::QueuedConnection);
 	QObject::connect(coreHandlers, &CoreHandlers::setLastRemoteProvisioningState, this, &CoreManager::setLastRemoteProvisioningState);
 	QObject::connect(coreHandlers, &CoreHandlers::coreStarted, this, &CoreManager::initCoreManager, Qt::QueuedConnection);
 	QObject::connect(coreHandlers, &CoreHandlers::coreStopped, this, &CoreManager::stopIterate, Qt::QueuedConnection);
 	QObject::connect(coreHandlers, &CoreHandlers::logsUploadStateChanged, this, &CoreManager::handleLogsUploadStateChanged);
+	QCoreApplication::instance()->installEventFilter(this);
+	Tracer::addInstant("Core creation scheduled");
 	QTimer::singleShot(100, [this, configPath](){// Delay the creation in order to have the CoreManager instance set before
 		createLinphoneCore(configPath);
 	});
@@ -88,19 +111,103 @@ CoreManager::~CoreManager(){
 // -----------------------------------------------------------------------------
 
 void CoreManager::initCoreManager(){
-	mCallsListModel = new CallsListModel(this);
-	mContactsListModel = new ContactsListModel(this);
-	mContactsImporterListModel = new ContactsImporterListModel(this);
-	mAccountSettingsModel = new AccountSettingsModel(this);
-	mLdapListModel = new LdapListModel(this);
-	mSettingsModel = new SettingsModel(this);
-    mSipAddressesModel = new SipAddressesModel(this);
+	TRACE_SPAN("CoreManager::initCoreManager");
+	QElapsedTimer timer;
+	timer.start();
+
+	// Only create what the first screen and the calls need. The other models
+	// are created on first access or after the first screen.
+	getSettingsModel();
+	getAccountSettingsModel();
+	getCallsListModel();
+	getVuMeterSampler();
     migrate();
 	mStarted = true;
 
-	qInfo() << QStringLiteral("CoreManager initialized");
+	qInfo() << QStringLiteral("CoreManager initialized in %1 ms").arg(timer.elapsed());
 	emit coreManagerInitialized();
+
+	mDeferredModelsEnabled = true;
+	QTimer::singleShot(0, this, &CoreManager::createDeferredModels);
+}
+
+// Create one deferred model per event loop iteration to let the GUI draw
+// between them.
+void CoreManager::createDeferredModels () {
+	if (!mDeferredModelsEnabled)// Stopping.
+		return;
+	if (!mContactsListModel)
+		getContactsListModel();
+	else if (!mSipAddressesModel)
+		getSipAddressesModel();
+	else if (!mHistoryStatsModel)
+		getHistoryStatsModel();
+	else if (!mContactsImporterListModel)
+		getContactsImporterListModel();
+	else if (!mLdapListModel)
+		getLdapListModel();
+	else
+		return;
+
+	QTimer::singleShot(0, this, &CoreManager::createDeferredModels);
+}
+
+// -----------------------------------------------------------------------------
+
+template<typename T>
+T *CoreManager::getModel (T *&model, const char *name) const {
+	// Models are created lazily without lock: only the GUI thread can get them.
+	Q_ASSERT(QThread::currentThread() == thread());
+	// Still created while the core stops: the callers do not expect a null model.
+	if (!model) {
+		const Tracer::Span span(name);
+		QElapsedTimer timer;
+		timer.start();
+		model = new T(const_cast<CoreManager *>(this));
+		qInfo() << QStringLiteral("Model `%1` created in %2 ms").arg(name).arg(timer.elapsed());
+		Tracer::addCounter("Created models", ++mCreatedModelsCount);
+	}
+	return model;
+}
+
+CallsListModel *CoreManager::getCallsListModel () const {
+	return getModel(mCallsListModel, "CallsListModel");
+}
+
+ContactsListModel *CoreManager::getContactsListModel () const {
+	return getModel(mContactsListModel, "ContactsListModel");
+}
+
+ContactsImporterListModel *CoreManager::getContactsImporterListModel () const {
+	return getModel(mContactsImporterListModel, "ContactsImporterListModel");
 }
+
+HistoryStatsModel *CoreManager::getHistoryStatsModel () const {
+	return getModel(mHistoryStatsModel, "HistoryStatsModel");
+}
+
+SipAddressesModel *CoreManager::getSipAddressesModel () const {
+	return getModel(mSipAddressesModel, "SipAddressesModel");
+}
+
+VuMeterSampler *CoreManager::getVuMeterSampler () const {
+	return getModel(mVuMeterSampler, "VuMeterSampler");
+}
+
+SettingsModel *CoreManager::getSettingsModel () const {
+	return getModel(mSettingsModel, "SettingsModel");
+}
+
+AccountSettingsModel *CoreManager::getAccountSettingsModel () const {
+	return getModel(mAccountSettingsModel, "AccountSettingsModel");
+}
+
+LdapListModel *CoreManager::getLdapListModel () const {
+	return getModel(mLdapListModel, "LdapListModel");
+}
+
+// -----------------------------------------------------------------------------
+
 CoreManager *CoreManager::getInstance (){
    return mInstance;
 }
@@ -119,8 +226,9 @@ void CoreManager::uninit () {
         qInfo() << "Core is correctly destroyed";
     });
     QObject::connect(mInstance->getHandlers().get(), &CoreHandlers::coreStopped, mInstance, &QObject::deleteLater); // Delete data only when the core is Off
+    mInstance->mDeferredModelsEnabled = false;// Only create the models which are used while the core stops.
 
-    mInstance->lockVideoRender();// Stop do iterations. We have to protect GUI.
+    mInstance->lockVideoRender(VideoRenderLock::CoreSide);// Stop do iterations. We have to protect GUI.
     mInstance->mCore->stop();
     mInstance->unlockVideoRender();
 	mInstance = nullptr;
@@ -155,6 +263,7 @@ void CoreManager::sendLogs () const {
   qInfo() << QStringLiteral("Send logs to: `%1` from `%2`.")
     .arg(Utils::coreStringToAppString(mCore->getLogCollectionUploadServerUrl()))
     .arg(Utils::coreStringToAppString(mCore->getLogCollectionPath()));
+  mLogsUploading = true;
   mCore->uploadLogCollection();
 }
 
@@ -205,19 +314,25 @@ void CoreManager::setResourcesPaths () {
 // -----------------------------------------------------------------------------
 
 void CoreManager::createLinphoneCore (const QString &configPath) {
+  TRACE_SPAN("CoreManager::createLinphoneCore");
   qInfo() << QStringLiteral("Launch async core creation.");
 
   // Migration of configuration and database files from GTK version of Linphone.
   Paths::migrate();
   setResourcesPaths();
   
-  mCore = linphone::Factory::get()->createCore(
-    Utils::appStringToCoreString(configPath),
-    Utils::appStringToCoreString(configPath),
-    nullptr
-  );
+  {
+    TRACE_SPAN("Factory::createCore");
+    mCore = linphone::Factory::get()->createCore(
+      Utils::appStringToCoreString(configPath),
+      Utils::appStringToCoreString(configPath),
+      nullptr
+    );
+  }
   mCore->addListener(mHandlers);
-  mCore->setVideoDisplayFilter("MSQOGL");
+  mCore->setVideoDisplayFilter(
+    SoftwareCamera::isEnabled(mCore->getConfig()) ? SoftwareCamera::DisplayFilterName : "MSQOGL"
+  );
   mCore->usePreviewWindow(true);
   mCore->enableVideoPreview(false);
   mCore->setUserAgent(
@@ -237,7 +352,10 @@ void CoreManager::createLinphoneCore (const QString &configPath) {
     config->setInt("video", "capture", 1);
     config->setInt("video", "display", 1);
   }
-  mCore->start();
+  {
+    TRACE_SPAN("Core::start");
+    mCore->start();
+  }
   setDatabasesPaths();
   setOtherPaths();
   mCore->enableFriendListSubscription(true);
@@ -278,6 +396,17 @@ QString CoreManager::getVersion () const {
 // -----------------------------------------------------------------------------
 
 void CoreManager::startIterate(){
+    mIterationScheduler.reset(new CoreIterationScheduler(
+        CbsCallInterval,
+        qMin(mCore->getConfig()->getInt(SettingsModel::UiSection, CbsIdleCallIntervalName, CbsIdleCallInterval), CbsIdleCallInterval),
+        CbsQuietDelay
+    ));
+
+    mHandlers->getProfiler()->setEnabled(
+        mCore->getConfig()->getInt(SettingsModel::UiSection, HandlersProfilingEnabledName, 0),
+        getHandlersProfilingLogInterval()
+    );
+
     mCbsTimer = new QTimer(this);
     mCbsTimer->setInterval(CbsCallInterval);
     QObject::connect(mCbsTimer, &QTimer::timeout, this, &CoreManager::iterate);
@@ -290,17 +419,95 @@ void CoreManager::stopIterate(){
     mCbsTimer->stop();
     mCbsTimer->deleteLater();// allow the timer to continue its stuff
     mCbsTimer = nullptr;
+
+    qInfo() << QStringLiteral("Iterate: %1 calls, avg %2 us, max %3 us.")
+        .arg(mIterateCount)
+        .arg(mIterateCount ? mIterateTotalTime / qint64(mIterateCount) / 1000 : 0)
+        .arg(mIterateMaxTime / 1000);
+    qInfo() << QStringLiteral("Video render lock. Core: %1").arg(VideoRenderLock::statsToString(getVideoRenderLockStats(VideoRenderLock::CoreSide)));
+    qInfo() << QStringLiteral("Video render lock. GUI: %1").arg(VideoRenderLock::statsToString(getVideoRenderLockStats(VideoRenderLock::GuiSide)));
+    qInfo() << QStringLiteral("Video render lock. Render: %1").arg(VideoRenderLock::statsToString(getVideoRenderLockStats(VideoRenderLock::RenderSide)));
+    qInfo() << QStringLiteral("Video frame times: %1").arg(mVideoFrameClock->getFrameTimes().toString());
+    if (mHandlers->getProfiler()->isEnabled()) {
+        qInfo().noquote() << QStringLiteral("Core handlers:\n") + mHandlers->getProfiler()->toString();
+        mHandlers->getProfiler()->setEnabled(false);
+    }
+    mIterationScheduler.reset();
 }
 
 void CoreManager::iterate () {
-    lockVideoRender();
-    if(mCore)
+    lockVideoRender(VideoRenderLock::CoreSide);
+    if(mCore) {
+        QElapsedTimer timer;
+        timer.start();
         mCore->iterate();
+        const qint64 time = timer.nsecsElapsed();
+        ++mIterateCount;
+        mIterateTotalTime += time;
+        mIterateMaxTime = qMax(mIterateMaxTime, time);
+
+        const int interval = mIterationScheduler->next(isCoreBusy());
+        if (mCbsTimer && interval != mCbsTimer->interval())
+            mCbsTimer->setInterval(interval);
+    }
     unlockVideoRender();
 }
 
 // -----------------------------------------------------------------------------
 
+void CoreManager::notifyCoreActivity () {
+    if (!mIterationScheduler)
+        return;
+
+    mIterationScheduler->notifyActivity();
+
+    const int interval = mIterationScheduler->getFastInterval();
+    if (!mCbsTimer || mIterationScheduler->getInterval() == interval)
+        return;
+
+    // Do not wait the end of a long idle interval.
+    mCbsTimer->start(interval);
+}
+
+int CoreManager::getIterateInterval () const {
+    return mIterationScheduler ? mIterationScheduler->getInterval() : 0;
+}
+
+quint64 CoreManager::getIterateWakeupCount () const {
+    return mIterationScheduler ? mIterationScheduler->getWakeupCount() : 0;
+}
+
+int CoreManager::getHandlersProfilingLogInterval () const {
+    return mCore->getConfig()->getInt(SettingsModel::UiSection, HandlersProfilingLogIntervalName, HandlersProfilingLogInterval);
+}
+
+bool CoreManager::isCoreBusy () const {
+    if (mCore->getCallsNb() > 0 || mLogsUploading || mCore->getGlobalState() != linphone::GlobalState::On)
+        return true;
+
+    for (const auto &proxyConfig : mCore->getProxyConfigList())
+        if (proxyConfig->getState() == linphone::RegistrationState::Progress)
+            return true;
+
+    return false;
+}
+
+bool CoreManager::eventFilter (QObject *object, QEvent *event) {
+    switch (event->type()) {
+        case QEvent::KeyPress:
+        case QEvent::MouseButtonPress:
+        case QEvent::TouchBegin:
+        case QEvent::Wheel:
+            notifyCoreActivity();
+            break;
+        default:
+            break;
+    }
+    return QObject::eventFilter(object, event);
+}
+
+// -----------------------------------------------------------------------------
+
 void CoreManager::handleLogsUploadStateChanged (linphone::Core::LogCollectionUploadState state, const string &info) {
   switch (state) {
     case linphone::Core::LogCollectionUploadState::InProgress:
@@ -308,6 +515,7 @@ void CoreManager::handleLogsUploadStateChanged (linphone::Core::LogCollectionUpl
 
     case linphone::Core::LogCollectionUploadState::Delivered:
     case linphone::Core::LogCollectionUploadState::NotDelivered:
+      mLogsUploading = false;
       emit logsUploaded(Utils::coreStringToAppString(info));
       break;
   }
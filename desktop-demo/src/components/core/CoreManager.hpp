@@ -21,11 +21,14 @@
 #ifndef CORE_MANAGER_H_
 #define CORE_MANAGER_H_
 
+#include <memory>
+
 #include <linphone++/linphone.hh>
 #include <QObject>
 #include <QString>
 #include <QHash>
-#include <QMutex>
+
+#include "VideoRenderLock.hpp"
 
 // =============================================================================
 
@@ -36,10 +39,14 @@ class CallsListModel;
 class ContactsListModel;
 class ContactsImporterListModel;
 class CoreHandlers;
+class CoreIterationScheduler;
+class HistoryStatsModel;
 class LdapListModel;
 class SettingsModel;
 class SipAddressesModel;
+class VuMeterSampler;
 class VcardModel;
+class VideoFrameClock;
 
 
 class CoreManager : public QObject {
@@ -65,50 +72,54 @@ public:
   // Video render lock.
   // ---------------------------------------------------------------------------
 
-  void lockVideoRender () {
-    mMutexVideoRender.lock();
+  void lockVideoRender (VideoRenderLock::Side side = VideoRenderLock::GuiSide) {
+    mVideoRenderLock.lock(side);
   }
 
   void unlockVideoRender () {
-    mMutexVideoRender.unlock();
+    mVideoRenderLock.unlock();
+  }
+
+  // Can be called from any thread.
+  VideoRenderLock::Stats getVideoRenderLockStats (VideoRenderLock::Side side) const {
+    return mVideoRenderLock.getStats(side);
+  }
+
+  // Schedules the redraws of the video items.
+  VideoFrameClock *getVideoFrameClock () const {
+    return mVideoFrameClock;
   }
 
   // ---------------------------------------------------------------------------
-  // Singleton models.
+  // Iteration scheduling.
   // ---------------------------------------------------------------------------
 
-  CallsListModel *getCallsListModel () const {
-    Q_CHECK_PTR(mCallsListModel);
-    return mCallsListModel;
-  }
+  // Iterate fast again, for example on user input or core events.
+  void notifyCoreActivity ();
 
-  ContactsListModel *getContactsListModel () const {
-    Q_CHECK_PTR(mContactsListModel);
-    return mContactsListModel;
-  }
-  
-  ContactsImporterListModel *getContactsImporterListModel () const {
-    Q_CHECK_PTR(mContactsImporterListModel);
-    return mContactsImporterListModel;
-  }
+  int getIterateInterval () const;
+  quint64 getIterateWakeupCount () const;
 
-  SipAddressesModel *getSipAddressesModel () const {
-    Q_CHECK_PTR(mSipAddressesModel);
-    return mSipAddressesModel;
-  }
+  // In seconds, for `CoreHandlersProfiler::setEnabled`.
+  int getHandlersProfilingLogInterval () const;
 
-  SettingsModel *getSettingsModel () const {
-    Q_CHECK_PTR(mSettingsModel);
-    return mSettingsModel;
-  }
+  // ---------------------------------------------------------------------------
+  // Singleton models.
+  // ---------------------------------------------------------------------------
+
+  // Models are created on first access and are never null. The ones which
+  // are not needed by the first screen are created after it.
+  // GUI thread only.
+  CallsListModel *getCallsListModel () const;
+  ContactsListModel *getContactsListModel () const;
+  ContactsImporterListModel *getContactsImporterListModel () const;
+  HistoryStatsModel *getHistoryStatsModel () const;
+  SipAddressesModel *getSipAddressesModel () const;
+  VuMeterSampler *getVuMeterSampler () const;
+  SettingsModel *getSettingsModel () const;
+  AccountSettingsModel *getAccountSettingsModel () const;
+  LdapListModel *getLdapListModel () const;
 
-  AccountSettingsModel *getAccountSettingsModel () const {
-    Q_CHECK_PTR(mAccountSettingsModel);
-    return mAccountSettingsModel;
-  }
-	LdapListModel *getLdapListModel() const{
-		return mLdapListModel;
-	}
   static CoreManager *getInstance ();
 
   // ---------------------------------------------------------------------------
@@ -149,12 +160,21 @@ private:
   CoreManager (QObject *parent, const QString &configPath);
   ~CoreManager ();
 
+  bool eventFilter (QObject *object, QEvent *event) override;
+
+  bool isCoreBusy () const;
+
   void setDatabasesPaths ();
   void setOtherPaths ();
   void setResourcesPaths ();
 
   void migrate ();
 
+  template<typename T>
+  T *getModel (T *&model, const char *name) const;
+
+  void createDeferredModels ();
+
   QString getVersion () const;
 
   void iterate ();
@@ -167,19 +187,32 @@ private:
   bool mStarted = false;
   linphone::ConfiguringState mLastRemoteProvisioningState;
 
-  CallsListModel *mCallsListModel = nullptr;
-  ContactsListModel *mContactsListModel = nullptr;
-  ContactsImporterListModel *mContactsImporterListModel = nullptr;
-  
-  SipAddressesModel *mSipAddressesModel = nullptr;
-  SettingsModel *mSettingsModel = nullptr;
-  AccountSettingsModel *mAccountSettingsModel = nullptr;
+  bool mDeferredModelsEnabled = false;
+  mutable int mCreatedModelsCount = 0;
 
-  LdapListModel *mLdapListModel = nullptr;
+  mutable CallsListModel *mCallsListModel = nullptr;
+  mutable ContactsListModel *mContactsListModel = nullptr;
+  mutable ContactsImporterListModel *mContactsImporterListModel = nullptr;
+  mutable HistoryStatsModel *mHistoryStatsModel = nullptr;
+
+  mutable SipAddressesModel *mSipAddressesModel = nullptr;
+  mutable SettingsModel *mSettingsModel = nullptr;
+  mutable AccountSettingsModel *mAccountSettingsModel = nullptr;
+
+  mutable LdapListModel *mLdapListModel = nullptr;
+  mutable VuMeterSampler *mVuMeterSampler = nullptr;
 
   QTimer *mCbsTimer = nullptr;
+  std::unique_ptr<CoreIterationScheduler> mIterationScheduler;
+  mutable bool mLogsUploading = false; // Busy until the upload ends.
+
+  // Durations of the iterations, in nanoseconds.
+  quint64 mIterateCount = 0;
+  qint64 mIterateTotalTime = 0;
+  qint64 mIterateMaxTime = 0;
 
-  QMutex mMutexVideoRender;
+  VideoRenderLock mVideoRenderLock;
+  VideoFrameClock *mVideoFrameClock = nullptr;
 
   static CoreManager *mInstance;
 };
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2010-2020 Belledonne Communications SARL.
+ *
+ * This file is part of linphone-desktop
+ * (see https://www.linphone.org).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef KEYED_EVENTS_H_
+#define KEYED_EVENTS_H_
+
+#include <memory>
+
+#include <linphone++/linphone.hh>
+#include <QObject>
+
+// =============================================================================
+// Events of one chat room or one call, emitted by `CoreHandlers` in addition
+// to its broadcast signals. See `CoreHandlers::getChatRoomEvents`.
+// =============================================================================
+
+class ChatRoomEvents : public QObject {
+  Q_OBJECT;
+
+public:
+  ChatRoomEvents (const std::shared_ptr<linphone::ChatRoom> &chatRoom, QObject *parent) : QObject(parent), mChatRoom(chatRoom) {}
+
+  std::shared_ptr<linphone::ChatRoom> getChatRoom () const {
+    return mChatRoom;
+  }
+
+signals:
+  void isComposingChanged (const std::shared_ptr<linphone::ChatRoom> &chatRoom);
+  // A call with the peer of the chat room is ended.
+  void callEnded (const std::shared_ptr<linphone::Call> &call);
+
+private:
+  std::shared_ptr<linphone::ChatRoom> mChatRoom;
+  int mReceiverCount = 0;
+
+  friend class CoreHandlers;
+};
+
+// -----------------------------------------------------------------------------
+
+class CallEvents : public QObject {
+  Q_OBJECT;
+
+public:
+  CallEvents (const std::shared_ptr<linphone::Call> &call, QObject *parent) : QObject(parent), mCall(call) {}
+
+  std::shared_ptr<linphone::Call> getCall () const {
+    return mCall;
+  }
+
+signals:
+  void callEncryptionChanged (const std::shared_ptr<linphone::Call> &call);
+  void callStateChanged (const std::shared_ptr<linphone::Call> &call, linphone::Call::State state);
+
+private:
+  std::shared_ptr<linphone::Call> mCall;
+  int mReceiverCount = 0;
+
+  friend class CoreHandlers;
+};
+
+#endif // KEYED_EVENTS_H_
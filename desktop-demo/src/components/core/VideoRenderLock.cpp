@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2010-2020 Belledonne Communications SARL.
+ *
+ * This file is part of linphone-desktop
+ * (see https://www.linphone.org).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QElapsedTimer>
+#include <QStringList>
+
+#include "VideoRenderLock.hpp"
+
+// =============================================================================
+
+using namespace std;
+
+constexpr int VideoRenderLock::BucketCount;
+
+namespace {
+  int getBucket (qint64 wait) {
+    qint64 us = wait / 1000;
+    int bucket = 0;
+    while (us > 0 && bucket < VideoRenderLock::BucketCount - 1) {
+      us >>= 1;
+      ++bucket;
+    }
+    return bucket;
+  }
+}
+
+VideoRenderLock::AtomicStats::AtomicStats () {
+  for (auto &bucket : histogram)
+    bucket.store(0, memory_order_relaxed);
+}
+
+void VideoRenderLock::lock (Side side) {
+  AtomicStats &stats = mStats[side];
+  stats.count.fetch_add(1, memory_order_relaxed);
+
+  // Fast path: no contention, no clock read.
+  if (mMutex.tryLock()) {
+    stats.histogram[0].fetch_add(1, memory_order_relaxed);
+    return;
+  }
+
+  QElapsedTimer timer;
+  timer.start();
+  mMutex.lock();
+  const qint64 wait = timer.nsecsElapsed();
+
+  stats.contendedCount.fetch_add(1, memory_order_relaxed);
+  stats.totalWait.fetch_add(wait, memory_order_relaxed);
+  stats.histogram[getBucket(wait)].fetch_add(1, memory_order_relaxed);
+
+  qint64 maxWait = stats.maxWait.load(memory_order_relaxed);
+  while (wait > maxWait && !stats.maxWait.compare_exchange_weak(maxWait, wait, memory_order_relaxed));
+}
+
+VideoRenderLock::Stats VideoRenderLock::getStats (Side side) const {
+  const AtomicStats &stats = mStats[side];
+
+  Stats result;
+  result.count = stats.count.load(memory_order_relaxed);
+  result.contendedCount = stats.contendedCount.load(memory_order_relaxed);
+  result.totalWait = stats.totalWait.load(memory_order_relaxed);
+  result.maxWait = stats.maxWait.load(memory_order_relaxed);
+  for (int i = 0; i < BucketCount; ++i)
+    result.histogram[i] = stats.histogram[i].load(memory_order_relaxed);
+
+  return result;
+}
+
+QString VideoRenderLock::statsToString (const Stats &stats) {
+  QStringList buckets;
+  for (int i = 0; i < BucketCount; ++i) {
+    if (!stats.histogram[i])
+      continue;
+
+    const QString bound = i == 0
+      ? QStringLiteral("<1us")
+      : i == BucketCount - 1
+        ? QStringLiteral(">=%1us").arg(1 << (i - 1))
+        : QStringLiteral("<%1us").arg(1 << i);
+    buckets << QStringLiteral("%1:%2").arg(bound).arg(stats.histogram[i]);
+  }
+
+  return QStringLiteral("%1 locks, %2 contended, avg wait %3 us, max wait %4 us [%5]")
+    .arg(stats.count)
+    .arg(stats.contendedCount)
+    .arg(stats.contendedCount ? stats.totalWait / qint64(stats.contendedCount) / 1000 : 0)
+    .arg(stats.maxWait / 1000)
+    .arg(buckets.join(' '));
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2010-2020 Belledonne Communications SARL.
+ *
+ * This file is part of linphone-desktop
+ * (see https://www.linphone.org).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef VIDEO_RENDER_LOCK_H_
+#define VIDEO_RENDER_LOCK_H_
+
+#include <atomic>
+
+#include <QMutex>
+#include <QString>
+
+// =============================================================================
+// Mutex shared by the core iterations, the GUI handlers and the
+// video renderers. Records the wait times of each side to measure contention.
+// =============================================================================
+
+class VideoRenderLock {
+public:
+  enum Side {
+    CoreSide,   // Iterations.
+    GuiSide,    // Core handlers and models.
+    RenderSide, // Video renderers bindings.
+    SideCount
+  };
+
+  // Wait times buckets: [0, 1[ us, then [2^(i - 1), 2^i[ us. The last one
+  // contains all waits longer than 2^(BucketCount - 2) us.
+  static constexpr int BucketCount = 18;
+
+  struct Stats {
+    quint64 count = 0;
+    quint64 contendedCount = 0;
+    qint64 totalWait = 0; // In nanoseconds.
+    qint64 maxWait = 0;   // In nanoseconds.
+    quint64 histogram[BucketCount] = {};
+  };
+
+  void lock (Side side);
+  void unlock () {
+    mMutex.unlock();
+  }
+
+  // Can be called from any thread.
+  Stats getStats (Side side) const;
+
+  static QString statsToString (const Stats &stats);
+
+private:
+  struct AtomicStats {
+    std::atomic<quint64> count { 0 };
+    std::atomic<quint64> contendedCount { 0 };
+    std::atomic<qint64> totalWait { 0 };
+    std::atomic<qint64> maxWait { 0 };
+    std::atomic<quint64> histogram[BucketCount];
+
+    AtomicStats ();
+  };
+
+  QMutex mMutex;
+  AtomicStats mStats[SideCount];
+};
+
+#endif // VIDEO_RENDER_LOCK_H_
@@ -19,27 +19,16 @@
  */
 
 #include <algorithm>
+#include <vector>
 
 #include <QDateTime>
-#include <QDesktopServices>
 #include <QElapsedTimer>
-#include <QFileInfo>
-#include <QMimeDatabase>
 #include <QTimer>
-#include <QUuid>
-#include <QMessageBox>
-#include <QUrlQuery>
-#include <QImageReader>
+#include <QtDebug>
 
-#include "app/App.hpp"
-#include "app/paths/Paths.hpp"
-#include "app/providers/ThumbnailProvider.hpp"
 #include "components/core/CoreHandlers.hpp"
 #include "components/core/CoreManager.hpp"
-#include "components/notifier/Notifier.hpp"
-#include "components/settings/SettingsModel.hpp"
-#include "utils/QExifImageHeader.hpp"
-#include "utils/Utils.hpp"
+#include "components/history/HistoryStatsModel.hpp"
 
 #include "HistoryModel.hpp"
 
@@ -67,17 +56,18 @@ static inline void fillCallEndEntry (QVariantMap &dest, const shared_ptr<linphon
 
 // -----------------------------------------------------------------------------
 
-HistoryModel::HistoryModel (QObject *parent) :QAbstractListModel(parent){
-	CoreManager *coreManager = CoreManager::getInstance();
+HistoryModel::HistoryModel (QObject *parent) : HistoryModel(CoreManager::getInstance()->getCore(), parent) {
+	mCoreHandlers = CoreManager::getInstance()->getHandlers();
 	
-	mCoreHandlers = coreManager->getHandlers();
-	
-	setSipAddresses();
 	CoreHandlers *coreHandlers = mCoreHandlers.get();
 	QObject::connect(coreHandlers, &CoreHandlers::callStateChanged, this, &HistoryModel::handleCallStateChanged);
 	
 }
 
+HistoryModel::HistoryModel (const shared_ptr<linphone::Core> &core, QObject *parent) : QAbstractListModel(parent), mCore(core) {
+	setSipAddresses();
+}
+
 HistoryModel::~HistoryModel () {
 }
 
@@ -120,10 +110,14 @@ bool HistoryModel::removeRows (int row, int count, const QModelIndex &parent) {
 	if (row < 0 || count < 0 || limit >= mEntries.count())
 		return false;
 	
+	HistoryStatsModel *historyStatsModel = CoreManager::getInstance()->getHistoryStatsModel();
 	beginRemoveRows(parent, row, limit);
 	
 	for (int i = 0; i < count; ++i) {
-		removeEntry(mEntries[row]);
+		HistoryEntryData &entry = mEntries[row];
+		removeEntry(entry);
+		if (entry.first["isStart"].toBool())// A call log has two entries: count it once.
+			historyStatsModel->removeCallLog(static_pointer_cast<linphone::CallLog>(entry.second));
 		mEntries.removeAt(row);
 	}
 	
@@ -137,19 +131,50 @@ bool HistoryModel::removeRows (int row, int count, const QModelIndex &parent) {
 	return true;
 }
 
+// Build all entries at once instead of inserting them one by one.
+// Call logs are ordered by start date: only end entries have to be merged.
 void HistoryModel::setSipAddresses () {
-	shared_ptr<linphone::Core> core = CoreManager::getInstance()->getCore();
-	mEntries.clear();
-	
 	QElapsedTimer timer;
 	timer.start();
 	
-	// Get calls.
-	for (auto &callLog : core->getCallLogs())
-		insertCall(callLog);
+	typedef QPair<qint64, HistoryEntryData> TimedEntry;
+	const list<shared_ptr<linphone::CallLog>> callLogs = mCore->getCallLogs();
+	vector<TimedEntry> starts, ends;
+	starts.reserve(callLogs.size());
 	
-	qInfo() << QStringLiteral("HistoryModel loaded in %3 milliseconds.").arg(timer.elapsed());
+	for (const auto &callLog : callLogs) {
+		QVariantMap start;
+		fillCallStartEntry(start, callLog);
+		starts.push_back(qMakePair(callLog->getStartDate(), qMakePair(start, static_pointer_cast<void>(callLog))));
+		
+		if (callLog->getStatus() == linphone::Call::Status::Success) {
+			QVariantMap end;
+			fillCallEndEntry(end, callLog);
+			ends.push_back(qMakePair(callLog->getStartDate() + callLog->getDuration(), qMakePair(end, static_pointer_cast<void>(callLog))));
+		}
+	}
+	
+	auto isBefore = [](const TimedEntry &a, const TimedEntry &b) {
+		return a.first < b.first;
+	};
+	if (!is_sorted(starts.cbegin(), starts.cend(), isBefore))// Most recent call logs first.
+		reverse(starts.begin(), starts.end());
+	if (!is_sorted(starts.cbegin(), starts.cend(), isBefore))
+		stable_sort(starts.begin(), starts.end(), isBefore);
+	stable_sort(ends.begin(), ends.end(), isBefore);
 	
+	vector<TimedEntry> entries;
+	entries.reserve(starts.size() + ends.size());
+	merge(starts.cbegin(), starts.cend(), ends.cbegin(), ends.cend(), back_inserter(entries), isBefore);
+	
+	beginResetModel();
+	mEntries.clear();
+	mEntries.reserve(int(entries.size()));
+	for (const auto &entry : entries)
+		mEntries << entry.second;
+	endResetModel();
+	
+	qInfo() << QStringLiteral("HistoryModel loaded %1 entries in %2 milliseconds.").arg(mEntries.count()).arg(timer.elapsed());
 }
 
 // -----------------------------------------------------------------------------
@@ -173,6 +198,8 @@ void HistoryModel::removeAllEntries () {
 	
 	endResetModel();
 	
+	CoreManager::getInstance()->getHistoryStatsModel()->removeAllCallLogs();
+	
 	emit allEntriesRemoved();
 	emit focused();// Removing all entries is like having focus. Don't wait asynchronous events.
 }
@@ -200,7 +227,7 @@ void HistoryModel::removeEntry (HistoryEntryData &entry) {
 			});
 		}
 		
-		CoreManager::getInstance()->getCore()->removeCallLog(static_pointer_cast<linphone::CallLog>(entry.second));
+		mCore->removeCallLog(static_pointer_cast<linphone::CallLog>(entry.second));
 		break;
 	}
 		
@@ -58,6 +58,8 @@ public:
 	Q_ENUM(CallStatus)
 
 	HistoryModel (QObject *parent = Q_NULLPTR);
+	// Entries of the call logs of `core`, without the new calls.
+	HistoryModel (const std::shared_ptr<linphone::Core> &core, QObject *parent = Q_NULLPTR);
 	virtual ~HistoryModel ();
 
 	int rowCount (const QModelIndex &index = QModelIndex()) const override;
@@ -90,6 +92,7 @@ private:
 
 	mutable QList<HistoryEntryData> mEntries;
 	
+	std::shared_ptr<linphone::Core> mCore;
 	std::shared_ptr<CoreHandlers> mCoreHandlers;
 };
 
@@ -19,6 +19,7 @@
  */
 
 #include <QQuickWindow>
+#include <QSortFilterProxyModel>
 
 #include "app/App.hpp"
 #include "components/core/CoreManager.hpp"
@@ -61,9 +62,20 @@ private:
 
 // =============================================================================
 
-HistoryProxyModel::HistoryProxyModel (QObject *parent) : QSortFilterProxyModel(parent) {
+HistoryProxyModel::HistoryProxyModel (QObject *parent) : QAbstractProxyModel(parent) {
+	HistoryModelFilter *historyModelFilter = new HistoryModelFilter(this);
+	setSourceModel(historyModelFilter);
+	
+	QObject::connect(historyModelFilter, &QAbstractItemModel::modelAboutToBeReset, this, &HistoryProxyModel::beginResetModel);
+	QObject::connect(historyModelFilter, &QAbstractItemModel::modelReset, this, &HistoryProxyModel::handleSourceReset);
+	QObject::connect(historyModelFilter, &QAbstractItemModel::layoutAboutToBeChanged, this, &HistoryProxyModel::beginResetModel);
+	QObject::connect(historyModelFilter, &QAbstractItemModel::layoutChanged, this, &HistoryProxyModel::handleSourceReset);
+	QObject::connect(historyModelFilter, &QAbstractItemModel::rowsAboutToBeInserted, this, &HistoryProxyModel::handleSourceRowsAboutToBeInserted);
+	QObject::connect(historyModelFilter, &QAbstractItemModel::rowsInserted, this, &HistoryProxyModel::handleSourceRowsInserted);
+	QObject::connect(historyModelFilter, &QAbstractItemModel::rowsAboutToBeRemoved, this, &HistoryProxyModel::handleSourceRowsAboutToBeRemoved);
+	QObject::connect(historyModelFilter, &QAbstractItemModel::rowsRemoved, this, &HistoryProxyModel::handleSourceRowsRemoved);
+	QObject::connect(historyModelFilter, &QAbstractItemModel::dataChanged, this, &HistoryProxyModel::handleSourceDataChanged);
 	
-	setSourceModel(new HistoryModelFilter(this));
 	reload();
 	
 	App *app = App::getInstance();
@@ -80,6 +92,42 @@ HistoryProxyModel::HistoryProxyModel (QObject *parent) : QSortFilterProxyModel(p
 
 // -----------------------------------------------------------------------------
 
+QModelIndex HistoryProxyModel::index (int row, int column, const QModelIndex &parent) const {
+	if (parent.isValid() || row < 0 || row >= rowCount() || column != 0)
+		return QModelIndex();
+	return createIndex(row, column);
+}
+
+QModelIndex HistoryProxyModel::parent (const QModelIndex &) const {
+	return QModelIndex();
+}
+
+int HistoryProxyModel::rowCount (const QModelIndex &parent) const {
+	return parent.isValid() ? 0 : sourceModel()->rowCount() - mFirstDisplayedEntry;
+}
+
+int HistoryProxyModel::columnCount (const QModelIndex &parent) const {
+	return parent.isValid() ? 0 : 1;
+}
+
+QHash<int, QByteArray> HistoryProxyModel::roleNames () const {
+	return sourceModel()->roleNames();
+}
+
+QModelIndex HistoryProxyModel::mapToSource (const QModelIndex &proxyIndex) const {
+	if (!proxyIndex.isValid())
+		return QModelIndex();
+	return sourceModel()->index(proxyIndex.row() + mFirstDisplayedEntry, proxyIndex.column());
+}
+
+QModelIndex HistoryProxyModel::mapFromSource (const QModelIndex &sourceIndex) const {
+	if (!sourceIndex.isValid() || sourceIndex.row() < mFirstDisplayedEntry)
+		return QModelIndex();
+	return index(sourceIndex.row() - mFirstDisplayedEntry, sourceIndex.column());
+}
+
+// -----------------------------------------------------------------------------
+
 void HistoryProxyModel::removeAllEntries(){
 	auto model = CoreManager::getInstance()->getHistoryModel();
 	if (!model)
@@ -96,21 +144,15 @@ void HistoryProxyModel::removeEntry (int id){
 // -----------------------------------------------------------------------------
 
 void HistoryProxyModel::loadMoreEntries () {
-	int count = rowCount();
-	int parentCount = sourceModel()->rowCount();
+	if (mFirstDisplayedEntry == 0)
+		return;
 	
-	if (count < parentCount) {
-		// Do not increase `mMaxDisplayedEntries` if it's not necessary...
-		// Limit qml calls.
-		if (count == mMaxDisplayedEntries)
-			mMaxDisplayedEntries += EntriesChunkSize;
-		
-		invalidateFilter();
-		
-		count = rowCount() - count;
-		if (count > 0)
-			emit moreEntriesLoaded(count);
-	}
+	const int count = qMin(EntriesChunkSize, mFirstDisplayedEntry);
+	beginInsertRows(QModelIndex(), 0, count - 1);
+	mFirstDisplayedEntry -= count;
+	endInsertRows();
+	
+	emit moreEntriesLoaded(count);
 }
 
 void HistoryProxyModel::setEntryTypeFilter (HistoryModel::EntryType type) {
@@ -124,14 +166,52 @@ void HistoryProxyModel::setEntryTypeFilter (HistoryModel::EntryType type) {
 
 // -----------------------------------------------------------------------------
 
-bool HistoryProxyModel::filterAcceptsRow (int sourceRow, const QModelIndex &) const {
-	return sourceModel()->rowCount() - sourceRow <= mMaxDisplayedEntries;
+// Source changes. Rows before the window only move it.
+
+void HistoryProxyModel::handleSourceReset () {
+	mFirstDisplayedEntry = qMax(0, sourceModel()->rowCount() - EntriesChunkSize);
+	endResetModel();
+}
+
+void HistoryProxyModel::handleSourceRowsAboutToBeInserted (const QModelIndex &, int first, int last) {
+	mVisibleChange = first >= mFirstDisplayedEntry;
+	if (mVisibleChange)
+		beginInsertRows(QModelIndex(), first - mFirstDisplayedEntry, last - mFirstDisplayedEntry);
+}
+
+void HistoryProxyModel::handleSourceRowsInserted (const QModelIndex &, int first, int last) {
+	if (mVisibleChange)
+		endInsertRows();
+	else
+		mFirstDisplayedEntry += last - first + 1;
+}
+
+void HistoryProxyModel::handleSourceRowsAboutToBeRemoved (const QModelIndex &, int first, int last) {
+	mVisibleChange = last >= mFirstDisplayedEntry;
+	if (mVisibleChange)
+		beginRemoveRows(QModelIndex(), qMax(first, mFirstDisplayedEntry) - mFirstDisplayedEntry, last - mFirstDisplayedEntry);
+}
+
+void HistoryProxyModel::handleSourceRowsRemoved (const QModelIndex &, int first, int last) {
+	if (first < mFirstDisplayedEntry)
+		mFirstDisplayedEntry -= qMin(last, mFirstDisplayedEntry - 1) - first + 1;
+	if (mVisibleChange)
+		endRemoveRows();
+}
+
+void HistoryProxyModel::handleSourceDataChanged (const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles) {
+	if (bottomRight.row() < mFirstDisplayedEntry)
+		return;
+	emit dataChanged(
+		index(qMax(topLeft.row(), mFirstDisplayedEntry) - mFirstDisplayedEntry, 0),
+		index(bottomRight.row() - mFirstDisplayedEntry, 0),
+		roles
+	);
 }
 
 // -----------------------------------------------------------------------------
 
 void HistoryProxyModel::reload () {
-	mMaxDisplayedEntries = EntriesChunkSize;
 	static_cast<HistoryModelFilter *>(sourceModel())->setSourceModel(CoreManager::getInstance()->getHistoryModel());
 }
 void HistoryProxyModel::resetMessageCount(){
@@ -21,7 +21,7 @@
 #ifndef HISTORY_PROXY_MODEL_H_
 #define HISTORY_PROXY_MODEL_H_
 
-#include <QSortFilterProxyModel>
+#include <QAbstractProxyModel>
 
 #include "HistoryModel.hpp"
 
@@ -29,7 +29,9 @@
 
 class QWindow;
 
-class HistoryProxyModel : public QSortFilterProxyModel {
+// Expose the L last filtered history entries. The window is extended by
+// `loadMoreEntries` with a single insertion, without filtering again the source.
+class HistoryProxyModel : public QAbstractProxyModel {
 	class HistoryModelFilter;
 	
 	Q_OBJECT;
@@ -37,6 +39,15 @@ class HistoryProxyModel : public QSortFilterProxyModel {
 public:
 	HistoryProxyModel (QObject *parent = Q_NULLPTR);
 	
+	QModelIndex index (int row, int column, const QModelIndex &parent = QModelIndex()) const override;
+	QModelIndex parent (const QModelIndex &child) const override;
+	int rowCount (const QModelIndex &parent = QModelIndex()) const override;
+	int columnCount (const QModelIndex &parent = QModelIndex()) const override;
+	QHash<int, QByteArray> roleNames () const override;
+	
+	QModelIndex mapToSource (const QModelIndex &proxyIndex) const override;
+	QModelIndex mapFromSource (const QModelIndex &sourceIndex) const override;
+	
 	Q_INVOKABLE void loadMoreEntries ();
 	Q_INVOKABLE void setEntryTypeFilter (HistoryModel::EntryType type = HistoryModel::EntryType::CallEntry);
 	Q_INVOKABLE void removeEntry (int id);
@@ -51,16 +62,21 @@ signals:
 	
 	void entryTypeFilterChanged (HistoryModel::EntryType type);
 	
-protected:
-	bool filterAcceptsRow (int sourceRow, const QModelIndex &sourceParent) const override;
-	
 private:
 	
 	void reload ();
 	
+	void handleSourceReset ();
+	void handleSourceRowsAboutToBeInserted (const QModelIndex &parent, int first, int last);
+	void handleSourceRowsInserted (const QModelIndex &parent, int first, int last);
+	void handleSourceRowsAboutToBeRemoved (const QModelIndex &parent, int first, int last);
+	void handleSourceRowsRemoved (const QModelIndex &parent, int first, int last);
+	void handleSourceDataChanged (const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles);
+	
 	void handleIsActiveChanged (QWindow *window);
 
-	int mMaxDisplayedEntries = EntriesChunkSize;
+	int mFirstDisplayedEntry = 0;	// First source row in the window.
+	bool mVisibleChange = false;	// The current source change is in the window.
 	
 	static constexpr int EntriesChunkSize = 50;
 };
@@ -0,0 +1,386 @@
+/*
+ * Copyright (c) 2010-2020 Belledonne Communications SARL.
+ *
+ * This file is part of linphone-desktop
+ * (see https://www.linphone.org).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <functional>
+
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QtDebug>
+
+#include "components/core/CoreHandlers.hpp"
+#include "components/core/CoreManager.hpp"
+#include "utils/Utils.hpp"
+
+#include "HistoryStatsModel.hpp"
+
+// =============================================================================
+
+using namespace std;
+
+int HistoryStatsModel::Columns::append (const QString &peerAddress, const QString &localAddress) {
+  peerAddresses << peerAddress;
+  localAddresses << localAddress;
+  callCounts << 0;
+  successCounts << 0;
+  missedCounts << 0;
+  declinedCounts << 0;
+  abortedCounts << 0;
+  totalDurations << 0;
+  lastSeens << 0;
+  return peerAddresses.size() - 1;
+}
+
+void HistoryStatsModel::Columns::add (int slot, const shared_ptr<linphone::CallLog> &callLog) {
+  ++callCounts[slot];
+  if (int *count = getStatusCount(slot, callLog))
+    ++*count;
+  totalDurations[slot] += callLog->getDuration();
+  lastSeens[slot] = qMax(lastSeens[slot], qint64(callLog->getStartDate() + callLog->getDuration()));
+}
+
+bool HistoryStatsModel::Columns::remove (int slot, const shared_ptr<linphone::CallLog> &callLog) {
+  --callCounts[slot];
+  if (int *count = getStatusCount(slot, callLog))
+    --*count;
+  totalDurations[slot] -= callLog->getDuration();
+  return qint64(callLog->getStartDate() + callLog->getDuration()) >= lastSeens[slot];
+}
+
+void HistoryStatsModel::Columns::clear () {
+  peerAddresses.clear();
+  localAddresses.clear();
+  callCounts.clear();
+  successCounts.clear();
+  missedCounts.clear();
+  declinedCounts.clear();
+  abortedCounts.clear();
+  totalDurations.clear();
+  lastSeens.clear();
+}
+
+QVariantMap HistoryStatsModel::Columns::toMap (int slot) const {
+  QVariantMap map;
+  map["peerAddress"] = peerAddresses[slot];
+  map["localAddress"] = localAddresses[slot];
+  map["callCount"] = callCounts[slot];
+  map["successCount"] = successCounts[slot];
+  map["missedCount"] = missedCounts[slot];
+  map["declinedCount"] = declinedCounts[slot];
+  map["abortedCount"] = abortedCounts[slot];
+  map["missedRate"] = callCounts[slot] ? double(missedCounts[slot]) / callCounts[slot] : 0.0;
+  map["totalDuration"] = totalDurations[slot];
+  map["lastSeen"] = QDateTime::fromMSecsSinceEpoch(lastSeens[slot] * 1000);
+  return map;
+}
+
+int *HistoryStatsModel::Columns::getStatusCount (int slot, const shared_ptr<linphone::CallLog> &callLog) {
+  switch (callLog->getStatus()) {
+    case linphone::Call::Status::Success:
+    case linphone::Call::Status::AcceptedElsewhere:
+      return &successCounts[slot];
+    case linphone::Call::Status::Missed:
+      return &missedCounts[slot];
+    case linphone::Call::Status::Declined:
+    case linphone::Call::Status::DeclinedElsewhere:
+      return &declinedCounts[slot];
+    case linphone::Call::Status::Aborted:
+    case linphone::Call::Status::EarlyAborted:
+      return &abortedCounts[slot];
+  }
+  return nullptr;
+}
+
+// -----------------------------------------------------------------------------
+
+HistoryStatsModel::HistoryStatsModel (QObject *parent) : HistoryStatsModel(CoreManager::getInstance()->getCore(), parent) {
+  QObject::connect(
+    CoreManager::getInstance()->getHandlers().get(), &CoreHandlers::callLogUpdated,
+    this, &HistoryStatsModel::handleCallLogUpdated
+  );
+}
+
+HistoryStatsModel::HistoryStatsModel (const shared_ptr<linphone::Core> &core, QObject *parent) : QAbstractListModel(parent), mCore(core) {
+  rebuild();
+}
+
+int HistoryStatsModel::rowCount (const QModelIndex &) const {
+  return mOrder.count();
+}
+
+QHash<int, QByteArray> HistoryStatsModel::roleNames () const {
+  QHash<int, QByteArray> roles;
+  roles[PeerAddressRole] = "peerAddress";
+  roles[LocalAddressRole] = "localAddress";
+  roles[CallCountRole] = "callCount";
+  roles[SuccessCountRole] = "successCount";
+  roles[MissedCountRole] = "missedCount";
+  roles[DeclinedCountRole] = "declinedCount";
+  roles[AbortedCountRole] = "abortedCount";
+  roles[MissedRateRole] = "missedRate";
+  roles[TotalDurationRole] = "totalDuration";
+  roles[LastSeenRole] = "lastSeen";
+  return roles;
+}
+
+QVariant HistoryStatsModel::data (const QModelIndex &index, int role) const {
+  int row = index.row();
+
+  if (!index.isValid() || row < 0 || row >= mOrder.count())
+    return QVariant();
+
+  const int slot = mOrder[row];
+  switch (role) {
+    case PeerAddressRole:
+      return mStats.peerAddresses[slot];
+    case LocalAddressRole:
+      return mStats.localAddresses[slot];
+    case CallCountRole:
+      return mStats.callCounts[slot];
+    case SuccessCountRole:
+      return mStats.successCounts[slot];
+    case MissedCountRole:
+      return mStats.missedCounts[slot];
+    case DeclinedCountRole:
+      return mStats.declinedCounts[slot];
+    case AbortedCountRole:
+      return mStats.abortedCounts[slot];
+    case MissedRateRole:
+      return mStats.callCounts[slot] ? double(mStats.missedCounts[slot]) / mStats.callCounts[slot] : 0.0;
+    case TotalDurationRole:
+      return mStats.totalDurations[slot];
+    case LastSeenRole:
+      return QDateTime::fromMSecsSinceEpoch(mStats.lastSeens[slot] * 1000);
+  }
+
+  return QVariant();
+}
+
+// -----------------------------------------------------------------------------
+
+void HistoryStatsModel::sortBy (const QString &roleName, bool ascending) {
+  const int role = roleNames().key(roleName.toUtf8(), -1);
+  if (role == -1) {
+    qWarning() << QStringLiteral("Unable to sort history stats by unknown role: `%1`.").arg(roleName);
+    return;
+  }
+
+  // Compare columns directly, without QVariant.
+  function<bool(int, int)> lessThan;
+  #define SORT_BY_COLUMN(ROLE, COLUMN) \
+    case ROLE: \
+      lessThan = [this](int a, int b) { return mStats.COLUMN[a] < mStats.COLUMN[b]; }; \
+      break;
+
+  switch (role) {
+    SORT_BY_COLUMN(PeerAddressRole, peerAddresses);
+    SORT_BY_COLUMN(LocalAddressRole, localAddresses);
+    SORT_BY_COLUMN(CallCountRole, callCounts);
+    SORT_BY_COLUMN(SuccessCountRole, successCounts);
+    SORT_BY_COLUMN(MissedCountRole, missedCounts);
+    SORT_BY_COLUMN(DeclinedCountRole, declinedCounts);
+    SORT_BY_COLUMN(AbortedCountRole, abortedCounts);
+    SORT_BY_COLUMN(TotalDurationRole, totalDurations);
+    SORT_BY_COLUMN(LastSeenRole, lastSeens);
+    case MissedRateRole:
+      lessThan = [this](int a, int b) {
+        // a.missed / a.count < b.missed / b.count
+        return qint64(mStats.missedCounts[a]) * mStats.callCounts[b] < qint64(mStats.missedCounts[b]) * mStats.callCounts[a];
+      };
+      break;
+  }
+
+  #undef SORT_BY_COLUMN
+
+  emit layoutAboutToBeChanged();
+  if (ascending)
+    stable_sort(mOrder.begin(), mOrder.end(), lessThan);
+  else
+    stable_sort(mOrder.begin(), mOrder.end(), [&lessThan](int a, int b) { return lessThan(b, a); });
+  for (int row = 0; row < mOrder.count(); ++row)
+    mRows[mOrder[row]] = row;
+  emit layoutChanged();
+}
+
+QVariantMap HistoryStatsModel::getPeerStats (const QString &peerAddress, const QString &localAddress) const {
+  if (localAddress.isEmpty()) {
+    auto it = mPeerSlots.constFind(peerAddress);
+    return it == mPeerSlots.cend() ? QVariantMap() : mPeerStats.toMap(*it);
+  }
+  auto it = mSlots.constFind(getKey(peerAddress, localAddress));
+  return it == mSlots.cend() ? QVariantMap() : mStats.toMap(*it);
+}
+
+// -----------------------------------------------------------------------------
+
+void HistoryStatsModel::rebuild () {
+  QElapsedTimer timer;
+  timer.start();
+
+  beginResetModel();
+
+  clear();
+  for (const auto &callLog : mCore->getCallLogs())
+    addCallLog(callLog, false);
+
+  endResetModel();
+
+  qInfo() << QStringLiteral("HistoryStatsModel built from %1 call logs in %2 milliseconds.")
+    .arg(mCallIds.count()).arg(timer.elapsed());
+}
+
+// The columns of the call log are updated in place, without going through all call logs
+// again. Only the last seen date may need the other call logs of the peer.
+void HistoryStatsModel::removeCallLog (const shared_ptr<linphone::CallLog> &callLog) {
+  const QString callId = Utils::coreStringToAppString(callLog->getCallId());
+  if (!callId.isEmpty() && !mCallIds.remove(callId))
+    return; // Not counted.
+
+  const QString peerAddress = Utils::coreStringToAppString(callLog->getRemoteAddress()->asStringUriOnly());
+  const QString localAddress = Utils::coreStringToAppString(callLog->getLocalAddress()->asStringUriOnly());
+  const QString key = getKey(peerAddress, localAddress);
+  auto peerIt = mPeerSlots.constFind(peerAddress);
+  auto it = mSlots.constFind(key);
+  if (peerIt == mPeerSlots.cend() || it == mSlots.cend())
+    return;
+  const int peerSlot = *peerIt;
+  const int slot = *it;
+
+  // 1. Peer and local address stats. A row without call logs is removed.
+  const bool lastSeenRemoved = mStats.remove(slot, callLog);
+  if (mStats.callCounts[slot] == 0) {
+    mSlots.remove(key);
+    removeSlotRow(slot);
+  } else {
+    if (lastSeenRemoved)
+      mStats.lastSeens[slot] = getLastSeen(callLog);
+    const QModelIndex index = this->index(mRows[slot]);
+    emit dataChanged(index, index);
+  }
+
+  // 2. Peer stats, from the rows of the peer for the last seen date.
+  if (!mPeerStats.remove(peerSlot, callLog))
+    return;
+  if (mPeerStats.callCounts[peerSlot] == 0)
+    mPeerSlots.remove(peerAddress);
+  else
+    mPeerStats.lastSeens[peerSlot] = getPeerLastSeen(peerAddress);
+}
+
+void HistoryStatsModel::removeAllCallLogs () {
+  beginResetModel();
+  clear();
+  endResetModel();
+}
+
+// -----------------------------------------------------------------------------
+
+QString HistoryStatsModel::getKey (const QString &peerAddress, const QString &localAddress) {
+  return peerAddress + QLatin1Char(' ') + localAddress;
+}
+
+void HistoryStatsModel::handleCallLogUpdated (const shared_ptr<linphone::CallLog> &callLog) {
+  addCallLog(callLog, true);
+}
+
+bool HistoryStatsModel::addCallLog (const shared_ptr<linphone::CallLog> &callLog, bool notify) {
+  const QString callId = Utils::coreStringToAppString(callLog->getCallId());
+  if (!callId.isEmpty()) {
+    if (mCallIds.contains(callId))
+      return false;
+    mCallIds.insert(callId);
+  }
+
+  const QString peerAddress = Utils::coreStringToAppString(callLog->getRemoteAddress()->asStringUriOnly());
+  const QString localAddress = Utils::coreStringToAppString(callLog->getLocalAddress()->asStringUriOnly());
+
+  // 1. Peer stats.
+  auto peerIt = mPeerSlots.find(peerAddress);
+  if (peerIt == mPeerSlots.end())
+    peerIt = mPeerSlots.insert(peerAddress, mPeerStats.append(peerAddress, QString("")));
+  mPeerStats.add(*peerIt, callLog);
+
+  // 2. Peer and local address stats.
+  const QString key = getKey(peerAddress, localAddress);
+  auto it = mSlots.find(key);
+  if (it != mSlots.end()) {
+    mStats.add(*it, callLog);
+    if (notify) {
+      const QModelIndex index = this->index(mRows[*it]);
+      emit dataChanged(index, index);
+    }
+    return true;
+  }
+
+  const int slot = mStats.append(peerAddress, localAddress);
+  mStats.add(slot, callLog);
+  mSlots.insert(key, slot);
+
+  const int row = mOrder.count();
+  if (notify)
+    beginInsertRows(QModelIndex(), row, row);
+  mOrder << slot;
+  mRows << row;
+  if (notify)
+    endInsertRows();
+
+  return true;
+}
+
+// The slot of the row is not reused: it is freed by the next `rebuild`.
+void HistoryStatsModel::removeSlotRow (int slot) {
+  const int row = mRows[slot];
+  beginRemoveRows(QModelIndex(), row, row);
+  mOrder.remove(row);
+  mRows[slot] = -1;
+  for (int i = row; i < mOrder.count(); ++i)
+    mRows[mOrder[i]] = i;
+  endRemoveRows();
+}
+
+void HistoryStatsModel::clear () {
+  mStats.clear();
+  mPeerStats.clear();
+  mSlots.clear();
+  mPeerSlots.clear();
+  mCallIds.clear();
+  mOrder.clear();
+  mRows.clear();
+}
+
+// -----------------------------------------------------------------------------
+
+qint64 HistoryStatsModel::getLastSeen (const shared_ptr<linphone::CallLog> &callLog) const {
+  qint64 lastSeen = 0;
+  for (const auto &otherCallLog : mCore->getCallHistory(callLog->getRemoteAddress(), callLog->getLocalAddress())) {
+    if (otherCallLog != callLog)
+      lastSeen = qMax(lastSeen, qint64(otherCallLog->getStartDate() + otherCallLog->getDuration()));
+  }
+  return lastSeen;
+}
+
+qint64 HistoryStatsModel::getPeerLastSeen (const QString &peerAddress) const {
+  qint64 lastSeen = 0;
+  for (int slot : mOrder) {
+    if (mStats.peerAddresses[slot] == peerAddress)
+      lastSeen = qMax(lastSeen, mStats.lastSeens[slot]);
+  }
+  return lastSeen;
+}
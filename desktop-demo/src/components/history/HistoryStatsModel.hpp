@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2010-2020 Belledonne Communications SARL.
+ *
+ * This file is part of linphone-desktop
+ * (see https://www.linphone.org).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef HISTORY_STATS_MODEL_H_
+#define HISTORY_STATS_MODEL_H_
+
+#include <memory>
+
+#include <QAbstractListModel>
+#include <QHash>
+#include <QSet>
+#include <QVector>
+
+// =============================================================================
+// Call statistics by peer and local address, updated for each new or removed call log.
+// =============================================================================
+
+namespace linphone {
+  class CallLog;
+  class Core;
+}
+
+class HistoryStatsModel : public QAbstractListModel {
+  Q_OBJECT;
+
+public:
+  enum Roles {
+    PeerAddressRole = Qt::UserRole,
+    LocalAddressRole,
+    CallCountRole,
+    SuccessCountRole,
+    MissedCountRole,
+    DeclinedCountRole,
+    AbortedCountRole,
+    MissedRateRole,
+    TotalDurationRole,
+    LastSeenRole
+  };
+
+  HistoryStatsModel (QObject *parent = Q_NULLPTR);
+  // Stats of the call logs of `core`, not updated by its new call logs.
+  HistoryStatsModel (const std::shared_ptr<linphone::Core> &core, QObject *parent = Q_NULLPTR);
+
+  int rowCount (const QModelIndex &index = QModelIndex()) const override;
+
+  QHash<int, QByteArray> roleNames () const override;
+  QVariant data (const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+  // Keep the current order until the next `sortBy` call. New peers are added at the end.
+  Q_INVOKABLE void sortBy (const QString &roleName, bool ascending = false);
+
+  // Stats of one peer, on all local addresses if `localAddress` is empty.
+  Q_INVOKABLE QVariantMap getPeerStats (const QString &peerAddress, const QString &localAddress = QString("")) const;
+
+  // Compute again all stats from the call logs of the core.
+  Q_INVOKABLE void rebuild ();
+
+  // Subtract call logs removed from the core. Called by `HistoryModel`.
+  void removeCallLog (const std::shared_ptr<linphone::CallLog> &callLog);
+  void removeAllCallLogs ();
+
+private:
+  // Columns of one aggregate.
+  struct Columns {
+    QVector<QString> peerAddresses;
+    QVector<QString> localAddresses;
+    QVector<int> callCounts;
+    QVector<int> successCounts;
+    QVector<int> missedCounts;
+    QVector<int> declinedCounts;
+    QVector<int> abortedCounts;
+    QVector<qint64> totalDurations; // In seconds.
+    QVector<qint64> lastSeens; // In seconds since epoch.
+
+    int append (const QString &peerAddress, const QString &localAddress);
+    void add (int slot, const std::shared_ptr<linphone::CallLog> &callLog);
+    // Return true if the last seen date has to be computed again.
+    bool remove (int slot, const std::shared_ptr<linphone::CallLog> &callLog);
+    void clear ();
+    QVariantMap toMap (int slot) const;
+
+    int *getStatusCount (int slot, const std::shared_ptr<linphone::CallLog> &callLog);
+  };
+
+  static QString getKey (const QString &peerAddress, const QString &localAddress);
+
+  void handleCallLogUpdated (const std::shared_ptr<linphone::CallLog> &callLog);
+  bool addCallLog (const std::shared_ptr<linphone::CallLog> &callLog, bool notify);
+  void removeSlotRow (int slot);
+  void clear ();
+
+  qint64 getLastSeen (const std::shared_ptr<linphone::CallLog> &callLog) const;
+  qint64 getPeerLastSeen (const QString &peerAddress) const;
+
+  std::shared_ptr<linphone::Core> mCore;
+
+  Columns mStats; // By peer and local address.
+  Columns mPeerStats; // By peer.
+  QHash<QString, int> mSlots;
+  QHash<QString, int> mPeerSlots;
+  QSet<QString> mCallIds; // Avoid to count the same call log twice.
+
+  QVector<int> mOrder; // Row to slot.
+  QVector<int> mRows; // Slot to row, -1 for a slot without call logs. Its key is removed.
+};
+
+#endif // HISTORY_STATS_MODEL_H_
@@ -284,7 +284,7 @@ void Notifier::notifyReceivedMessage (const shared_ptr<linphone::ChatMessage> &m
 void Notifier::notifyReceivedFileMessage (const shared_ptr<linphone::ChatMessage> &message) {
   QVariantMap map;
   map["fileUri"] = Utils::coreStringToAppString(message->getFileTransferInformation()->getFilePath());
-  if( Utils::getImage(map["fileUri"].toString()).isNull())
+  if(!Utils::isImage(map["fileUri"].toString()))
     map["imageUri"] = "";
   else
     map["imageUri"] = map["fileUri"];
@@ -490,6 +490,17 @@ void SettingsModel::setShowVideoCodecs (bool status) {
 	emit showVideoCodecsChanged(status);
 }
 
+// -----------------------------------------------------------------------------
+
+bool SettingsModel::getVideoFrameStatsOverlay () const {
+	return !!mConfig->getInt(UiSection, "video_frame_stats_overlay", 0);
+}
+
+void SettingsModel::setVideoFrameStatsOverlay (bool status) {
+	mConfig->setInt(UiSection, "video_frame_stats_overlay", status);
+	emit videoFrameStatsOverlayChanged(status);
+}
+
 // =============================================================================
 // Chat & calls.
 // =============================================================================
@@ -582,6 +593,27 @@ void SettingsModel::setAutomaticallyRecordCalls (bool status) {
 
 // -----------------------------------------------------------------------------
 
+bool SettingsModel::getCallQualityRecordingEnabled () const {
+	return !!mConfig->getInt(UiSection, "call_quality_recording_enabled", 1);
+}
+
+void SettingsModel::setCallQualityRecordingEnabled (bool status) {
+	mConfig->setInt(UiSection, "call_quality_recording_enabled", status);
+	emit callQualityRecordingEnabledChanged(status);
+}
+
+// Size limit of all call quality records, in bytes.
+qint64 SettingsModel::getCallQualityRecordingQuota () const {
+	return qint64(qMax(mConfig->getInt(UiSection, "call_quality_recording_quota_mb", 32), 1)) * 1024 * 1024;
+}
+
+// Sampling rate of the call volumes, in Hz.
+int SettingsModel::getVuMeterRate () const {
+	return qBound(1, mConfig->getInt(UiSection, "vu_meter_rate", 20), 60);
+}
+
+// -----------------------------------------------------------------------------
+
 bool SettingsModel::getCallPauseEnabled () const {
 	return !!mConfig->getInt(UiSection, "call_pause_enabled", 1);
 }
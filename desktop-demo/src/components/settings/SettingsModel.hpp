@@ -84,6 +84,8 @@ class SettingsModel : public QObject {
 
     Q_PROPERTY(bool showVideoCodecs READ getShowVideoCodecs WRITE setShowVideoCodecs NOTIFY showVideoCodecsChanged)
 
+    Q_PROPERTY(bool videoFrameStatsOverlay READ getVideoFrameStatsOverlay WRITE setVideoFrameStatsOverlay NOTIFY videoFrameStatsOverlayChanged)
+
 	// Chat & calls. -------------------------------------------------------------
 
     Q_PROPERTY(bool autoAnswerStatus READ getAutoAnswerStatus WRITE setAutoAnswerStatus NOTIFY autoAnswerStatusChanged)
@@ -98,6 +100,7 @@ class SettingsModel : public QObject {
 
     Q_PROPERTY(bool callRecorderEnabled READ getCallRecorderEnabled WRITE setCallRecorderEnabled NOTIFY callRecorderEnabledChanged)
     Q_PROPERTY(bool automaticallyRecordCalls READ getAutomaticallyRecordCalls WRITE setAutomaticallyRecordCalls NOTIFY automaticallyRecordCallsChanged)
+    Q_PROPERTY(bool callQualityRecordingEnabled READ getCallQualityRecordingEnabled WRITE setCallQualityRecordingEnabled NOTIFY callQualityRecordingEnabledChanged)
 
     Q_PROPERTY(bool callPauseEnabled READ getCallPauseEnabled WRITE setCallPauseEnabled NOTIFY callPauseEnabledChanged)
     Q_PROPERTY(bool muteMicrophoneEnabled READ getMuteMicrophoneEnabled WRITE setMuteMicrophoneEnabled NOTIFY muteMicrophoneEnabledChanged)
@@ -286,6 +289,9 @@ public:
 	bool getShowVideoCodecs () const;
 	void setShowVideoCodecs (bool status);
 
+	bool getVideoFrameStatsOverlay () const;
+	void setVideoFrameStatsOverlay (bool status);
+
 	// Chat & calls. -------------------------------------------------------------
 
 	bool getAutoAnswerStatus () const;
@@ -312,6 +318,13 @@ public:
 	bool getAutomaticallyRecordCalls () const;
 	void setAutomaticallyRecordCalls (bool status);
 
+	bool getCallQualityRecordingEnabled () const;
+	void setCallQualityRecordingEnabled (bool status);
+
+	qint64 getCallQualityRecordingQuota () const;
+
+	int getVuMeterRate () const;
+
 	bool getCallPauseEnabled () const;
 	void setCallPauseEnabled (bool status);
 
@@ -517,6 +530,8 @@ signals:
 
 	void showVideoCodecsChanged (bool status);
 
+	void videoFrameStatsOverlayChanged (bool status);
+
 	// Chat & calls. -------------------------------------------------------------
 
 	void autoAnswerStatusChanged (bool status);
@@ -531,6 +546,7 @@ signals:
 
 	void callRecorderEnabledChanged (bool status);
 	void automaticallyRecordCallsChanged (bool status);
+	void callQualityRecordingEnabledChanged (bool status);
 
 	void callPauseEnabledChanged (bool status);
 	void muteMicrophoneEnabledChanged (bool status);
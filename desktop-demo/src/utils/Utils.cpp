@@ -50,15 +50,15 @@ char *Utils::rstrstr (const char *a, const char *b) {
 
 // -----------------------------------------------------------------------------
 QImage Utils::getImage(const QString &pUri) {
-	QImage image(pUri);
-	if(image.isNull()){// Try to determine format from headers instead of using suffix
-		QImageReader reader(pUri);
-		reader.setDecideFormatFromContent(true);
-		QByteArray format = reader.format();
-		if(!format.isEmpty())
-			image = QImage(pUri, format);
-	}
-	return image;
+	// Determine the format from headers instead of using suffix, in one pass.
+	QImageReader reader(pUri);
+	reader.setDecideFormatFromContent(true);
+	return reader.read();
+}
+bool Utils::isImage(const QString &pUri) {
+	QImageReader reader(pUri);
+	reader.setDecideFormatFromContent(true);
+	return reader.canRead();
 }
 QString Utils::getSafeFilePath (const QString &filePath, bool *soFarSoGood) {
   if (soFarSoGood)
@@ -56,6 +56,8 @@ namespace Utils {
   char *rstrstr (const char *a, const char *b);
   // Return the path if it is an image else an empty path.
   QImage getImage(const QString &pUri);
+  // Checks the headers only, without decoding.
+  bool isImage(const QString &pUri);
   // Returns the same path given in parameter if `filePath` exists.
   // Otherwise returns a safe path with a unique number before the extension.
   QString getSafeFilePath (const QString &filePath, bool *soFarSoGood = nullptr);
@@ -0,0 +1,15 @@
+TEMPLATE = app
+TARGET = call-quality-analyzer
+DESTDIR = ../../../Debug
+
+QT -= gui
+QT += core
+
+CONFIG += c++11 console
+CONFIG -= app_bundle
+
+INCLUDEPATH += $$PWD/../../src
+
+SOURCES += main.cpp
+
+HEADERS += ../../src/components/call/CallQualityRecord.hpp
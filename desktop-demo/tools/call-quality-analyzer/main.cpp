@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2010-2020 Belledonne Communications SARL.
+ *
+ * This file is part of linphone-desktop
+ * (see https://www.linphone.org).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDateTime>
+#include <QFile>
+#include <QTextStream>
+
+#include "components/call/CallQualityRecord.hpp"
+
+// =============================================================================
+// Print percentiles of the stats of call quality files and flag the windows
+// where the quality was degraded.
+// =============================================================================
+
+using namespace std;
+
+namespace {
+  struct Thresholds {
+    float lossRate = 5.0f; // In %.
+    float roundTripDelay = 0.4f; // In seconds.
+    float jitterBuffer = 150.0f; // In ms.
+    float framerate = 10.0f;
+  };
+
+  struct Metric {
+    const char *name;
+    const char *unit;
+    quint32 flag;
+    float CallQuality::Record::*field;
+  };
+
+  const Metric Metrics[] = {
+    { "audio upload", "kbits/s", CallQuality::HasAudio, &CallQuality::Record::audioUploadBandwidth },
+    { "audio download", "kbits/s", CallQuality::HasAudio, &CallQuality::Record::audioDownloadBandwidth },
+    { "audio sender loss", "%", CallQuality::HasAudio, &CallQuality::Record::audioSenderLossRate },
+    { "audio receiver loss", "%", CallQuality::HasAudio, &CallQuality::Record::audioReceiverLossRate },
+    { "audio rtt", "s", CallQuality::HasAudio, &CallQuality::Record::audioRoundTripDelay },
+    { "audio jitter buffer", "ms", CallQuality::HasAudio, &CallQuality::Record::audioJitterBuffer },
+    { "video upload", "kbits/s", CallQuality::HasVideo, &CallQuality::Record::videoUploadBandwidth },
+    { "video download", "kbits/s", CallQuality::HasVideo, &CallQuality::Record::videoDownloadBandwidth },
+    { "video sender loss", "%", CallQuality::HasVideo, &CallQuality::Record::videoSenderLossRate },
+    { "video receiver loss", "%", CallQuality::HasVideo, &CallQuality::Record::videoReceiverLossRate },
+    { "video rtt", "s", CallQuality::HasVideo, &CallQuality::Record::videoRoundTripDelay },
+    { "video received fps", "", CallQuality::HasVideo, &CallQuality::Record::videoReceivedFramerate },
+    { "video sent fps", "", CallQuality::HasVideo, &CallQuality::Record::videoSentFramerate }
+  };
+}
+
+static float getPercentile (const vector<float> &sortedValues, double percentile) {
+  const size_t index = size_t(percentile * (sortedValues.size() - 1) + 0.5);
+  return sortedValues[index];
+}
+
+static QString getDegradationReason (const CallQuality::Record &record, const Thresholds &thresholds) {
+  QStringList reasons;
+  if (record.flags & CallQuality::HasAudio) {
+    if (record.audioReceiverLossRate > thresholds.lossRate || record.audioSenderLossRate > thresholds.lossRate)
+      reasons << QStringLiteral("audio loss");
+    if (record.audioRoundTripDelay > thresholds.roundTripDelay)
+      reasons << QStringLiteral("audio rtt");
+    if (record.audioJitterBuffer > thresholds.jitterBuffer)
+      reasons << QStringLiteral("jitter");
+  }
+  if (record.flags & CallQuality::HasVideo) {
+    if (record.videoReceiverLossRate > thresholds.lossRate || record.videoSenderLossRate > thresholds.lossRate)
+      reasons << QStringLiteral("video loss");
+    if (record.videoReceivedFramerate > 0 && record.videoReceivedFramerate < thresholds.framerate)
+      reasons << QStringLiteral("framerate");
+  }
+  return reasons.join(", ");
+}
+
+static bool analyze (const QString &filePath, const Thresholds &thresholds, int minWindow, QTextStream &out) {
+  QFile file(filePath);
+  if (!file.open(QIODevice::ReadOnly)) {
+    out << QStringLiteral("%1: unable to open (%2).").arg(filePath).arg(file.errorString()) << "\n";
+    return false;
+  }
+
+  const QByteArray data = file.readAll();
+  if (data.size() < int(sizeof(CallQuality::FileHeader))) {
+    out << QStringLiteral("%1: truncated header.").arg(filePath) << "\n";
+    return false;
+  }
+
+  CallQuality::FileHeader header;
+  memcpy(&header, data.constData(), sizeof header);
+  if (header.magic != CallQuality::Magic || header.version != CallQuality::Version || header.recordSize != sizeof(CallQuality::Record)) {
+    out << QStringLiteral("%1: unsupported file.").arg(filePath) << "\n";
+    return false;
+  }
+
+  // The file can be bigger if the app has not stopped the recording.
+  const quint32 count = qMin(
+    header.recordCount,
+    quint32((data.size() - int(sizeof header)) / int(sizeof(CallQuality::Record)))
+  );
+  vector<CallQuality::Record> records(count);
+  if (count)
+    memcpy(records.data(), data.constData() + sizeof header, count * sizeof(CallQuality::Record));
+
+  header.peerAddress[sizeof header.peerAddress - 1] = '\0';
+  out << QStringLiteral("%1\n  peer: %2\n  start: %3\n  samples: %4 (every %5 ms)")
+    .arg(filePath)
+    .arg(QString::fromUtf8(header.peerAddress))
+    .arg(QDateTime::fromMSecsSinceEpoch(header.startTime).toString(Qt::ISODate))
+    .arg(count)
+    .arg(header.sampleInterval) << "\n";
+
+  // 1. Percentiles.
+  out << QStringLiteral("  %1 %2 %3 %4 %5")
+    .arg("metric", -28).arg("p50", 10).arg("p95", 10).arg("p99", 10).arg("max", 10) << "\n";
+  for (const Metric &metric : Metrics) {
+    vector<float> values;
+    values.reserve(count);
+    for (const CallQuality::Record &record : records)
+      if (record.flags & metric.flag)
+        values.push_back(record.*metric.field);
+    if (values.empty())
+      continue;
+
+    sort(values.begin(), values.end());
+    out << QStringLiteral("  %1 %2 %3 %4 %5")
+      .arg(QStringLiteral("%1 (%2)").arg(metric.name).arg(metric.unit), -28)
+      .arg(double(getPercentile(values, 0.50)), 10, 'f', 2)
+      .arg(double(getPercentile(values, 0.95)), 10, 'f', 2)
+      .arg(double(getPercentile(values, 0.99)), 10, 'f', 2)
+      .arg(double(values.back()), 10, 'f', 2) << "\n";
+  }
+
+  // 2. Degradation windows: at least `minWindow` consecutive degraded samples.
+  int windowCount = 0;
+  for (quint32 i = 0; i < count; ) {
+    const QString reason = getDegradationReason(records[i], thresholds);
+    if (reason.isEmpty()) {
+      ++i;
+      continue;
+    }
+
+    quint32 end = i + 1;
+    QStringList reasons = reason.split(", ");
+    for (; end < count; ++end) {
+      const QString next = getDegradationReason(records[end], thresholds);
+      if (next.isEmpty())
+        break;
+      for (const QString &r : next.split(", "))
+        if (!reasons.contains(r))
+          reasons << r;
+    }
+
+    if (int(end - i) >= minWindow) {
+      if (!windowCount++)
+        out << QStringLiteral("  degraded windows:") << "\n";
+      out << QStringLiteral("    %1s - %2s: %3")
+        .arg(records[i].time / 1000.0, 0, 'f', 1)
+        .arg(records[end - 1].time / 1000.0, 0, 'f', 1)
+        .arg(reasons.join(", ")) << "\n";
+    }
+    i = end;
+  }
+  if (!windowCount)
+    out << QStringLiteral("  no degraded window.") << "\n";
+
+  return true;
+}
+
+int main (int argc, char *argv[]) {
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setApplicationName("call-quality-analyzer");
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription("Analyze call quality files.");
+  parser.addHelpOption();
+  parser.addPositionalArgument("files", "Call quality files (*.cqr).", "files...");
+  parser.addOptions({
+    { "loss", "Loss rate threshold in %.", "loss", "5" },
+    { "rtt", "Round trip delay threshold in seconds.", "rtt", "0.4" },
+    { "jitter", "Jitter buffer threshold in ms.", "jitter", "150" },
+    { "fps", "Received framerate threshold.", "fps", "10" },
+    { "window", "Minimum number of consecutive degraded samples.", "window", "3" }
+  });
+  parser.process(app);
+
+  const QStringList files = parser.positionalArguments();
+  if (files.isEmpty())
+    parser.showHelp(1);
+
+  Thresholds thresholds;
+  thresholds.lossRate = parser.value("loss").toFloat();
+  thresholds.roundTripDelay = parser.value("rtt").toFloat();
+  thresholds.jitterBuffer = parser.value("jitter").toFloat();
+  thresholds.framerate = parser.value("fps").toFloat();
+  const int minWindow = qMax(parser.value("window").toInt(), 1);
+
+  QTextStream out(stdout);
+  bool ok = true;
+  for (const QString &file : files)
+    ok = analyze(file, thresholds, minWindow, out) && ok;
+
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,23 @@
+TEMPLATE = app
+TARGET = icon-atlas
+DESTDIR = ../../../Debug
+
+QT += gui quick svg
+
+CONFIG += c++11 console
+CONFIG -= app_bundle
+
+INCLUDEPATH += $$PWD/../../src \
+               $$PWD/../../sdk/linux/linphone-sdk/desktop/include
+
+SOURCES += main.cpp \
+        ../../src/app/providers/IconAtlas.cpp \
+        ../../src/app/providers/IconRenderer.cpp \
+        ../../src/app/tracer/Tracer.cpp \
+        ../../src/components/other/colors/Colors.cpp
+
+HEADERS += \
+	../../src/app/providers/IconAtlas.hpp \
+	../../src/app/providers/IconRenderer.hpp \
+	../../src/app/tracer/Tracer.hpp \
+	../../src/components/other/colors/Colors.hpp
@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2010-2020 Belledonne Communications SARL.
+ *
+ * This file is part of linphone-desktop
+ * (see https://www.linphone.org).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+
+#include <QCommandLineParser>
+#include <QDir>
+#include <QGuiApplication>
+#include <QPainter>
+#include <QSet>
+#include <QTextStream>
+
+#include "app/providers/IconAtlas.hpp"
+#include "app/providers/IconRenderer.hpp"
+#include "gitversion.h"
+
+// =============================================================================
+// Renders the svg icons with the colors of the theme at the usual sizes and
+// device pixel ratios, and packs them in the atlas served by `ImageProvider`.
+// Run by the desktop-demo build when this tool is built.
+// =============================================================================
+
+using namespace std;
+
+namespace {
+  constexpr char DefaultIdPrefix[] = "/assets/images/";
+  constexpr char DefaultSizes[] = "16,18,20,22,24,40"; // The `iconSize` of the styles.
+  constexpr char DefaultRatios[] = "1,2";
+  constexpr int DefaultPageSize = 1024;
+
+  // Transparent border around each icon: the linear filtering does not read the neighbours.
+  constexpr int Padding = 1;
+
+  struct Icon {
+    QString key;
+    QImage image;
+  };
+}
+
+static QList<qreal> parseNumbers (const QString &value, bool &ok) {
+  QList<qreal> numbers;
+  ok = true;
+  for (const QString &item : value.split(',', QString::SkipEmptyParts)) {
+    const qreal number = item.trimmed().toDouble(&ok);
+    if (!ok || number <= 0) {
+      ok = false;
+      return QList<qreal>();
+    }
+    numbers << number;
+  }
+  return numbers;
+}
+
+static QStringList readIconNames (const QString &sourcesPath, const QString &listPath) {
+  if (listPath.isEmpty())
+    return QDir(sourcesPath).entryList(QStringList("*.svg"), QDir::Files, QDir::Name);
+
+  QStringList names;
+  QFile file(listPath);
+  if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    return names;
+
+  QTextStream stream(&file);
+  while (!stream.atEnd()) {
+    const QString line = stream.readLine().trimmed();
+    if (!line.isEmpty() && !line.startsWith('#'))
+      names << (line.endsWith(".svg") ? line : line + ".svg");
+  }
+  return names;
+}
+
+// Shelf packing. The icons are sorted by height, so a shelf holds icons of
+// the same size. A new page is started for each ratio: a session loads only
+// the pages of its screen.
+static void pack (
+  const QList<QVector<Icon>> &groups,
+  int pageSize,
+  QVector<QImage> &pages,
+  QHash<QString, IconAtlas::Entry> &entries
+) {
+  for (QVector<Icon> icons : groups) {
+    stable_sort(icons.begin(), icons.end(), [](const Icon &a, const Icon &b) {
+      return a.image.height() > b.image.height();
+    });
+
+    QImage page;
+    QPainter painter;
+    int x = 0, y = 0, shelfHeight = 0;
+    auto finishPage = [&] {
+      if (page.isNull())
+        return;
+      painter.end();
+      pages << page.copy(0, 0, pageSize, y + shelfHeight);
+      page = QImage();
+    };
+
+    for (const Icon &icon : icons) {
+      const int width = icon.image.width() + 2 * Padding;
+      const int height = icon.image.height() + 2 * Padding;
+      if (width > pageSize || height > pageSize) {
+        qWarning() << QStringLiteral("Icon `%1` is larger than a page.").arg(icon.key);
+        continue;
+      }
+
+      if (x + width > pageSize) {
+        x = 0;
+        y += shelfHeight;
+        shelfHeight = 0;
+      }
+      if (page.isNull() || y + height > pageSize) {
+        finishPage();
+        page = QImage(pageSize, pageSize, QImage::Format_ARGB32_Premultiplied);
+        page.fill(Qt::transparent);
+        painter.begin(&page);
+        painter.setCompositionMode(QPainter::CompositionMode_Source);
+        x = y = shelfHeight = 0;
+      }
+
+      painter.drawImage(x + Padding, y + Padding, icon.image);
+
+      IconAtlas::Entry entry;
+      entry.page = pages.count();
+      entry.rect = QRect(QPoint(x + Padding, y + Padding), icon.image.size());
+      entries[icon.key] = entry;
+
+      x += width;
+      shelfHeight = max(shelfHeight, height);
+    }
+
+    finishPage();
+  }
+}
+
+int main (int argc, char *argv[]) {
+  // The svg renderer needs a gui application, not a display.
+  if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+    qputenv("QT_QPA_PLATFORM", "offscreen");
+
+  QGuiApplication app(argc, argv);
+  // Part of the theme hash: the atlas is ignored by the other versions.
+  QCoreApplication::setApplicationVersion(LINPHONE_QT_GIT_VERSION);
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription("Build the themed icon atlas of the application.");
+  parser.addHelpOption();
+  parser.addOptions({
+    { "sources", "Folder of the svg icons.", "dir" },
+    { "output", "Atlas file to write.", "file" },
+    { "icons", "File listing the icons to pack, one by line. All the icons by default.", "file" },
+    { "sizes", QStringLiteral("Icon sizes in logical pixels. (default: %1)").arg(DefaultSizes), "sizes", DefaultSizes },
+    { "ratios", QStringLiteral("Device pixel ratios. (default: %1)").arg(DefaultRatios), "ratios", DefaultRatios },
+    { "page-size", QStringLiteral("Page size in pixels. (default: %1)").arg(DefaultPageSize), "size", QString::number(DefaultPageSize) },
+    { "id-prefix", QStringLiteral("Prefix of the image ids. (default: %1)").arg(DefaultIdPrefix), "prefix", DefaultIdPrefix }
+  });
+  parser.process(app);
+
+  const QString sourcesPath = parser.value("sources");
+  const QString outputPath = parser.value("output");
+  if (sourcesPath.isEmpty() || outputPath.isEmpty())
+    parser.showHelp(1);
+
+  bool sizesOk, ratiosOk, pageSizeOk;
+  const QList<qreal> sizes = parseNumbers(parser.value("sizes"), sizesOk);
+  const QList<qreal> ratios = parseNumbers(parser.value("ratios"), ratiosOk);
+  const int pageSize = parser.value("page-size").toInt(&pageSizeOk);
+  if (!sizesOk || !ratiosOk || !pageSizeOk || pageSize <= 0) {
+    qCritical() << "Invalid sizes, ratios or page size.";
+    return 1;
+  }
+
+  const QStringList names = readIconNames(sourcesPath, parser.value("icons"));
+  if (names.isEmpty()) {
+    qCritical() << QStringLiteral("No icons to pack from: `%1`.").arg(sourcesPath);
+    return 1;
+  }
+
+  // 1. Render. The requests are in device pixels: a size shared by two ratios is rendered once.
+  const QDir sources(sourcesPath);
+  const QString idPrefix = parser.value("id-prefix");
+  QSet<QString> keys;
+  QList<QVector<Icon>> groups;
+  int failureCount = 0;
+  for (qreal ratio : ratios) {
+    QVector<Icon> icons;
+    for (const QString &name : names)
+      for (qreal size : sizes) {
+        const int pixelSize = qRound(size * ratio);
+        const QSize requestedSize(pixelSize, pixelSize);
+        const QString key = IconRenderer::getImageKey(idPrefix + name, requestedSize, 0);
+        if (keys.contains(key))
+          continue;
+
+        const QImage image = IconRenderer::render(sources.filePath(name), requestedSize, 1);
+        if (image.isNull()) {
+          ++failureCount;
+          continue;
+        }
+        keys.insert(key);
+        icons.push_back({ key, image });
+      }
+    groups << icons;
+  }
+
+  // 2. Pack and save.
+  QVector<QImage> pages;
+  QHash<QString, IconAtlas::Entry> entries;
+  pack(groups, pageSize, pages, entries);
+
+  if (!IconAtlas::save(outputPath, IconRenderer::computeThemeHash(), pages, entries))
+    return 1;
+
+  QTextStream(stdout) << QStringLiteral("%1: %2 icons in %3 pages, %4 failures.\n")
+    .arg(outputPath).arg(entries.count()).arg(pages.count()).arg(failureCount);
+  // The icons which fail here fail at runtime too: not a build error.
+  return 0;
+}
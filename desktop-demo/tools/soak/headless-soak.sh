@@ -0,0 +1,68 @@
+#!/bin/sh
+#
+# Soak the app in headless mode and record its memory and CPU usage.
+#
+# Usage: headless-soak.sh <app binary> <sip address> [duration s] [call length s] [sample period s] [output csv]
+#
+# The app is started with `--headless` and driven with cli commands on its
+# standard input: it calls `sip address`, hangs up after `call length`, and
+# starts again until `duration` is elapsed. Every `sample period`, the resident
+# memory (kB) and the consumed CPU time (user + system, clock ticks) are
+# appended to `output csv`. Runs on Linux without display.
+
+set -e
+
+APP="$1"
+SIP_ADDRESS="$2"
+DURATION="${3:-3600}"
+CALL_LENGTH="${4:-30}"
+SAMPLE_PERIOD="${5:-5}"
+OUTPUT="${6:-soak.csv}"
+
+if [ -z "$APP" ] || [ -z "$SIP_ADDRESS" ]; then
+  sed -n '4,11p' "$0" | sed 's/^# \{0,1\}//'
+  exit 1
+fi
+
+FIFO="$(mktemp -u)"
+mkfifo "$FIFO"
+trap 'rm -f "$FIFO"' EXIT
+
+"$APP" --headless < "$FIFO" &
+PID=$!
+
+# Keep the fifo open until the end of the scenario.
+exec 3> "$FIFO"
+
+echo "time_s,rss_kb,cpu_ticks" > "$OUTPUT"
+sample () {
+  RSS=$(awk '/^VmRSS:/ { print $2 }' "/proc/$PID/status" 2> /dev/null || true)
+  TICKS=$(awk '{ print $14 + $15 }' "/proc/$PID/stat" 2> /dev/null || true)
+  echo "$1,$RSS,$TICKS" >> "$OUTPUT"
+}
+
+ELAPSED=0
+NEXT_CALL=0
+IN_CALL=0
+while [ "$ELAPSED" -lt "$DURATION" ] && kill -0 "$PID" 2> /dev/null; do
+  if [ "$ELAPSED" -ge "$NEXT_CALL" ]; then
+    if [ "$IN_CALL" -eq 0 ]; then
+      echo "call sip-address=$SIP_ADDRESS" >&3
+      IN_CALL=1
+    else
+      echo "bye" >&3
+      IN_CALL=0
+    fi
+    NEXT_CALL=$((ELAPSED + CALL_LENGTH))
+  fi
+
+  sample "$ELAPSED"
+  sleep "$SAMPLE_PERIOD"
+  ELAPSED=$((ELAPSED + SAMPLE_PERIOD))
+done
+
+# End of input: the app quits.
+echo "bye" >&3
+exec 3>&-
+wait "$PID" || true
+echo "Samples written to $OUTPUT."
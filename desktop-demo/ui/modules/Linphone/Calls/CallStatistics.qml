@@ -69,7 +69,7 @@ Popup {
           horizontalAlignment: Text.AlignRight
           verticalAlignment: Text.AlignVCenter
 
-          text: modelData.key
+          text: model.key
         }
 
         Text {
@@ -79,7 +79,7 @@ Popup {
           elide: Text.ElideRight
           font.pointSize: CallStatisticsStyle.value.pointSize
 
-          text: modelData.value
+          text: model.value
         }
       }
     }
@@ -0,0 +1,72 @@
+import QtQuick 2.7
+
+import Linphone.Styles 1.0
+
+// =============================================================================
+// Frame counters of a `Camera` item, polled while visible.
+// =============================================================================
+
+Rectangle {
+  id: overlay
+
+  property var camera
+
+  // ---------------------------------------------------------------------------
+
+  function _update () {
+    if (!camera) {
+      stats.text = ''
+      return
+    }
+
+    var frameStats = camera.getFrameStats()
+    var lines = []
+    if (frameStats.decodedFramerate >= 0) {
+      lines.push(qsTr('frameStatsDecoded').replace('%1', frameStats.decodedFramerate.toFixed(1)))
+    }
+    lines.push(
+      qsTr('frameStatsReceived').replace('%1', frameStats.received),
+      qsTr('frameStatsRendered').replace('%1', frameStats.rendered),
+      qsTr('frameStatsSkipped').replace('%1', frameStats.skipped)
+    )
+    if (frameStats.renderTime >= 0) {
+      lines.push(qsTr('frameStatsRender')
+        .replace('%1', frameStats.renderTime)
+        .replace('%2', frameStats.maxRenderTime))
+    }
+    stats.text = lines.join('\n')
+  }
+
+  // ---------------------------------------------------------------------------
+
+  anchors {
+    left: parent.left
+    top: parent.top
+    margins: VideoFrameStatsOverlayStyle.margins
+  }
+
+  color: VideoFrameStatsOverlayStyle.color
+  height: stats.implicitHeight + VideoFrameStatsOverlayStyle.padding * 2
+  width: stats.implicitWidth + VideoFrameStatsOverlayStyle.padding * 2
+
+  onVisibleChanged: visible && _update()
+
+  Text {
+    id: stats
+
+    anchors.centerIn: parent
+    color: VideoFrameStatsOverlayStyle.text.color
+    font {
+      family: 'monospace'
+      pointSize: VideoFrameStatsOverlayStyle.text.pointSize
+    }
+  }
+
+  Timer {
+    interval: VideoFrameStatsOverlayStyle.refreshInterval
+    repeat: true
+    running: overlay.visible
+
+    onTriggered: overlay._update()
+  }
+}
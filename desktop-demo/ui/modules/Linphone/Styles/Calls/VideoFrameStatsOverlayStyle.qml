@@ -0,0 +1,19 @@
+pragma Singleton
+import QtQml 2.2
+
+import Colors 1.0
+import Units 1.0
+
+// =============================================================================
+
+QtObject {
+  property color color: Colors.l50
+  property int margins: 6
+  property int padding: 4
+  property int refreshInterval: 1000
+
+  property QtObject text: QtObject {
+    property color color: Colors.k
+    property int pointSize: Units.dp * 8
+  }
+}
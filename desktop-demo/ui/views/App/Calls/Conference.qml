@@ -174,12 +174,7 @@ Rectangle {
             }
             enabled:!$call.speakerMuted
 
-            Timer {
-              interval: 50
-              repeat: true
-              running: true
-              onTriggered: parent.value = $call.speakerVu
-            }
+            value: $call.speakerVu
           }
           MouseArea{
             anchors.fill:parent
@@ -211,13 +206,7 @@ Rectangle {
           spacing: CallStyle.actionArea.vu.spacing
 
           VuMeter {
-            Timer {
-              interval: 50
-              repeat: true
-              running: micro.enabled
-
-              onTriggered: parent.value = conference.conferenceModel.microVu
-            }
+            value: conference.conferenceModel.microVu
 
             enabled: micro.enabled
           }
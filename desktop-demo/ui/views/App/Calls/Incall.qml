@@ -242,6 +242,11 @@ Rectangle {
             call: incall.call
             height: container.height
             width: container.width
+
+            VideoFrameStatsOverlay {
+              camera: parent
+              visible: SettingsModel.videoFrameStatsOverlay
+            }
           }
         }
       }
@@ -292,13 +297,7 @@ Rectangle {
           visible: SettingsModel.muteMicrophoneEnabled
 
           VuMeter {
-            Timer {
-              interval: 50
-              repeat: true
-              running: micro.enabled
-
-              onTriggered: parent.value = incall.call.microVu
-            }
+            value: incall.call.microVu
 
             enabled: micro.enabled
           }
@@ -318,13 +317,7 @@ Rectangle {
           spacing: CallStyle.actionArea.vu.spacing
 
           VuMeter {
-            Timer {
-              interval: 50
-              repeat: true
-              running: speaker.enabled
-
-              onTriggered: parent.value = incall.call.speakerVu
-            }
+            value: incall.call.speakerVu
 
             enabled: speaker.enabled
           }
@@ -385,6 +378,11 @@ Rectangle {
             anchors.fill: parent
             call: incall.call
             isPreview: true
+
+            VideoFrameStatsOverlay {
+              camera: parent
+              visible: SettingsModel.videoFrameStatsOverlay
+            }
           }
         }
       }
@@ -82,6 +82,11 @@ Window {
 
         Camera {
           call: window.call
+
+          VideoFrameStatsOverlay {
+            camera: parent
+            visible: SettingsModel.videoFrameStatsOverlay
+          }
         }
       }
     }
@@ -311,13 +316,7 @@ Window {
             visible: SettingsModel.muteMicrophoneEnabled
 
             VuMeter {
-              Timer {
-                interval: 50
-                repeat: true
-                running: micro.enabled
-
-                onTriggered: parent.value = call.microVu
-              }
+              value: call ? call.microVu : 0
 
               enabled: micro.enabled
             }
@@ -337,13 +336,7 @@ Window {
             spacing: CallStyle.actionArea.vu.spacing
 
             VuMeter {
-              Timer {
-                interval: 50
-                repeat: true
-                running: speaker.enabled
-
-                onTriggered: parent.value = call.speakerVu
-              }
+              value: call ? call.speakerVu : 0
 
               enabled: speaker.enabled
             }
@@ -443,6 +436,12 @@ Window {
 
         height: Math.min(window.height, (CallStyle.actionArea.userVideo.height * window.height/CallStyle.actionArea.userVideo.heightReference) * scale)
         width: Math.min(window.width, (CallStyle.actionArea.userVideo.width * window.width/CallStyle.actionArea.userVideo.widthReference) * scale )
+
+        VideoFrameStatsOverlay {
+          camera: parent
+          visible: SettingsModel.videoFrameStatsOverlay
+        }
+
         DragBox {
           container: window
           draggable: parent
@@ -218,6 +218,19 @@ TabContainer {
                                     }
                                 }
                             }// Repeater : Fields
+                            FormTableEntry {
+                                Switch {
+                                    checked: modelData.deltaSync
+                                    onClicked: {
+                                        checked = !checked
+                                        importerLine.fields["deltaSync"] = (checked?1:0)
+                                        ContactsImporterListModel.addContactsImporter(importerLine.fields, importerLine.identity)
+                                    }
+                                    TooltipArea{
+                                        text: qsTr('contactsImporterDeltaSync')
+                                    }
+                                }
+                            }//FormTableEntry
                             FormTableEntry {
                                 Switch {
                                     checked: modelData.fields["enabled"]>0
@@ -176,6 +176,20 @@ TabContainer {
         }
       }
 
+      FormLine {
+        visible: SettingsModel.developerSettingsEnabled
+
+        FormGroup {
+          label: qsTr('showVideoFrameStatsLabel')
+
+          Switch {
+            checked: SettingsModel.videoFrameStatsOverlay
+
+            onClicked: SettingsModel.videoFrameStatsOverlay = !checked
+          }
+        }
+      }
+
       CodecsViewer {
         model: VideoCodecsModel
         width: parent.width
@@ -2,57 +2,64 @@
 #include <QOpenGLFramebufferObject>
 #include <QQuickWindow>
 #include <QThread>
-#include <QTimer>
 #include "linphone/linphonecoremanager.h"
+#include "VideoFrameClock.hpp"
 #include <linphone++/core.hh>
 
 // =============================================================================
 
 using namespace std;
 
-namespace {
-constexpr int MaxFps = 30;
-}
-
-
 // =============================================================================
 Camera::Camera (QQuickItem *parent) : QQuickFramebufferObject(parent) {
     // The fbo content must be y-mirrored because the ms rendering is y-inverted.
     setMirrorVertically(true);
 
-    mRefreshTimer = new QTimer(this);
-    mRefreshTimer->setInterval(1000 / MaxFps);
-
-    QObject::connect(
-                mRefreshTimer, &QTimer::timeout,
-                this, &QQuickFramebufferObject::update,
-                Qt::DirectConnection
-                );
+    CallCore *callCore = LinphoneCoreManager::getInstance()->getCallCore();
+    if (callCore)
+        QObject::connect(callCore, &CallCore::callChanged, this, &Camera::updateFrameSource);
+    updateFrameSource();
+}
 
-    mRefreshTimer->start();
+Camera::~Camera () {
+    LinphoneCoreManager::getInstance()->getVideoFrameClock()->removeItem(this);
 }
 
+// Called on the render thread. The window id is bound through the core, so it
+// must not run during an iteration. The frames are then rendered without the
+// core lock.
 QQuickFramebufferObject::Renderer *Camera::createRenderer () const {
+    LinphoneCoreManager *coreManager = LinphoneCoreManager::getInstance();
     QQuickFramebufferObject::Renderer * renderer = NULL;
+    coreManager->lockVideoRender();
     if(mIsPreview){
-        LinphoneCoreManager::getInstance()->getCore()->setNativePreviewWindowId(NULL);// Reset
-        renderer=(QQuickFramebufferObject::Renderer *)LinphoneCoreManager::getInstance()->getCore()->getNativePreviewWindowId();
+        coreManager->getCore()->setNativePreviewWindowId(NULL);// Reset
+        renderer=(QQuickFramebufferObject::Renderer *)coreManager->getCore()->getNativePreviewWindowId();
     }else{
-        auto call = LinphoneCoreManager::getInstance()->getCallCore()->getCall();
+        auto call = coreManager->getCallCore()->getCall();
         if(call){
             call->setNativeVideoWindowId(NULL);
             renderer=(QQuickFramebufferObject::Renderer *) call->getNativeVideoWindowId();
         }else{
-            LinphoneCoreManager::getInstance()->getCore()->setNativeVideoWindowId(NULL);
-            renderer=(QQuickFramebufferObject::Renderer *)LinphoneCoreManager::getInstance()->getCore()->getNativePreviewWindowId();
+            coreManager->getCore()->setNativeVideoWindowId(NULL);
+            renderer=(QQuickFramebufferObject::Renderer *)coreManager->getCore()->getNativePreviewWindowId();
         }
     }
+    coreManager->unlockVideoRender();
     if(renderer)
         return renderer;
     else
         return new SafeFramebuffer();
 }
 
+// Redraw on the decoded frames of the call. The preview has no frame
+// notification, it is polled.
+void Camera::updateFrameSource () {
+    CallCore *callCore = LinphoneCoreManager::getInstance()->getCallCore();
+    shared_ptr<linphone::Call> call = !mIsPreview && callCore ? callCore->getCall() : nullptr;
+    LinphoneCoreManager::getInstance()->getVideoFrameClock()->setItemSource(this, call);
+}
+
 bool Camera::getIsPreview () const {
     return mIsPreview;
 }
@@ -60,7 +67,7 @@ bool Camera::getIsPreview () const {
 void Camera::setIsPreview (bool status) {
     if (mIsPreview != status) {
         mIsPreview = status;
-        update();
+        updateFrameSource();
 
         emit isPreviewChanged(status);
     }
@@ -23,6 +23,7 @@ class Camera : public QQuickFramebufferObject {
   Q_PROPERTY(bool isPreview READ getIsPreview WRITE setIsPreview NOTIFY isPreviewChanged)
 public:
   Camera (QQuickItem *parent = Q_NULLPTR);
+  ~Camera ();
 
   QQuickFramebufferObject::Renderer *createRenderer () const override;
 
@@ -30,12 +31,12 @@ signals:
   void isPreviewChanged (bool isPreview);
 
 private:
+  void updateFrameSource ();
 
   bool getIsPreview () const;
   void setIsPreview (bool status);
 
   bool mIsPreview = false;
-  QTimer *mRefreshTimer = nullptr;
 };
 
 class SafeFramebuffer : public QQuickFramebufferObject::Renderer{
@@ -2,6 +2,7 @@
 #include "utils.h"
 #include <QCoreApplication>
 #include <QDebug>
+#include <QEvent>
 #include <QLibrary>
 #include <QQmlEngine>
 #include "camera.h"
@@ -28,10 +29,18 @@ LinphoneCoreManager::LinphoneCoreManager(QObject *parent, const QString &configP
     qmlRegisterType<Camera>("an.qt.im", 1, 0, "Camera");
 
     mCore = nullptr;
+    mVideoFrameClock = new VideoFrameClock(this);
     CoreHandlers *coreHandlers = mHandlers.get();
     QObject::connect(coreHandlers, &CoreHandlers::coreStarting, this, &LinphoneCoreManager::startIterate, Qt::QueuedConnection);
     QObject::connect(coreHandlers, &CoreHandlers::coreStarted, this, &LinphoneCoreManager::initCoreManager, Qt::QueuedConnection);
     QObject::connect(coreHandlers, &CoreHandlers::coreStopped, this, &LinphoneCoreManager::stopIterate, Qt::QueuedConnection);
+
+    // Core events and user input make the core iterate fast again.
+    QObject::connect(coreHandlers, &CoreHandlers::callStateChanged, this, &LinphoneCoreManager::notifyCoreActivity);
+    QObject::connect(coreHandlers, &CoreHandlers::registrationStateChanged, this, &LinphoneCoreManager::notifyCoreActivity);
+    QObject::connect(coreHandlers, &CoreHandlers::isComposingChanged, this, &LinphoneCoreManager::notifyCoreActivity);
+    QObject::connect(coreHandlers, &CoreHandlers::messageReceived, this, &LinphoneCoreManager::notifyCoreActivity);
+    QCoreApplication::instance()->installEventFilter(this);
     QTimer::singleShot(100, [this, configPath](){// Delay the creation in order to have the CoreManager instance set before
         createLinphoneCore(configPath);
     });
@@ -56,7 +65,7 @@ void LinphoneCoreManager::initCoreManager()
 void LinphoneCoreManager::startIterate()
 {
     mCbsTimer = new QTimer(this);
-    mCbsTimer->setInterval(20);
+    mCbsTimer->setInterval(mIterationScheduler.getFastInterval());
     QObject::connect(mCbsTimer, &QTimer::timeout, this, &LinphoneCoreManager::iterate);
     qInfo() << QStringLiteral("Start iterate");
     mCbsTimer->start();
@@ -64,7 +73,7 @@ void LinphoneCoreManager::startIterate()
 
 void LinphoneCoreManager::stopIterate()
 {
-    qInfo() << QStringLiteral("Stop iterate");
+    qInfo() << QStringLiteral("Stop iterate after %1 wakeups").arg(mIterationScheduler.getWakeupCount());
     mCbsTimer->stop();
     mCbsTimer->deleteLater();// allow the timer to continue its stuff
     mCbsTimer = nullptr;
@@ -72,11 +81,50 @@ void LinphoneCoreManager::stopIterate()
 
 void LinphoneCoreManager::iterate () {
     lockVideoRender();
-    if(mCore)
+    if(mCore) {
         mCore->iterate();
+        const int interval = mIterationScheduler.next(isCoreBusy());
+        if (mCbsTimer && interval != mCbsTimer->interval())
+            mCbsTimer->setInterval(interval);
+    }
     unlockVideoRender();
 }
 
+void LinphoneCoreManager::notifyCoreActivity ()
+{
+    mIterationScheduler.notifyActivity();
+    // Do not wait the end of a long idle interval.
+    if (mCbsTimer && mIterationScheduler.getInterval() != mIterationScheduler.getFastInterval())
+        mCbsTimer->start(mIterationScheduler.getFastInterval());
+}
+
+bool LinphoneCoreManager::isCoreBusy () const
+{
+    if (mCore->getCallsNb() > 0 || mCore->getGlobalState() != linphone::GlobalState::On)
+        return true;
+
+    for (const auto &proxyConfig : mCore->getProxyConfigList())
+        if (proxyConfig->getState() == linphone::RegistrationState::Progress)
+            return true;
+
+    return false;
+}
+
+bool LinphoneCoreManager::eventFilter (QObject *object, QEvent *event)
+{
+    switch (event->type()) {
+    case QEvent::KeyPress:
+    case QEvent::MouseButtonPress:
+    case QEvent::TouchBegin:
+    case QEvent::Wheel:
+        notifyCoreActivity();
+        break;
+    default:
+        break;
+    }
+    return QObject::eventFilter(object, event);
+}
+
 void LinphoneCoreManager::createLinphoneCore (const QString &configPath) {
   qInfo() << QStringLiteral("Launch async core creation.");
 
@@ -9,6 +9,8 @@
 #include "corehandlers.h"
 #include "accountsettings.h"
 #include "callcore.h"
+#include "CoreIterationScheduler.hpp"
+#include "VideoFrameClock.hpp"
 
 class LinphoneCoreManager : public QObject
 {
@@ -47,6 +49,11 @@ public:
       mMutexVideoRender.unlock();
     }
 
+    // Schedules the redraws of the cameras.
+    inline VideoFrameClock *getVideoFrameClock () const {
+      return mVideoFrameClock;
+    }
+
     // ---------------------------------------------------------------------------
     // Initialization.
     // ---------------------------------------------------------------------------
@@ -54,6 +61,21 @@ public:
     static void init (QObject *parent, const QString &configPath);
     static void uninit ();
 
+    // ---------------------------------------------------------------------------
+    // Iteration scheduling.
+    // ---------------------------------------------------------------------------
+
+    // Iterate fast again, for example on user input or core events.
+    void notifyCoreActivity ();
+
+    inline int getIterateInterval () const {
+        return mIterationScheduler.getInterval();
+    }
+
+    inline quint64 getIterateWakeupCount () const {
+        return mIterationScheduler.getWakeupCount();
+    }
+
 public slots:
     void initCoreManager();
     void startIterate();
@@ -66,6 +88,8 @@ signals:
 
 private:
   LinphoneCoreManager (QObject *parent, const QString &configPath);
+  bool eventFilter (QObject *object, QEvent *event) override;
+  bool isCoreBusy () const;
   void iterate ();
 private:
     std::shared_ptr<linphone::Core> mCore;
@@ -73,11 +97,13 @@ private:
 
 
     QTimer *mCbsTimer = nullptr;
+    CoreIterationScheduler mIterationScheduler{20, 100, 2000}; // No socket wakeup: keep the idle interval short.
 
     AccountSettings *accountSettings{nullptr};
     CallCore *callcore{nullptr};
 
     QMutex mMutexVideoRender;
+    VideoFrameClock *mVideoFrameClock = nullptr;
 
     static LinphoneCoreManager *mInstance;
 };
@@ -19,10 +19,16 @@ SOURCES += main.cpp \
     linphone/utils.cpp \
     linphone/callcore.cpp \
     linphone/accountsettings.cpp \
-    linphone/camera.cpp
+    linphone/camera.cpp \
+    ../desktop-demo/src/components/camera/VideoFrameClock.cpp \
+    ../desktop-demo/src/components/core/CoreIterationScheduler.cpp
 
 RESOURCES += qml.qrc
 
+# Shared with the desktop demo.
+INCLUDEPATH += $$PWD/../desktop-demo/src/components/camera \
+               $$PWD/../desktop-demo/src/components/core
+
 # Additional import path used to resolve QML modules in Qt Creator's code model
 QML_IMPORT_PATH =
 
@@ -99,4 +105,6 @@ HEADERS += \
     linphone/callcore.h \
     linphone/accountsettings.h \
     linphone/camera.h \
+    ../desktop-demo/src/components/camera/VideoFrameClock.hpp \
+    ../desktop-demo/src/components/core/CoreIterationScheduler.hpp \
 	config.h
@@ -0,0 +1,46 @@
+QT += testlib quick widgets
+DESTDIR = ../Debug
+
+
+CONFIG += qt console warn_on depend_includepath testcase c++11
+CONFIG -= app_bundle
+
+TEMPLATE = app
+
+SOURCES +=  tst_contactsimportertest.cpp \
+            vcardmodelstubs.cpp \
+            contactsimporterstubs.cpp \
+            ../desktop-demo/src/components/contact/ContactModel.cpp \
+            ../desktop-demo/src/components/contact/VcardModel.cpp \
+            ../desktop-demo/src/components/contacts/ContactsImporterModel.cpp \
+            ../desktop-demo/src/components/contacts/ContactsImporterWorker.cpp \
+            ../desktop-demo/src/components/contacts/ContactsListModel.cpp \
+            ../desktop-demo/src/components/presence/Presence.cpp \
+            ../desktop-demo/src/utils/plugins/PluginDataAPI.cpp
+
+HEADERS +=  ../desktop-demo/include/LinphoneApp/PluginDataAPI.hpp \
+            ../desktop-demo/src/components/contact/ContactModel.hpp \
+            ../desktop-demo/src/components/contact/VcardModel.hpp \
+            ../desktop-demo/src/components/contacts/ContactsImporterModel.hpp \
+            ../desktop-demo/src/components/contacts/ContactsImporterWorker.hpp \
+            ../desktop-demo/src/components/contacts/ContactsListModel.hpp \
+            ../desktop-demo/src/components/presence/Presence.hpp
+
+INCLUDEPATH +=  $$PWD/../desktop-demo \
+                $$PWD/../desktop-demo/src \
+                $$PWD/../sdk/linphone-sdk/desktop/include
+
+LIBS +=  -L$$PWD/../sdk/linphone-sdk/desktop/lib/ -lz \
+                                 -lxml2 \
+                                 -llinphone++ \
+                                 -llinphone \
+                                 -lbctoolbox \
+                                 -lbelcard \
+                                 -lortp \
+                                 -lmediastreamer \
+                                 -lbelr \
+                                 -lsqlite3 \
+                                 -lbellesip \
+                                 -lmbedcrypto \
+                                 -lmbedtls \
+                                 -lmbedx509
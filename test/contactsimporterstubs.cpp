@@ -0,0 +1,29 @@
+﻿#include <QDir>
+
+#include <linphone++/linphone.hh>
+
+#include "app/paths/Paths.hpp"
+#include "components/core/CoreManager.hpp"
+#include "utils/plugins/PluginsManager.hpp"
+
+// Stand-ins for the application symbols used by the contacts importer. The tests give their
+// contacts list model to ContactsImporterModel: the core manager is never used.
+
+QString PluginsManager::gPluginsConfigSection = "plugins";
+
+std::string Paths::getContactsImportDirPath()
+{
+	return QDir::tempPath().toStdString() + "/";
+}
+
+CoreManager *CoreManager::getInstance()
+{
+	qFatal("The core manager is not available in the tests.");
+	return nullptr;
+}
+
+ContactsListModel *CoreManager::getContactsListModel() const
+{
+	qFatal("The core manager is not available in the tests.");
+	return nullptr;
+}
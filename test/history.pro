@@ -0,0 +1,34 @@
+QT += testlib
+DESTDIR = ../Debug
+
+
+CONFIG += qt console warn_on depend_includepath testcase c++11
+CONFIG -= app_bundle
+
+TEMPLATE = app
+
+SOURCES +=  tst_historytest.cpp \
+            historystubs.cpp \
+            ../desktop-demo/src/components/history/HistoryModel.cpp \
+            ../desktop-demo/src/components/history/HistoryStatsModel.cpp
+
+HEADERS +=  ../desktop-demo/src/components/history/HistoryModel.hpp \
+            ../desktop-demo/src/components/history/HistoryStatsModel.hpp
+
+INCLUDEPATH +=  $$PWD/../desktop-demo/src \
+                $$PWD/../sdk/linphone-sdk/desktop/include
+
+LIBS +=  -L$$PWD/../sdk/linphone-sdk/desktop/lib/ -lz \
+                                 -lxml2 \
+                                 -llinphone++ \
+                                 -llinphone \
+                                 -lbctoolbox \
+                                 -lbelcard \
+                                 -lortp \
+                                 -lmediastreamer \
+                                 -lbelr \
+                                 -lsqlite3 \
+                                 -lbellesip \
+                                 -lmbedcrypto \
+                                 -lmbedtls \
+                                 -lmbedx509
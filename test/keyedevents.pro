@@ -0,0 +1,20 @@
+QT += testlib
+QT -= gui
+DESTDIR = ../Debug
+
+
+CONFIG += qt console warn_on depend_includepath testcase c++11
+CONFIG -= app_bundle
+
+TEMPLATE = app
+
+SOURCES +=  tst_keyedeventstest.cpp
+
+HEADERS +=  ../desktop-demo/src/components/core/KeyedEvents.hpp
+
+INCLUDEPATH +=  $$PWD/../desktop-demo/src \
+                $$PWD/../sdk/linphone-sdk/desktop/include
+
+LIBS +=  -L$$PWD/../sdk/linphone-sdk/desktop/lib/ -llinphone++ \
+                                 -llinphone \
+                                 -lbctoolbox
@@ -0,0 +1,16 @@
+QT += testlib
+QT -= gui
+DESTDIR = ../Debug
+
+
+CONFIG += qt console warn_on depend_includepath testcase c++11
+CONFIG -= app_bundle
+
+TEMPLATE = app
+
+SOURCES +=  tst_profilertest.cpp \
+            ../desktop-demo/src/components/core/CoreHandlersProfiler.cpp
+
+HEADERS +=  ../desktop-demo/src/components/core/CoreHandlersProfiler.hpp
+
+INCLUDEPATH +=  $$PWD/../desktop-demo/src
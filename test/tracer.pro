@@ -0,0 +1,14 @@
+QT += testlib
+QT -= gui
+DESTDIR = ../Debug
+
+
+CONFIG += qt console warn_on depend_includepath testcase c++11
+CONFIG -= app_bundle
+
+TEMPLATE = app
+
+SOURCES +=  tst_tracertest.cpp \
+            ../desktop-demo/src/app/tracer/Tracer.cpp
+
+INCLUDEPATH +=  $$PWD/../desktop-demo/src
@@ -0,0 +1,117 @@
+﻿#include <QtTest>
+#include <QTemporaryDir>
+
+#include "components/call/CallQualityFile.hpp"
+
+// Check the files of the call quality recorder and measure the cost of one record,
+// written once per second and per call.
+
+class CallQualityTest : public QObject
+{
+	Q_OBJECT
+	
+private slots:
+	void test_records();
+	void test_quota();
+	void bench_record();
+	
+private:
+	static void fillRecord(CallQuality::Record *record, quint32 time);
+};
+
+void CallQualityTest::fillRecord(CallQuality::Record *record, quint32 time)
+{
+	// Same fields as `CallQualityRecorder::handleTimeout`.
+	record->time = time;
+	record->flags = CallQuality::HasAudio | CallQuality::HasVideo;
+	record->audioUploadBandwidth = 32;
+	record->audioDownloadBandwidth = 31;
+	record->audioSenderLossRate = 0.5f;
+	record->audioReceiverLossRate = 0.25f;
+	record->audioRoundTripDelay = 0.08f;
+	record->audioJitterBuffer = 60;
+	record->videoUploadBandwidth = 1200;
+	record->videoDownloadBandwidth = 1100;
+	record->videoSenderLossRate = 1;
+	record->videoReceiverLossRate = 2;
+	record->videoRoundTripDelay = 0.08f;
+	record->videoReceivedFramerate = 30;
+	record->videoSentFramerate = 29;
+}
+
+void CallQualityTest::test_records()
+{
+	QTemporaryDir dir;
+	QVERIFY(dir.isValid());
+	const QString filePath = dir.filePath("call.cqr");
+	
+	CallQualityFile file;
+	QVERIFY(file.open(filePath, "sip:bob@example.org", 1000, 1000, 3));
+	QVERIFY(CallQualityFile::isWriting(filePath));
+	for (quint32 i = 0; i < 3; ++i) {
+		CallQuality::Record *record = file.beginRecord();
+		QVERIFY(record);
+		fillRecord(record, i * 1000);
+		file.commitRecord();
+	}
+	QVERIFY(!file.beginRecord());// Full.
+	file.close();
+	QVERIFY(!CallQualityFile::isWriting(filePath));
+	
+	// Truncated to the committed records.
+	QFile result(filePath);
+	QVERIFY(result.open(QIODevice::ReadOnly));
+	QCOMPARE(result.size(), qint64(sizeof(CallQuality::FileHeader) + 3 * sizeof(CallQuality::Record)));
+	CallQuality::FileHeader header;
+	QCOMPARE(result.read(reinterpret_cast<char *>(&header), sizeof header), qint64(sizeof header));
+	QCOMPARE(header.magic, CallQuality::Magic);
+	QCOMPARE(header.recordCount, quint32(3));
+	QCOMPARE(QString(header.peerAddress), QString("sip:bob@example.org"));
+}
+
+void CallQualityTest::test_quota()
+{
+	QTemporaryDir dir;
+	QVERIFY(dir.isValid());
+	const qint64 fileSize = CallQualityFile::getMaxFileSize(10);
+	
+	// The oldest file is still written by another call: the next one is removed instead.
+	CallQualityFile writing;
+	QVERIFY(writing.open(dir.filePath("1.cqr"), "sip:alice@example.org", 0, 1000, 10));
+	for (const char *name : { "2.cqr", "3.cqr" }) {
+		QTest::qWait(1100);// Distinct modification times.
+		QFile file(dir.filePath(name));
+		QVERIFY(file.open(QIODevice::WriteOnly));
+		QVERIFY(file.resize(fileSize));
+	}
+	
+	CallQualityFile::applyQuota(dir.path(), 3 * fileSize, fileSize);
+	QVERIFY(QFile::exists(dir.filePath("1.cqr")));
+	QVERIFY(!QFile::exists(dir.filePath("2.cqr")));
+	QVERIFY(QFile::exists(dir.filePath("3.cqr")));
+}
+
+void CallQualityTest::bench_record()
+{
+	QTemporaryDir dir;
+	QVERIFY(dir.isValid());
+	const int maxRecordCount = 4 * 60 * 60;// `CallQualityRecorder::MaxRecordCount`.
+	
+	CallQualityFile file;
+	int fileCount = 0;
+	quint32 time = 0;
+	QBENCHMARK {
+		CallQuality::Record *record = file.beginRecord();
+		if (!record) {// Full, like after 4 hours: the next call opens another file.
+			QVERIFY(file.open(dir.filePath(QStringLiteral("%1.cqr").arg(++fileCount)), "sip:bob@example.org", 0, 1000, maxRecordCount));
+			record = file.beginRecord();
+		}
+		fillRecord(record, time += 1000);
+		file.commitRecord();
+	}
+	file.close();
+}
+
+QTEST_GUILESS_MAIN(CallQualityTest)
+
+#include "tst_callqualitytest.moc"
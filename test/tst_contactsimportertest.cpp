@@ -0,0 +1,367 @@
+﻿#include <QtTest>
+#include <QElapsedTimer>
+#include <QPluginLoader>
+#include <QTemporaryDir>
+#include <QThread>
+
+#include <linphone++/linphone.hh>
+
+#include "components/contact/ContactModel.hpp"
+#include "components/contact/VcardModel.hpp"
+#include "components/contacts/ContactsImporterModel.hpp"
+#include "components/contacts/ContactsImporterWorker.hpp"
+#include "components/contacts/ContactsListModel.hpp"
+
+// Import the contacts of a stand-in plugin through the worker, then through ContactsImporterModel
+// into a contacts list.
+
+using namespace std;
+
+typedef QVector<QMultiMap<QString, QString> > Contacts;
+
+// What an address book plugin gives in `PluginDataAPI::dataReceived`. One contact in a thousand
+// has no domain and must be skipped.
+static Contacts generateContacts(int count, const QString &namePrefix = "Contact")
+{
+	Contacts contacts;
+	contacts.reserve(count);
+	for (int i = 0; i < count; ++i) {
+		QMultiMap<QString, QString> contact;
+		contact.insert("displayName", QStringLiteral("%1 %2").arg(namePrefix).arg(i));
+		contact.insert("sipUsername", QStringLiteral(" user%1 ").arg(i));
+		if (i % 1000 != 999)
+			contact.insert("sipDomain", "example.org");
+		contact.insert("email", QStringLiteral("user%1@mail.example.org").arg(i));
+		contacts << contact;
+	}
+	return contacts;
+}
+
+// A plugin which gives its contacts as soon as it runs.
+class StubPlugin : public LinphonePlugin
+{
+public:
+	QString getGUIDescriptionToJson() const override
+	{
+		return "{}";
+	}
+	
+	PluginDataAPI *createInstance(void *, QPluginLoader *) override
+	{
+		return nullptr;
+	}
+};
+
+class StubDataAPI : public PluginDataAPI
+{
+public:
+	StubDataAPI(LinphonePlugin *plugin, QPluginLoader *loader) : PluginDataAPI(plugin, nullptr, loader) {}
+	
+	bool isValid(const bool &, QString *) override
+	{
+		return false;// Never saved: there is no core.
+	}
+	
+	void run(const PluginCapability &actionType) override
+	{
+		emit dataReceived(actionType, mContacts);
+	}
+	
+	Contacts mContacts;
+};
+
+struct ImportResult
+{
+	int addedCount = 0;
+	int updatedCount = 0;
+	QHash<QString, QByteArray> removed;// Sip address => fingerprint.
+	int batchCount = 0;
+	int processedCount = 0;
+	bool canceled = false;
+	qint64 maxBatchTime = 0;// In ms, spent by the receiver.
+};
+
+class ContactsImporterTest : public QObject
+{
+	Q_OBJECT
+	
+private slots:
+	void initTestCase();
+	void cleanupTestCase();
+	
+	void test_import();
+	void test_cancel();
+	void test_sync();
+	void test_update_kept();
+	void bench_resync();
+	void test_model_import();
+	void test_model_cancel();
+	
+private:
+	// Run the worker in its thread and apply the batches in this thread, as ContactsImporterModel
+	// does but without contacts list.
+	static ImportResult import(const Contacts &contacts, const QString &syncStateFilePath = QString(), int cancelAfter = -1);
+	
+	shared_ptr<linphone::Core> mCore;
+};
+
+void ContactsImporterTest::initTestCase()
+{
+	mCore = linphone::Factory::get()->createCore("", "", nullptr);
+	QVERIFY(mCore);
+}
+
+void ContactsImporterTest::cleanupTestCase()
+{
+	mCore = nullptr;
+}
+
+ImportResult ContactsImporterTest::import(const Contacts &contacts, const QString &syncStateFilePath, int cancelAfter)
+{
+	ImportResult result;
+	QThread thread;
+	ContactsImporterWorker *worker = new ContactsImporterWorker(contacts);
+	if (!syncStateFilePath.isEmpty())
+		worker->setSyncStateFilePath(syncStateFilePath);
+	worker->moveToThread(&thread);
+	
+	QEventLoop loop;
+	QObject receiver;
+	QObject::connect(&thread, &QThread::started, worker, &ContactsImporterWorker::run);
+	QObject::connect(&thread, &QThread::finished, worker, &QObject::deleteLater);
+	QObject::connect(worker, &ContactsImporterWorker::batchReady, &receiver, [&](
+		QVector<ImportedContact> added,
+		QVector<ImportedContact> updated,
+		QVector<ImportedContact> removed,
+		int processedCount,
+		int
+	) {
+		if (worker->isCanceled())// Like the receivers of the application.
+			return;
+		QElapsedTimer timer;
+		timer.start();
+		QVERIFY(added.size() + updated.size() <= ContactsImporterWorker::BatchSize);
+		
+		// The vcards are created here, in the thread of the receiver.
+		ContactsImporterWorker::ImportedVcards vcards;
+		for (const ImportedContact &contact : added + updated) {
+			QScopedPointer<VcardModel> card(ContactsImporterWorker::createVcardModel(contact.fields));
+			if (card)
+				vcards.insert(contact.syncKey, ContactsImporterWorker::getImportedVcard(card.data()));
+		}
+		for (const ImportedContact &contact : removed)
+			result.removed.insert(contact.previousVcard.first, contact.previousVcard.second);
+		result.addedCount += added.size();
+		result.updatedCount += updated.size();
+		result.processedCount = processedCount;
+		if (++result.batchCount == cancelAfter)
+			worker->cancel();
+		worker->batchApplied(vcards);
+		result.maxBatchTime = qMax(result.maxBatchTime, timer.elapsed());
+	});
+	QObject::connect(worker, &ContactsImporterWorker::finished, &receiver, [&](bool canceled) {
+		result.canceled = canceled;
+		loop.quit();
+	});
+	
+	thread.start(QThread::LowPriority);
+	loop.exec();
+	thread.quit();
+	thread.wait();
+	return result;
+}
+
+void ContactsImporterTest::test_import()
+{
+	const int count = 100000;
+	const Contacts contacts = generateContacts(count);
+	
+	QElapsedTimer timer;
+	timer.start();
+	const ImportResult result = import(contacts);
+	qInfo() << QStringLiteral("Imported %1 contacts in %2 batches in %3 ms, at most %4 ms per batch in the receiver.")
+		.arg(result.addedCount).arg(result.batchCount).arg(timer.elapsed()).arg(result.maxBatchTime);
+	
+	QVERIFY(!result.canceled);
+	QCOMPARE(result.addedCount, count - count / 1000);
+	QCOMPARE(result.processedCount, count);
+	QCOMPARE(result.batchCount, (result.addedCount + ContactsImporterWorker::BatchSize - 1) / ContactsImporterWorker::BatchSize);
+}
+
+void ContactsImporterTest::test_cancel()
+{
+	const ImportResult result = import(generateContacts(100000), QString(), 3);
+	QVERIFY(result.canceled);
+	QCOMPARE(result.batchCount, 3);// The batches ready after the cancel are dropped.
+	QCOMPARE(result.addedCount, 3 * ContactsImporterWorker::BatchSize);
+}
+
+void ContactsImporterTest::test_sync()
+{
+	QTemporaryDir dir;
+	QVERIFY(dir.isValid());
+	const QString syncStateFilePath = dir.filePath("contacts.sync");
+	const int count = 10000;
+	
+	const ImportResult first = import(generateContacts(count), syncStateFilePath);
+	QCOMPARE(first.addedCount, count - count / 1000);
+	QVERIFY(QFile::exists(syncStateFilePath));
+	
+	// 1% churn: renamed contacts, and the last contacts are not in the source anymore.
+	Contacts contacts = generateContacts(count);
+	for (int i = 0; i < count / 100; ++i)
+		contacts[i].replace("displayName", QStringLiteral("Renamed %1").arg(i));
+	contacts.remove(count - 10, 10);
+	
+	const ImportResult second = import(contacts, syncStateFilePath);
+	QCOMPARE(second.addedCount, 0);
+	QCOMPARE(second.updatedCount, count / 100);
+	QCOMPARE(second.removed.size(), 9);// `user9999` has no domain.
+	QVERIFY(second.removed.contains("sip:user9990@example.org"));
+	
+	// The fingerprint of a removed contact is the one of its imported vcard.
+	QMultiMap<QString, QString> contact;
+	contact.insert("displayName", "Contact 9990");
+	contact.insert("sipUsername", "user9990");
+	contact.insert("sipDomain", "example.org");
+	contact.insert("email", "user9990@mail.example.org");
+	QScopedPointer<VcardModel> card(ContactsImporterWorker::createVcardModel(contact));
+	QVERIFY(card);
+	QCOMPARE(second.removed.value("sip:user9990@example.org"), ContactsImporterWorker::getFingerprint(card.data()));
+	card->setUsername("Edited by the user");
+	QVERIFY(second.removed.value("sip:user9990@example.org") != ContactsImporterWorker::getFingerprint(card.data()));
+}
+
+void ContactsImporterTest::test_update_kept()
+{
+	ContactsListModel contacts(mCore->createFriendList());
+	const Contacts source = generateContacts(2);
+	QVector<ImportedContact> added;
+	for (int i = 0; i < source.size(); ++i)
+		added << ImportedContact{ QString::number(i), source[i], ContactsImporterWorker::ImportedVcard() };
+	const ContactsImporterWorker::ImportedVcards vcards = ContactsImporterWorker::addContacts(&contacts, added);
+	QCOMPARE(contacts.rowCount(), 2);
+	
+	// The first contact is edited by the user.
+	ContactModel *edited = contacts.findContactModelFromSipAddress(vcards.value("0").first);
+	QVERIFY(edited);
+	VcardModel *card = edited->cloneVcardModel();
+	card->setUsername("Edited by the user");
+	edited->setVcardModel(card);
+	
+	// Both are renamed in the source.
+	QVector<ImportedContact> updated;
+	for (int i = 0; i < source.size(); ++i) {
+		QMultiMap<QString, QString> fields = source[i];
+		fields.replace("displayName", QStringLiteral("Renamed %1").arg(i));
+		updated << ImportedContact{ QString::number(i), fields, vcards.value(QString::number(i)) };
+	}
+	const ContactsImporterWorker::ImportedVcards updatedVcards = ContactsImporterWorker::updateContacts(&contacts, updated);
+	QCOMPARE(contacts.rowCount(), 2);
+	
+	// The edited contact is kept, with its vcard of the previous import in the sync state.
+	QCOMPARE(edited->getVcardModel()->getUsername(), QString("Edited by the user"));
+	QCOMPARE(updatedVcards.value("0"), vcards.value("0"));
+	
+	ContactModel *renamed = contacts.findContactModelFromSipAddress(vcards.value("1").first);
+	QVERIFY(renamed);
+	QCOMPARE(renamed->getVcardModel()->getUsername(), QString("Renamed 1"));
+	QCOMPARE(updatedVcards.value("1"), ContactsImporterWorker::getImportedVcard(renamed->getVcardModel()));
+}
+
+// Re-import of 50k contacts with 1% churn. Each added, updated or removed contact is a write in the
+// friends database: without sync state, all of them are written again.
+void ContactsImporterTest::bench_resync()
+{
+	QTemporaryDir dir;
+	QVERIFY(dir.isValid());
+	const QString syncStateFilePath = dir.filePath("contacts.sync");
+	const QString firstStateFilePath = dir.filePath("first.sync");
+	const int count = 50000;
+	
+	const ImportResult first = import(generateContacts(count), syncStateFilePath);
+	QVERIFY(QFile::copy(syncStateFilePath, firstStateFilePath));
+	
+	Contacts contacts = generateContacts(count);
+	for (int i = 0; i < count / 200; ++i)
+		contacts[i * 2].replace("displayName", QStringLiteral("Renamed %1").arg(i));
+	contacts.remove(count - count / 200, count / 200);
+	
+	ImportResult second;
+	QBENCHMARK {
+		QFile::remove(syncStateFilePath);
+		QFile::copy(firstStateFilePath, syncStateFilePath);
+		second = import(contacts, syncStateFilePath);
+	}
+	
+	const int writeCount = second.addedCount + second.updatedCount + second.removed.size();
+	qInfo() << QStringLiteral("Re-import: %1 contact writes instead of %2, sync state file of %3 bytes written once.")
+		.arg(writeCount).arg(first.addedCount).arg(QFileInfo(syncStateFilePath).size());
+	QCOMPARE(second.addedCount, 0);
+	QCOMPARE(second.updatedCount, count / 200);
+	QVERIFY(writeCount <= count / 100);
+}
+
+void ContactsImporterTest::test_model_import()
+{
+	const int count = 2000;
+	ContactsListModel contacts(mCore->createFriendList());
+	QSignalSpy insertSpy(&contacts, &QAbstractItemModel::rowsInserted);
+	
+	StubPlugin plugin;
+	QPluginLoader loader;
+	StubDataAPI *data = new StubDataAPI(&plugin, &loader);
+	data->mContacts = generateContacts(count);
+	ContactsImporterModel model(data);
+	model.setContactsListModel(&contacts);
+	QSignalSpy importingSpy(&model, &ContactsImporterModel::importingChanged);
+	
+	data->run(PluginDataAPI::CONTACTS);
+	QVERIFY(model.isImporting());
+	while (model.isImporting())
+		QVERIFY(importingSpy.wait(30000));
+	
+	const int addedCount = count - count / 1000;
+	QCOMPARE(contacts.rowCount(), addedCount);
+	QCOMPARE(model.getImportedCount(), count);
+	// `addContacts` inserts each batch with one `beginInsertRows`.
+	QCOMPARE(insertSpy.count(), (addedCount + ContactsImporterWorker::BatchSize - 1) / ContactsImporterWorker::BatchSize);
+	// The contacts and their vcards belong to the GUI thread.
+	for (int row = 0; row < contacts.rowCount(); ++row) {
+		const ContactModel *contact = contacts.data(contacts.index(row)).value<ContactModel *>();
+		QCOMPARE(contact->thread(), QThread::currentThread());
+		QCOMPARE(contact->getVcardModel()->thread(), QThread::currentThread());
+	}
+	delete data;
+}
+
+void ContactsImporterTest::test_model_cancel()
+{
+	ContactsListModel contacts(mCore->createFriendList());
+	
+	StubPlugin plugin;
+	QPluginLoader loader;
+	StubDataAPI *data = new StubDataAPI(&plugin, &loader);
+	data->mContacts = generateContacts(100000);
+	ContactsImporterModel model(data);
+	model.setContactsListModel(&contacts);
+	QSignalSpy importingSpy(&model, &ContactsImporterModel::importingChanged);
+	
+	// Cancel as soon as the first batch is applied.
+	QObject::connect(&model, &ContactsImporterModel::importProgressChanged, &model, [&model](int importedCount) {
+		if (importedCount > 0)
+			model.cancelImport();
+	});
+	
+	data->run(PluginDataAPI::CONTACTS);
+	while (model.isImporting())
+		QVERIFY(importingSpy.wait(30000));
+	
+	QCOMPARE(contacts.rowCount(), ContactsImporterWorker::BatchSize);
+	QVERIFY(model.getImportedCount() < model.getImportTotalCount());
+	delete data;
+}
+
+QTEST_GUILESS_MAIN(ContactsImporterTest)
+
+#include "tst_contactsimportertest.moc"
@@ -0,0 +1,189 @@
+﻿#include <QtTest>
+#include <QTemporaryDir>
+
+#include <linphone++/linphone.hh>
+
+#include "components/history/HistoryModel.hpp"
+#include "components/history/HistoryStatsModel.hpp"
+
+// Check the call history models against the call logs of a core, and measure them on a large
+// history.
+
+using namespace std;
+
+class HistoryTest : public QObject
+{
+	Q_OBJECT
+	
+private slots:
+	void test_model_build();
+	void bench_model_build();
+	void test_stats_remove();
+	void bench_stats_remove();
+	void bench_stats_rebuild();
+	
+private:
+	// Without database path, the call logs are only kept in memory.
+	static shared_ptr<linphone::Core> createCore(const QString &callLogsDatabasePath = QString());
+	// `count` call logs with `peerCount` peers on two local addresses, one minute apart.
+	static void createCallLogs(const shared_ptr<linphone::Core> &core, int count, int peerCount);
+	static void compareStats(const HistoryStatsModel &model, const HistoryStatsModel &expected);
+};
+
+shared_ptr<linphone::Core> HistoryTest::createCore(const QString &callLogsDatabasePath)
+{
+	shared_ptr<linphone::Core> core = linphone::Factory::get()->createCore("", "", nullptr);
+	if (core && !callLogsDatabasePath.isEmpty())
+		core->setCallLogsDatabasePath(callLogsDatabasePath.toStdString());
+	return core;
+}
+
+void HistoryTest::createCallLogs(const shared_ptr<linphone::Core> &core, int count, int peerCount)
+{
+	static const linphone::Call::Status Statuses[] = {
+		linphone::Call::Status::Success,
+		linphone::Call::Status::Missed,
+		linphone::Call::Status::Declined,
+		linphone::Call::Status::Aborted
+	};
+	
+	shared_ptr<linphone::Factory> factory = linphone::Factory::get();
+	QVector<shared_ptr<linphone::Address> > peers;
+	for (int i = 0; i < peerCount; ++i)
+		peers << factory->createAddress(QStringLiteral("sip:peer%1@example.org").arg(i).toStdString());
+	const shared_ptr<linphone::Address> localAddresses[] = {
+		factory->createAddress("sip:me@example.org"),
+		factory->createAddress("sip:me@example.net")
+	};
+	
+	for (int i = 0; i < count; ++i) {
+		const linphone::Call::Status status = Statuses[i % 4];
+		const shared_ptr<linphone::Address> &peer = peers[i % peerCount];
+		const shared_ptr<linphone::Address> &localAddress = localAddresses[i / peerCount % 2];
+		const bool isOutgoing = i % 3 == 0;
+		const time_t startDate = 1600000000 + time_t(i) * 60;
+		core->createCallLog(
+			isOutgoing ? localAddress : peer,
+			isOutgoing ? peer : localAddress,
+			isOutgoing ? linphone::Call::Dir::Outgoing : linphone::Call::Dir::Incoming,
+			status == linphone::Call::Status::Success ? 10 + i % 50 : 0,
+			startDate,
+			startDate,
+			status,
+			false,
+			0.0f
+		);
+	}
+}
+
+void HistoryTest::compareStats(const HistoryStatsModel &model, const HistoryStatsModel &expected)
+{
+	QCOMPARE(model.rowCount(), expected.rowCount());
+	for (int row = 0; row < expected.rowCount(); ++row) {
+		const QModelIndex index = expected.index(row);
+		const QString peerAddress = expected.data(index, HistoryStatsModel::PeerAddressRole).toString();
+		const QString localAddress = expected.data(index, HistoryStatsModel::LocalAddressRole).toString();
+		QCOMPARE(model.getPeerStats(peerAddress, localAddress), expected.getPeerStats(peerAddress, localAddress));
+		QCOMPARE(model.getPeerStats(peerAddress), expected.getPeerStats(peerAddress));
+	}
+}
+
+void HistoryTest::test_model_build()
+{
+	shared_ptr<linphone::Core> core = createCore();
+	QVERIFY(core);
+	createCallLogs(core, 1000, 10);
+	
+	// One entry per call log, and one more for the end of each successful call.
+	const HistoryModel model(core);
+	QCOMPARE(model.rowCount(), 1000 + 1000 / 4);
+	for (int row = 1; row < model.rowCount(); ++row) {
+		const QVariant previous = model.data(model.index(row - 1), HistoryModel::HistoryEntry).toMap()["timestamp"];
+		const QVariant timestamp = model.data(model.index(row), HistoryModel::HistoryEntry).toMap()["timestamp"];
+		QVERIFY(previous.toDateTime() <= timestamp.toDateTime());
+	}
+}
+
+// 200k call logs built in one pass, instead of one sorted insertion per entry.
+void HistoryTest::bench_model_build()
+{
+	const int count = 200000;
+	shared_ptr<linphone::Core> core = createCore();
+	QVERIFY(core);
+	createCallLogs(core, count, 1000);
+	
+	QBENCHMARK {
+		const HistoryModel model(core);
+		QCOMPARE(model.rowCount(), count + count / 4);
+	}
+}
+
+void HistoryTest::test_stats_remove()
+{
+	QTemporaryDir dir;
+	QVERIFY(dir.isValid());
+	shared_ptr<linphone::Core> core = createCore(dir.filePath("call-history.db"));
+	QVERIFY(core);
+	createCallLogs(core, 200, 5);
+	const list<shared_ptr<linphone::CallLog> > callLogs = core->getCallLogs();
+	QCOMPARE(int(callLogs.size()), 200);
+	
+	HistoryStatsModel model(core);
+	QCOMPARE(model.rowCount(), 10);
+	QSignalSpy resetSpy(&model, &QAbstractItemModel::modelReset);
+	
+	// The first call logs of the list, and all the call logs of one peer on one local address to
+	// remove its row. The last seen dates of the rows of this peer are computed again.
+	int index = 0;
+	for (const auto &callLog : callLogs) {
+		const bool isRemoved = index < 20 || (index % 5 == 0 && index / 5 % 2 == 1);
+		if (isRemoved) {
+			core->removeCallLog(callLog);
+			model.removeCallLog(callLog);
+		}
+		++index;
+	}
+	QCOMPARE(resetSpy.count(), 0);
+	
+	const HistoryStatsModel expected(core);
+	QCOMPARE(model.rowCount(), 9);
+	compareStats(model, expected);
+}
+
+// Remove call logs one by one from 500k call logs, as `HistoryModel` does when the user removes
+// history entries. The stats are not computed again.
+void HistoryTest::bench_stats_remove()
+{
+	const int count = 500000;
+	shared_ptr<linphone::Core> core = createCore();
+	QVERIFY(core);
+	createCallLogs(core, count, 1000);
+	const list<shared_ptr<linphone::CallLog> > callLogs = core->getCallLogs();
+	QCOMPARE(int(callLogs.size()), count);
+	
+	HistoryStatsModel model(core);
+	auto it = callLogs.cbegin();
+	QBENCHMARK {
+		if (it != callLogs.cend())
+			model.removeCallLog(*it++);
+	}
+}
+
+// What each removal cost before: all stats computed again from 500k call logs.
+void HistoryTest::bench_stats_rebuild()
+{
+	const int count = 500000;
+	shared_ptr<linphone::Core> core = createCore();
+	QVERIFY(core);
+	createCallLogs(core, count, 1000);
+	
+	HistoryStatsModel model(core);
+	QBENCHMARK {
+		model.rebuild();
+	}
+	QCOMPARE(model.rowCount(), 2000);
+}
+
+QTEST_GUILESS_MAIN(HistoryTest)
+
+#include "tst_historytest.moc"
@@ -0,0 +1,207 @@
+﻿#include <QtTest>
+
+#include <linphone++/linphone.hh>
+
+#include "components/core/KeyedEvents.hpp"
+
+// Deliver the events of 500 chat models and 20 calls, through the broadcast signals of
+// CoreHandlers and through the keyed events. A broadcast event calls every receiver, which
+// compares the chat room or the call with its own one. A keyed event costs a hash lookup and
+// calls only the receivers of its key.
+
+using namespace std;
+
+// The broadcast signals of CoreHandlers.
+class Broadcaster : public QObject
+{
+	Q_OBJECT
+	
+signals:
+	void isComposingChanged(const shared_ptr<linphone::ChatRoom> &chatRoom);
+	void callStateChanged(const shared_ptr<linphone::Call> &call, linphone::Call::State state);
+};
+
+// A chat model or a call model.
+class Receiver : public QObject
+{
+public:
+	Receiver(const void *key) : mKey(key) {}
+	
+	void handleIsComposingChanged(const shared_ptr<linphone::ChatRoom> &chatRoom)
+	{
+		if (chatRoom.get() == mKey)
+			++mEventCount;
+	}
+	
+	void handleCallStateChanged(const shared_ptr<linphone::Call> &call, linphone::Call::State)
+	{
+		if (call.get() == mKey)
+			++mEventCount;
+	}
+	
+	const void *mKey;
+	int mEventCount = 0;
+};
+
+class KeyedEventsTest : public QObject
+{
+	Q_OBJECT
+	
+private slots:
+	void test_keyed();
+	void bench_chat_rooms_data();
+	void bench_chat_rooms();
+	void bench_calls_data();
+	void bench_calls();
+	
+private:
+	static constexpr int ChatRoomCount = 500;
+	static constexpr int CallCount = 20;
+	
+	// The keys are never dereferenced: like CoreHandlers, only their addresses are used. The
+	// shared pointers do not own anything.
+	template<typename Key>
+	static QVector<shared_ptr<Key> > createKeys(QVector<char> &storage, int count);
+	
+	// Like `CoreHandlers::getEvents`, one events object per key.
+	template<typename Events, typename Key>
+	static Events *getEvents(QHash<const Key *, Events *> &events, const shared_ptr<Key> &key, QObject *parent);
+};
+
+constexpr int KeyedEventsTest::ChatRoomCount;
+constexpr int KeyedEventsTest::CallCount;
+
+template<typename Key>
+QVector<shared_ptr<Key> > KeyedEventsTest::createKeys(QVector<char> &storage, int count)
+{
+	storage.resize(count);
+	QVector<shared_ptr<Key> > keys;
+	for (int i = 0; i < count; ++i)
+		keys << shared_ptr<Key>(shared_ptr<void>(), reinterpret_cast<Key *>(&storage[i]));
+	return keys;
+}
+
+template<typename Events, typename Key>
+Events *KeyedEventsTest::getEvents(QHash<const Key *, Events *> &events, const shared_ptr<Key> &key, QObject *parent)
+{
+	Events *keyEvents = events.value(key.get());
+	if (!keyEvents) {
+		keyEvents = new Events(key, parent);
+		events.insert(key.get(), keyEvents);
+	}
+	return keyEvents;
+}
+
+void KeyedEventsTest::test_keyed()
+{
+	QVector<char> storage;
+	const QVector<shared_ptr<linphone::ChatRoom> > chatRooms = createKeys<linphone::ChatRoom>(storage, ChatRoomCount);
+	QObject parent;
+	QHash<const linphone::ChatRoom *, ChatRoomEvents *> events;
+	QVector<Receiver *> receivers;
+	for (const auto &chatRoom : chatRooms) {
+		Receiver *receiver = new Receiver(chatRoom.get());
+		receiver->setParent(&parent);
+		QObject::connect(getEvents(events, chatRoom, &parent), &ChatRoomEvents::isComposingChanged, receiver, &Receiver::handleIsComposingChanged);
+		receivers << receiver;
+	}
+	QCOMPARE(events.size(), ChatRoomCount);
+	
+	// Two receivers of the same chat room share its events.
+	Receiver *second = new Receiver(chatRooms[0].get());
+	second->setParent(&parent);
+	ChatRoomEvents *firstEvents = getEvents(events, chatRooms[0], &parent);
+	QObject::connect(firstEvents, &ChatRoomEvents::isComposingChanged, second, &Receiver::handleIsComposingChanged);
+	QCOMPARE(events.size(), ChatRoomCount);
+	QCOMPARE(firstEvents->getChatRoom(), chatRooms[0]);
+	
+	emit events.value(chatRooms[0].get())->isComposingChanged(chatRooms[0]);
+	QCOMPARE(receivers[0]->mEventCount, 1);
+	QCOMPARE(second->mEventCount, 1);
+	for (int i = 1; i < ChatRoomCount; ++i)
+		QCOMPARE(receivers[i]->mEventCount, 0);
+}
+
+void KeyedEventsTest::bench_chat_rooms_data()
+{
+	QTest::addColumn<bool>("keyed");
+	
+	QTest::addRow("broadcast") << false;
+	QTest::addRow("keyed") << true;
+}
+
+// One is-composing event per chat room.
+void KeyedEventsTest::bench_chat_rooms()
+{
+	QFETCH(bool, keyed);
+	
+	QVector<char> storage;
+	const QVector<shared_ptr<linphone::ChatRoom> > chatRooms = createKeys<linphone::ChatRoom>(storage, ChatRoomCount);
+	QObject parent;
+	Broadcaster broadcaster;
+	QHash<const linphone::ChatRoom *, ChatRoomEvents *> events;
+	for (const auto &chatRoom : chatRooms) {
+		Receiver *receiver = new Receiver(chatRoom.get());
+		receiver->setParent(&parent);
+		if (keyed)
+			QObject::connect(getEvents(events, chatRoom, &parent), &ChatRoomEvents::isComposingChanged, receiver, &Receiver::handleIsComposingChanged);
+		else
+			QObject::connect(&broadcaster, &Broadcaster::isComposingChanged, receiver, &Receiver::handleIsComposingChanged);
+	}
+	
+	QBENCHMARK {
+		for (const auto &chatRoom : chatRooms) {
+			emit broadcaster.isComposingChanged(chatRoom);
+			if (ChatRoomEvents *chatRoomEvents = events.value(chatRoom.get()))
+				emit chatRoomEvents->isComposingChanged(chatRoom);
+		}
+	}
+}
+
+void KeyedEventsTest::bench_calls_data()
+{
+	QTest::addColumn<bool>("keyed");
+	
+	QTest::addRow("broadcast") << false;
+	QTest::addRow("keyed") << true;
+}
+
+// One state change per call, received by its call model and by the chat models, which are
+// only interested in the end of a call.
+void KeyedEventsTest::bench_calls()
+{
+	QFETCH(bool, keyed);
+	
+	QVector<char> storage;
+	const QVector<shared_ptr<linphone::Call> > calls = createKeys<linphone::Call>(storage, CallCount);
+	QObject parent;
+	Broadcaster broadcaster;
+	QHash<const linphone::Call *, CallEvents *> events;
+	for (const auto &call : calls) {
+		Receiver *receiver = new Receiver(call.get());
+		receiver->setParent(&parent);
+		if (keyed)
+			QObject::connect(getEvents(events, call, &parent), &CallEvents::callStateChanged, receiver, &Receiver::handleCallStateChanged);
+		else
+			QObject::connect(&broadcaster, &Broadcaster::callStateChanged, receiver, &Receiver::handleCallStateChanged);
+	}
+	if (!keyed) {
+		for (int i = 0; i < ChatRoomCount; ++i) {
+			Receiver *receiver = new Receiver(nullptr);
+			receiver->setParent(&parent);
+			QObject::connect(&broadcaster, &Broadcaster::callStateChanged, receiver, &Receiver::handleCallStateChanged);
+		}
+	}
+	
+	QBENCHMARK {
+		for (const auto &call : calls) {
+			emit broadcaster.callStateChanged(call, linphone::Call::State::StreamsRunning);
+			if (CallEvents *callEvents = events.value(call.get()))
+				emit callEvents->callStateChanged(call, linphone::Call::State::StreamsRunning);
+		}
+	}
+}
+
+QTEST_GUILESS_MAIN(KeyedEventsTest)
+
+#include "tst_keyedeventstest.moc"
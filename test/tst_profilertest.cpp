@@ -0,0 +1,109 @@
+﻿#include <functional>
+
+#include <QtTest>
+#include <QElapsedTimer>
+
+#include "components/core/CoreHandlersProfiler.hpp"
+
+// Check the histograms of the core handlers profiler and measure what it adds to each core
+// callback, disabled and enabled.
+
+using namespace std;
+
+typedef CoreHandlersProfiler::Histogram Histogram;
+
+class ProfilerTest : public QObject
+{
+	Q_OBJECT
+	
+private slots:
+	void test_buckets();
+	void test_percentile();
+	void bench_dispatch_data();
+	void bench_dispatch();
+};
+
+void ProfilerTest::test_buckets()
+{
+	// One bucket per microsecond below `SubBucketCount`.
+	for (int us = 0; us < Histogram::SubBucketCount; ++us) {
+		QCOMPARE(Histogram::getBucket(quint64(us)), us);
+		QCOMPARE(Histogram::getBucketValue(us), quint64(us));
+	}
+	
+	// The buckets follow each other, and each one starts at its value.
+	for (int bucket = 0; bucket < Histogram::BucketCount - 1; ++bucket) {
+		QCOMPARE(Histogram::getBucket(Histogram::getBucketValue(bucket)), bucket);
+		QVERIFY(Histogram::getBucketValue(bucket) < Histogram::getBucketValue(bucket + 1));
+	}
+	QCOMPARE(Histogram::getBucket(~quint64(0)), Histogram::BucketCount - 1);
+	
+	// A value is known within 12.5%.
+	for (quint64 us : { quint64(17), quint64(100), quint64(1000), quint64(123456), quint64(1) << 40 }) {
+		const int bucket = Histogram::getBucket(us);
+		QVERIFY(Histogram::getBucketValue(bucket) <= us);
+		QVERIFY(us < Histogram::getBucketValue(bucket + 1));
+		QVERIFY(Histogram::getBucketValue(bucket + 1) - Histogram::getBucketValue(bucket) <= Histogram::getBucketValue(bucket) / 8);
+	}
+}
+
+void ProfilerTest::test_percentile()
+{
+	Histogram histogram;
+	QCOMPARE(histogram.getPercentile(50), qint64(0));
+	
+	// 1 ms to 100 ms, in nanoseconds.
+	for (qint64 ms = 1; ms <= 100; ++ms)
+		histogram.record(ms * 1000000);
+	QCOMPARE(histogram.getCount(), quint64(100));
+	QCOMPARE(histogram.getMax(), qint64(100000000));
+	QCOMPARE(histogram.getMean(), qint64(50500000));
+	
+	// The lowest value of the bucket of the percentile, never above the max.
+	const qint64 p50 = histogram.getPercentile(50);
+	QVERIFY(p50 <= 50000000);
+	QVERIFY(p50 > 50000000 - 50000000 / 8);
+	const qint64 p99 = histogram.getPercentile(99);
+	QVERIFY(p99 <= 99000000);
+	QVERIFY(p99 > 99000000 - 99000000 / 8);
+	QCOMPARE(histogram.getPercentile(100), qint64(Histogram::getBucketValue(Histogram::getBucket(100000))) * 1000);
+	QCOMPARE(histogram.getPercentile(1000), histogram.getMax());
+}
+
+void ProfilerTest::bench_dispatch_data()
+{
+	QTest::addColumn<int>("mode");
+	
+	QTest::addRow("without profiler") << 0;
+	QTest::addRow("disabled") << 1;
+	QTest::addRow("enabled") << 2;
+}
+
+// Same steps as `CoreHandlers::dispatch` around an empty handler.
+void ProfilerTest::bench_dispatch()
+{
+	QFETCH(int, mode);
+	
+	CoreHandlersProfiler profiler;
+	profiler.setEnabled(mode == 2);
+	int callCount = 0;
+	const function<void()> handler = [&callCount]() {
+		++callCount;
+	};
+	
+	QBENCHMARK {
+		if (mode == 0 || !profiler.isEnabled()) {
+			handler();
+		} else {
+			QElapsedTimer timer;
+			timer.start();
+			handler();
+			profiler.record("onCallStateChanged", timer.nsecsElapsed());
+		}
+	}
+	QVERIFY(callCount > 0);
+}
+
+QTEST_GUILESS_MAIN(ProfilerTest)
+
+#include "tst_profilertest.moc"
@@ -0,0 +1,139 @@
+﻿#include <QtTest>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <QThread>
+
+#include "app/tracer/Tracer.hpp"
+
+// Validate the Chrome trace event format produced by the startup tracer.
+
+class SpanThread : public QThread
+{
+protected:
+	void run() override
+	{
+		TRACE_SPAN("thread");
+	}
+};
+
+class TracerTest : public QObject
+{
+	Q_OBJECT
+	
+private slots:
+	void test_disabled();
+	void test_events();
+	void test_save();
+	
+private:
+	static QJsonArray parseEvents(const QByteArray &json);
+	static QJsonObject findEvent(const QJsonArray &events, const QString &name);
+};
+
+QJsonArray TracerTest::parseEvents(const QByteArray &json)
+{
+	QJsonParseError error;
+	const QJsonDocument document = QJsonDocument::fromJson(json, &error);
+	if (error.error != QJsonParseError::NoError || !document.isObject())
+		return QJsonArray();
+	return document.object().value("traceEvents").toArray();
+}
+
+QJsonObject TracerTest::findEvent(const QJsonArray &events, const QString &name)
+{
+	for (const auto &event : events)
+		if (event.toObject().value("name").toString() == name)
+			return event.toObject();
+	return QJsonObject();
+}
+
+void TracerTest::test_disabled()
+{
+	Tracer::start();
+	Tracer::stop();
+	{
+		TRACE_SPAN("disabled");
+		Tracer::addCounter("counter", 1);
+		Tracer::addInstant("instant");
+	}
+	QVERIFY(!Tracer::isEnabled());
+	QCOMPARE(parseEvents(Tracer::toJson()).size(), 0);
+}
+
+void TracerTest::test_events()
+{
+	Tracer::start();
+	{
+		TRACE_SPAN("parent");
+		{
+			TRACE_SPAN("child");
+			QThread::msleep(2);
+		}
+		Tracer::addCounter("counter", 42);
+		Tracer::addInstant("instant");
+	}
+	SpanThread thread;
+	thread.start();
+	thread.wait();
+	Tracer::stop();
+	
+	const QJsonArray events = parseEvents(Tracer::toJson());
+	QCOMPARE(events.size(), 5);
+	for (const auto &value : events) {
+		const QJsonObject event = value.toObject();
+		QVERIFY(event.contains("name"));
+		QVERIFY(event.contains("ph"));
+		QVERIFY(event.value("ts").toDouble() >= 0);
+		QVERIFY(event.contains("pid"));
+		QVERIFY(event.contains("tid"));
+	}
+	
+	// Spans are complete events, the child is nested in its parent.
+	const QJsonObject parent = findEvent(events, "parent");
+	const QJsonObject child = findEvent(events, "child");
+	QCOMPARE(parent.value("ph").toString(), QString("X"));
+	QCOMPARE(child.value("ph").toString(), QString("X"));
+	QVERIFY(child.value("dur").toDouble() >= 2000);
+	QVERIFY(child.value("ts").toDouble() >= parent.value("ts").toDouble());
+	QVERIFY(
+		child.value("ts").toDouble() + child.value("dur").toDouble() <=
+		parent.value("ts").toDouble() + parent.value("dur").toDouble()
+	);
+	QCOMPARE(child.value("tid"), parent.value("tid"));
+	
+	const QJsonObject counter = findEvent(events, "counter");
+	QCOMPARE(counter.value("ph").toString(), QString("C"));
+	QCOMPARE(counter.value("args").toObject().value("value").toInt(), 42);
+	
+	QCOMPARE(findEvent(events, "instant").value("ph").toString(), QString("i"));
+	QVERIFY(findEvent(events, "thread").value("tid") != parent.value("tid"));
+}
+
+void TracerTest::test_save()
+{
+	QTemporaryDir dir;
+	QVERIFY(dir.isValid());
+	const QString filePath = dir.filePath("trace.json");
+	
+	Tracer::start();
+	{
+		TRACE_SPAN("saved");
+		TRACE_SPAN("same scope");
+	}
+	Tracer::stop();
+	QVERIFY(Tracer::save(filePath));
+	QVERIFY(!Tracer::save(dir.filePath("missing/trace.json")));
+	
+	QFile file(filePath);
+	QVERIFY(file.open(QIODevice::ReadOnly));
+	const QJsonArray events = parseEvents(file.readAll());
+	QCOMPARE(events.size(), 2);
+	QCOMPARE(events[0].toObject().value("name").toString(), QString("same scope"));// Ends first.
+	QCOMPARE(events[1].toObject().value("name").toString(), QString("saved"));
+}
+
+QTEST_GUILESS_MAIN(TracerTest)
+
+#include "tst_tracertest.moc"
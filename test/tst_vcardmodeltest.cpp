@@ -0,0 +1,96 @@
+﻿#include <QtTest>
+
+#include <linphone++/linphone.hh>
+
+#include "components/contact/VcardModel.hpp"
+
+// Check that the sip addresses cached by VcardModel follow the vcard, and measure a read with
+// and without the cache.
+
+using namespace std;
+
+class VcardModelTest : public QObject
+{
+	Q_OBJECT
+	
+private slots:
+	void test_mutators();
+	void test_reload();
+	void bench_sip_addresses_data();
+	void bench_sip_addresses();
+	
+private:
+	static QStringList toStringList(const QVariantList &list);
+};
+
+QStringList VcardModelTest::toStringList(const QVariantList &list)
+{
+	QStringList strings;
+	for (const auto &value : list)
+		strings << value.toString();
+	return strings;
+}
+
+void VcardModelTest::test_mutators()
+{
+	VcardModel model(linphone::Factory::get()->createVcard(), false);
+	QVERIFY(model.getSipAddresses().isEmpty());
+	
+	QVERIFY(model.addSipAddress("sip:alice@example.org"));
+	QVERIFY(model.addSipAddress("sip:bob@example.org"));
+	QCOMPARE(toStringList(model.getSipAddresses()), QStringList() << "sip:alice@example.org" << "sip:bob@example.org");
+	
+	// A second read is served by the cache and is identical.
+	QCOMPARE(toStringList(model.getSipAddresses()), QStringList() << "sip:alice@example.org" << "sip:bob@example.org");
+	
+	model.removeSipAddress("sip:alice@example.org");
+	QCOMPARE(toStringList(model.getSipAddresses()), QStringList() << "sip:bob@example.org");
+}
+
+void VcardModelTest::test_reload()
+{
+	shared_ptr<linphone::Vcard> vcard = linphone::Factory::get()->createVcard();
+	VcardModel model(vcard, false);
+	QVERIFY(model.addSipAddress("sip:alice@example.org"));
+	QCOMPARE(toStringList(model.getSipAddresses()), QStringList() << "sip:alice@example.org");
+	
+	// Modified behind the model: the cache is stale until reloaded.
+	vcard->addSipAddress("sip:carol@example.org");
+	QCOMPARE(toStringList(model.getSipAddresses()), QStringList() << "sip:alice@example.org");
+	
+	QSignalSpy spy(&model, &VcardModel::vcardUpdated);
+	model.reload();
+	QCOMPARE(spy.count(), 1);
+	QCOMPARE(toStringList(model.getSipAddresses()), QStringList() << "sip:alice@example.org" << "sip:carol@example.org");
+}
+
+void VcardModelTest::bench_sip_addresses_data()
+{
+	QTest::addColumn<bool>("cached");
+	
+	QTest::addRow("cached") << true;
+	QTest::addRow("parsed") << false;
+}
+
+// Read like the bindings of a contact delegate, which get `sipAddresses` on each refresh.
+void VcardModelTest::bench_sip_addresses()
+{
+	QFETCH(bool, cached);
+	
+	VcardModel model(linphone::Factory::get()->createVcard(), false);
+	QVERIFY(model.addSipAddress("sip:alice@example.org"));
+	QVERIFY(model.addSipAddress("sip:alice@example.net"));
+	QVERIFY(model.addSipAddress("sip:alice.work@example.com"));
+	
+	QVariantList sipAddresses;
+	QBENCHMARK {
+		if (!cached)
+			model.reload();// Parse the vcard again, as before the cache.
+		sipAddresses = model.getSipAddresses();
+	}
+	QCOMPARE(sipAddresses.size(), 3);
+}
+
+QTEST_GUILESS_MAIN(VcardModelTest)
+
+#include "tst_vcardmodeltest.moc"
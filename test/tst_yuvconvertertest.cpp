@@ -0,0 +1,186 @@
+﻿#include <QtTest>
+#include <QVector>
+
+#include "components/camera/YuvConverter.hpp"
+
+// Compare the SIMD kernels of the software video renderer with the scalar one,
+// and measure them on 720p and 1080p frames, and on a 1080p stream shown in
+// thumbnail, normal and fullscreen tiles.
+
+Q_DECLARE_METATYPE(YuvConverter::Kernel)
+
+class Frame
+{
+public:
+	Frame(int width, int height, quint32 seed)
+	{
+		const int chromaWidth = (width + 1) / 2;
+		const int chromaHeight = (height + 1) / 2;
+		mY.resize(width * height);
+		mU.resize(chromaWidth * chromaHeight);
+		mV.resize(chromaWidth * chromaHeight);
+		
+		// Linear congruential generator: same frames everywhere.
+		for (QVector<uint8_t> *plane : { &mY, &mU, &mV })
+			for (uint8_t &sample : *plane) {
+				seed = seed * 1664525u + 1013904223u;
+				sample = uint8_t(seed >> 24);
+			}
+		
+		// Saturate the channels on the first pixels.
+		if (width >= 2) {
+			mY[0] = 0;
+			mY[1] = 255;
+			mU[0] = 255;
+			mV[0] = 0;
+		}
+		
+		mPicture = { width, height, { mY.constData(), mU.constData(), mV.constData() }, { width, chromaWidth, chromaWidth } };
+	}
+	
+	const YuvPicture &getPicture() const
+	{
+		return mPicture;
+	}
+	
+private:
+	QVector<uint8_t> mY, mU, mV;
+	YuvPicture mPicture;
+};
+
+class YuvConverterTest : public QObject
+{
+	Q_OBJECT
+	
+private slots:
+	void test_colors();
+	void test_kernels_data();
+	void test_kernels();
+	void benchmark_data();
+	void benchmark();
+	void benchmark_tiles_data();
+	void benchmark_tiles();
+	
+private:
+	static quint32 convertPixel(int y, int u, int v);
+};
+
+quint32 YuvConverterTest::convertPixel(int y, int u, int v)
+{
+	const uint8_t yy = uint8_t(y), uu = uint8_t(u), vv = uint8_t(v);
+	const YuvPicture picture = { 1, 1, { &yy, &uu, &vv }, { 1, 1, 1 } };
+	quint32 pixel = 0;
+	YuvConverter::convert(picture, reinterpret_cast<uint8_t *>(&pixel), 4, 1, 1, YuvConverter::ScalarKernel);
+	return pixel;
+}
+
+void YuvConverterTest::test_colors()
+{
+	QCOMPARE(convertPixel(16, 128, 128), 0xff000000u);
+	QCOMPARE(convertPixel(235, 128, 128), 0xffffffffu);
+	
+	// BT.601 red, green and blue, within the error of the fixed point.
+	const auto check = [](quint32 pixel, int r, int g, int b) {
+		return qAbs(int((pixel >> 16) & 0xff) - r) <= 3 && qAbs(int((pixel >> 8) & 0xff) - g) <= 3 && qAbs(int(pixel & 0xff) - b) <= 3;
+	};
+	QVERIFY(check(convertPixel(81, 90, 240), 255, 0, 0));
+	QVERIFY(check(convertPixel(145, 54, 34), 0, 255, 0));
+	QVERIFY(check(convertPixel(41, 240, 110), 0, 0, 255));
+}
+
+void YuvConverterTest::test_kernels_data()
+{
+	QTest::addColumn<YuvConverter::Kernel>("kernel");
+	QTest::addColumn<QSize>("source");
+	QTest::addColumn<QSize>("destination");
+	
+	const QVector<QPair<QSize, QSize>> sizes = {
+		{ QSize(1, 1), QSize(1, 1) },
+		{ QSize(15, 7), QSize(15, 7) },
+		{ QSize(33, 9), QSize(33, 9) },
+		{ QSize(1280, 720), QSize(1280, 720) },
+		{ QSize(1920, 1080), QSize(160, 90) },
+		{ QSize(640, 480), QSize(1280, 960) },
+		{ QSize(100, 100), QSize(37, 41) }
+	};
+	for (int kernel = YuvConverter::Sse2Kernel; kernel < YuvConverter::KernelCount; ++kernel) {
+		if (!YuvConverter::isSupported(YuvConverter::Kernel(kernel)))
+			continue;
+		for (const auto &size : sizes)
+			QTest::addRow("%s %dx%d to %dx%d", YuvConverter::getKernelName(YuvConverter::Kernel(kernel)),
+				size.first.width(), size.first.height(), size.second.width(), size.second.height())
+				<< YuvConverter::Kernel(kernel) << size.first << size.second;
+	}
+}
+
+void YuvConverterTest::test_kernels()
+{
+	QFETCH(YuvConverter::Kernel, kernel);
+	QFETCH(QSize, source);
+	QFETCH(QSize, destination);
+	
+	const Frame frame(source.width(), source.height(), quint32(source.width() * 31 + source.height()));
+	const int stride = destination.width() * 4;
+	QVector<quint32> expected(destination.width() * destination.height());
+	QVector<quint32> result(expected.size());
+	
+	YuvConverter::convert(frame.getPicture(), reinterpret_cast<uint8_t *>(expected.data()), stride, destination.width(), destination.height(), YuvConverter::ScalarKernel);
+	YuvConverter::convert(frame.getPicture(), reinterpret_cast<uint8_t *>(result.data()), stride, destination.width(), destination.height(), kernel);
+	QCOMPARE(result, expected);
+}
+
+void YuvConverterTest::benchmark_data()
+{
+	QTest::addColumn<YuvConverter::Kernel>("kernel");
+	QTest::addColumn<QSize>("size");
+	
+	for (int kernel = YuvConverter::ScalarKernel; kernel < YuvConverter::KernelCount; ++kernel) {
+		if (!YuvConverter::isSupported(YuvConverter::Kernel(kernel)))
+			continue;
+		const char *name = YuvConverter::getKernelName(YuvConverter::Kernel(kernel));
+		QTest::addRow("%s 720p", name) << YuvConverter::Kernel(kernel) << QSize(1280, 720);
+		QTest::addRow("%s 1080p", name) << YuvConverter::Kernel(kernel) << QSize(1920, 1080);
+	}
+}
+
+void YuvConverterTest::benchmark()
+{
+	QFETCH(YuvConverter::Kernel, kernel);
+	QFETCH(QSize, size);
+	
+	const Frame frame(size.width(), size.height(), 1);
+	QVector<quint32> result(size.width() * size.height());
+	QBENCHMARK {
+		YuvConverter::convert(frame.getPicture(), reinterpret_cast<uint8_t *>(result.data()), size.width() * 4, size.width(), size.height(), kernel);
+	}
+}
+
+void YuvConverterTest::benchmark_tiles_data()
+{
+	QTest::addColumn<QSize>("size");
+	
+	// Item pixel sizes, as computed by the software camera.
+	QTest::newRow("thumbnail") << QSize(160, 90);
+	QTest::newRow("thumbnail hidpi") << QSize(320, 180);
+	QTest::newRow("normal") << QSize(640, 360);
+	QTest::newRow("fullscreen") << QSize(1920, 1080);
+}
+
+void YuvConverterTest::benchmark_tiles()
+{
+	QFETCH(QSize, size);
+	
+	const Frame frame(1920, 1080, 1);
+	QVector<quint32> result(size.width() * size.height());
+	const int stride = size.width() * 4;
+	
+	// The texture is uploaded once per converted frame.
+	qInfo("%dx%d: %d bytes uploaded per frame", size.width(), size.height(), stride * size.height());
+	QBENCHMARK {
+		YuvConverter::convert(frame.getPicture(), reinterpret_cast<uint8_t *>(result.data()), stride, size.width(), size.height());
+	}
+}
+
+QTEST_GUILESS_MAIN(YuvConverterTest)
+
+#include "tst_yuvconvertertest.moc"
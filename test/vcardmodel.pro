@@ -0,0 +1,32 @@
+QT += testlib quick widgets
+DESTDIR = ../Debug
+
+
+CONFIG += qt console warn_on depend_includepath testcase c++11
+CONFIG -= app_bundle
+
+TEMPLATE = app
+
+SOURCES +=  tst_vcardmodeltest.cpp \
+            vcardmodelstubs.cpp \
+            ../desktop-demo/src/components/contact/VcardModel.cpp
+
+HEADERS +=  ../desktop-demo/src/components/contact/VcardModel.hpp
+
+INCLUDEPATH +=  $$PWD/../desktop-demo/src \
+                $$PWD/../sdk/linphone-sdk/desktop/include
+
+LIBS +=  -L$$PWD/../sdk/linphone-sdk/desktop/lib/ -lz \
+                                 -lxml2 \
+                                 -llinphone++ \
+                                 -llinphone \
+                                 -lbctoolbox \
+                                 -lbelcard \
+                                 -lortp \
+                                 -lmediastreamer \
+                                 -lbelr \
+                                 -lsqlite3 \
+                                 -lbellesip \
+                                 -lmbedcrypto \
+                                 -lmbedtls \
+                                 -lmbedx509
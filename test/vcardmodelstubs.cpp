@@ -0,0 +1,23 @@
+﻿#include <QDir>
+
+#include <linphone++/linphone.hh>
+
+#include "app/paths/Paths.hpp"
+#include "app/providers/AvatarProvider.hpp"
+#include "components/sip-addresses/SipAddressesModel.hpp"
+
+using namespace std;
+
+// Stand-ins for the application symbols used by VcardModel.
+const QString AvatarProvider::ProviderId = "avatar";
+
+string Paths::getAvatarsDirPath()
+{
+	return QDir::tempPath().toStdString() + "/";
+}
+
+QString SipAddressesModel::interpretSipAddress(const QString &sipAddress, bool)
+{
+	shared_ptr<linphone::Address> address = linphone::Factory::get()->createAddress(sipAddress.toStdString());
+	return address ? QString::fromStdString(address->asStringUriOnly()) : QString();
+}